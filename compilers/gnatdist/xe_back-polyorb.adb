@@ -1282,6 +1282,13 @@ package body XE_Back.PolyORB is
          Need_Tasking     => False);
       --  Registrer "dfs" storage support
 
+      Register_Storage
+        (Storage_Name     => "mmap",
+         Allow_Passive    => True,
+         Allow_Local_Term => True,
+         Need_Tasking     => False);
+      --  Registrer "mmap" storage support
+
    end Register_Storages;
 
    -----------------
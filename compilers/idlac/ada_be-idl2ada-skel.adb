@@ -26,6 +26,9 @@
 --                                                                          --
 ------------------------------------------------------------------------------
 
+with GNAT.Dynamic_Tables;
+with GNAT.Strings;          use GNAT.Strings;
+
 with Idl_Fe.Tree;           use Idl_Fe.Tree;
 with Idl_Fe.Tree.Synthetic; use Idl_Fe.Tree.Synthetic;
 
@@ -35,6 +38,8 @@ with Ada_Be.Idl2Ada.Helper;
 with Ada_Be.Idl2Ada.Value_Skel;
 with Ada_Be.Temporaries;    use Ada_Be.Temporaries;
 
+with Idlac_Utils;           use Idlac_Utils;
+
 with Ada_Be.Debug;
 pragma Elaborate_All (Ada_Be.Debug);
 
@@ -55,17 +60,20 @@ package body Ada_Be.Idl2Ada.Skel is
 
    procedure Gen_Non_Existent
      (CU          : in out Compilation_Unit;
-      Node        : Node_Id);
+      Node        : Node_Id;
+      Is_Delegate : Boolean);
    --  Generate server-side support for the Non_Existent operation
 
    procedure Gen_Get_Interface
      (CU          : in out Compilation_Unit;
-      Node        : Node_Id);
+      Node        : Node_Id;
+      Is_Delegate : Boolean);
    --  Generate server-side support for the Get_Interface operation
 
    procedure Gen_Get_Domain_Managers
      (CU          : in out Compilation_Unit;
-      Node        : Node_Id);
+      Node        : Node_Id;
+      Is_Delegate : Boolean);
    --  Generate server-side support for the Get_Domain_Managers operation
 
    procedure Gen_Body_Common_Start
@@ -77,12 +85,81 @@ package body Ada_Be.Idl2Ada.Skel is
    --  at the beginning of the package.
 
    procedure Gen_Invoke
-     (CU   : in out Compilation_Unit;
-      Node : Node_Id);
+     (CU          : in out Compilation_Unit;
+      Node        : Node_Id;
+      Is_Delegate : Boolean);
    --  Generate a static dispatcher fragment for operation Node.
 
    Decls_Div : Diversion;
 
+   --  Operation dispatching
+
+   --  The generated Invoke procedure dispatches requests with a case
+   --  statement on the index of the branch that handles the requested
+   --  operation. This index is obtained from the operation name by
+   --  function Dispatch_Index, which uses a minimal perfect hash function
+   --  computed at generation time, so that the cost of dispatching does
+   --  not depend on the number of operations of the interface.
+
+   --  The hash function is PolyORB.Utils.HFunctions.Mul.Hash_Mul, in two
+   --  levels (hash and displace): the name is first hashed with K = 1 into
+   --  one of a set of buckets, then hashed again into the table of names
+   --  using a multiplier K specific to its bucket. The multipliers are
+   --  chosen so that all names of the interface land in distinct slots.
+
+   type Dispatch_Entry is record
+      Name   : String_Access;
+      Branch : Natural;
+   end record;
+
+   package Dispatch_Tables is new GNAT.Dynamic_Tables
+     (Table_Component_Type => Dispatch_Entry,
+      Table_Index_Type     => Natural,
+      Table_Low_Bound      => 0,
+      Table_Initial        => 64,
+      Table_Increment      => 100);
+
+   type Dispatcher is record
+      Entries  : Dispatch_Tables.Instance;
+      Branches : Natural := 0;
+   end record;
+
+   Dispatchers : array (Boolean) of Dispatcher;
+   --  Operation names handled by the Invoke procedure being generated, and
+   --  number of dispatch branches generated so far, for the skeleton
+   --  (False) and delegate (True) packages, whose generation is
+   --  interleaved.
+
+   Hash_Prime : constant := 2_147_483_647;
+   --  Prime used for all computations of Hash_Mul
+
+   Max_Hash_Tries : constant := 100_000;
+   --  Number of multipliers tried for each bucket before giving up on
+   --  the perfect hash function (in which case Dispatch_Index falls back
+   --  to a linear search).
+
+   function Hash_Mul (S : String; K : Natural; Size : Positive)
+     return Natural;
+   --  Same as PolyORB.Utils.HFunctions.Mul.Hash_Mul with Prime set to
+   --  Hash_Prime. This must return exactly the same values as the run-time
+   --  version, which is called by the generated code.
+
+   procedure Gen_Dispatch_Branch
+     (CU          : in out Compilation_Unit;
+      Is_Delegate : Boolean;
+      Name        : String;
+      Alias       : String := "");
+   --  Generate the start of the dispatcher branch in Invoke that handles
+   --  operation Name (and Alias, if not empty), and record the names for
+   --  Gen_Dispatch_Index.
+
+   procedure Gen_Dispatch_Index
+     (CU          : in out Compilation_Unit;
+      Is_Delegate : Boolean);
+   --  Generate function Dispatch_Index, which returns the index of the
+   --  dispatcher branch that handles a given operation name, or -1 if the
+   --  operation is unknown, and reset the recorded operation names.
+
    -------------------
    -- Gen_Node_Body --
    -------------------
@@ -104,7 +181,7 @@ package body Ada_Be.Idl2Ada.Skel is
                --  Predefined operations
 
                Gen_Is_A         (CU, Node, Is_Delegate);
-               Gen_Non_Existent (CU, Node);
+               Gen_Non_Existent (CU, Node, Is_Delegate);
 
                declare
                   It     : Node_Iterator;
@@ -136,14 +213,14 @@ package body Ada_Be.Idl2Ada.Skel is
                --  Predefined operations
 
                Gen_Is_A                (CU, Node, Is_Delegate);
-               Gen_Non_Existent        (CU, Node);
-               Gen_Get_Interface       (CU, Node);
-               Gen_Get_Domain_Managers (CU, Node);
+               Gen_Non_Existent        (CU, Node, Is_Delegate);
+               Gen_Get_Interface       (CU, Node, Is_Delegate);
+               Gen_Get_Domain_Managers (CU, Node, Is_Delegate);
 
             end if;
 
          when K_Operation =>
-            Gen_Invoke (CU, Node);
+            Gen_Invoke (CU, Node, Is_Delegate);
 
          when others =>
             null;
@@ -163,8 +240,7 @@ package body Ada_Be.Idl2Ada.Skel is
    begin
       pragma Assert ((NK = K_Interface) or else (NK = K_ValueType));
 
-      PL (CU, "if Operation = ""_is_a"" then");
-      II (CU);
+      Gen_Dispatch_Branch (CU, Is_Delegate, "_is_a");
 
       PL (CU, "declare");
       II (CU);
@@ -236,7 +312,8 @@ package body Ada_Be.Idl2Ada.Skel is
 
    procedure Gen_Non_Existent
      (CU          : in out Compilation_Unit;
-      Node        : Node_Id)
+      Node        : Node_Id;
+      Is_Delegate : Boolean)
    is
       NK : constant Node_Kind := Kind (Node);
    begin
@@ -251,10 +328,8 @@ package body Ada_Be.Idl2Ada.Skel is
       --  standards, the alternative name _not_existent is also supported.
 
       NL (CU);
-      PL (CU, "elsif Operation = ""_non_existent""");
-      PL (CU, "  or else Operation = ""_not_existent""");
-      PL (CU, "then");
-      II (CU);
+      Gen_Dispatch_Branch
+        (CU, Is_Delegate, "_non_existent", Alias => "_not_existent");
 
       NL (CU);
       PL (CU, "CORBA.ServerRequest.Arguments (Request, " & T_Arg_List & ");");
@@ -271,7 +346,8 @@ package body Ada_Be.Idl2Ada.Skel is
 
    procedure Gen_Get_Interface
      (CU          : in out Compilation_Unit;
-      Node        : Node_Id)
+      Node        : Node_Id;
+      Is_Delegate : Boolean)
    is
       NK : constant Node_Kind := Kind (Node);
    begin
@@ -281,8 +357,7 @@ package body Ada_Be.Idl2Ada.Skel is
       Add_With (CU, "PolyORB.CORBA_P.IR_Hooks");
 
       NL (CU);
-      PL (CU, "elsif Operation = ""_interface"" then");
-      II (CU);
+      Gen_Dispatch_Branch (CU, Is_Delegate, "_interface");
 
       NL (CU);
       PL (CU, "CORBA.ServerRequest.Arguments (Request, " & T_Arg_List & ");");
@@ -302,7 +377,8 @@ package body Ada_Be.Idl2Ada.Skel is
 
    procedure Gen_Get_Domain_Managers
      (CU          : in out Compilation_Unit;
-      Node        : Node_Id)
+      Node        : Node_Id;
+      Is_Delegate : Boolean)
    is
       NK : constant Node_Kind := Kind (Node);
    begin
@@ -311,8 +387,7 @@ package body Ada_Be.Idl2Ada.Skel is
       Add_With (CU, "PolyORB.CORBA_P.Domain_Management");
 
       NL (CU);
-      PL (CU, "elsif Operation = ""_domain_managers"" then");
-      II (CU);
+      Gen_Dispatch_Branch (CU, Is_Delegate, "_domain_managers");
 
       NL (CU);
       PL (CU, "CORBA.ServerRequest.Arguments (Request, " & T_Arg_List & ");");
@@ -324,6 +399,259 @@ package body Ada_Be.Idl2Ada.Skel is
       DI (CU);
    end Gen_Get_Domain_Managers;
 
+   --------------
+   -- Hash_Mul --
+   --------------
+
+   function Hash_Mul (S : String; K : Natural; Size : Positive)
+     return Natural
+   is
+      Lambda : constant := 65599;
+
+      Result : Long_Long_Integer := 0;
+   begin
+      for J in S'Range loop
+         Result := (Result * Lambda
+                    + Long_Long_Integer (Character'Pos (S (J)))
+                    * Long_Long_Integer (K))
+           mod Hash_Prime;
+      end loop;
+
+      return Natural (Result mod Long_Long_Integer (Size));
+   end Hash_Mul;
+
+   -------------------------
+   -- Gen_Dispatch_Branch --
+   -------------------------
+
+   procedure Gen_Dispatch_Branch
+     (CU          : in out Compilation_Unit;
+      Is_Delegate : Boolean;
+      Name        : String;
+      Alias       : String := "")
+   is
+      D : Dispatcher renames Dispatchers (Is_Delegate);
+   begin
+      Dispatch_Tables.Append
+        (D.Entries, (Name => new String'(Name), Branch => D.Branches));
+
+      PL (CU, "when " & Img (D.Branches) & " =>");
+      II (CU);
+
+      if Alias = "" then
+         PL (CU, "--  " & Name);
+      else
+         Dispatch_Tables.Append
+           (D.Entries, (Name => new String'(Alias), Branch => D.Branches));
+         PL (CU, "--  " & Name & ", " & Alias);
+      end if;
+
+      D.Branches := D.Branches + 1;
+   end Gen_Dispatch_Branch;
+
+   ------------------------
+   -- Gen_Dispatch_Index --
+   ------------------------
+
+   procedure Gen_Dispatch_Index
+     (CU          : in out Compilation_Unit;
+      Is_Delegate : Boolean)
+   is
+      D : Dispatcher renames Dispatchers (Is_Delegate);
+
+      N_Entries : constant Positive := Dispatch_Tables.Last (D.Entries) + 1;
+      N_Buckets : constant Positive := (N_Entries + 1) / 2;
+
+      Prime : constant String := Img (Natural'(Hash_Prime));
+
+      Bucket_Of : array (0 .. N_Entries - 1) of Natural;
+      Slot_Of   : array (0 .. N_Entries - 1) of Natural;
+      --  Bucket and slot of each entry
+
+      Entry_Of  : array (0 .. N_Entries - 1) of Integer := (others => -1);
+      --  Entry in each slot, -1 if the slot is free
+
+      Bucket_Size   : array (0 .. N_Buckets - 1) of Natural := (others => 0);
+      Displacements : array (0 .. N_Buckets - 1) of Natural := (others => 1);
+      Max_Size      : Natural := 0;
+
+      Found : Boolean := True;
+
+      function Name (E : Natural) return String;
+      --  Name of entry E
+
+      procedure Place_Bucket (B : Natural);
+      --  Find a multiplier for bucket B so that its entries land in free
+      --  slots. Set Found to False if none can be found.
+
+      ----------
+      -- Name --
+      ----------
+
+      function Name (E : Natural) return String is
+      begin
+         return D.Entries.Table (E).Name.all;
+      end Name;
+
+      ------------------
+      -- Place_Bucket --
+      ------------------
+
+      procedure Place_Bucket (B : Natural) is
+         K      : Natural := 1;
+         Placed : Boolean;
+      begin
+         for J in 1 .. Max_Hash_Tries loop
+
+            --  Multipliers are drawn from a Lehmer sequence rather than
+            --  taken in increasing order, so that they spread the hash
+            --  values of short names over the whole table.
+
+            K := Natural (Long_Long_Integer (K) * 16_807 mod Hash_Prime);
+            Placed := True;
+
+            for E in Bucket_Of'Range loop
+               if Bucket_Of (E) = B then
+                  Slot_Of (E) := Hash_Mul (Name (E), K, N_Entries);
+                  if Entry_Of (Slot_Of (E)) /= -1 then
+                     Placed := False;
+
+                     --  Release the slots taken by this attempt
+
+                     for F in Bucket_Of'First .. E - 1 loop
+                        if Bucket_Of (F) = B then
+                           Entry_Of (Slot_Of (F)) := -1;
+                        end if;
+                     end loop;
+                     exit;
+                  end if;
+                  Entry_Of (Slot_Of (E)) := E;
+               end if;
+            end loop;
+
+            if Placed then
+               Displacements (B) := K;
+               return;
+            end if;
+         end loop;
+
+         Found := False;
+      end Place_Bucket;
+
+   begin
+      --  Compute the perfect hash function, placing the largest buckets
+      --  first.
+
+      for E in Bucket_Of'Range loop
+         Bucket_Of (E) := Hash_Mul (Name (E), 1, N_Buckets);
+         Bucket_Size (Bucket_Of (E)) := Bucket_Size (Bucket_Of (E)) + 1;
+         Max_Size := Natural'Max (Max_Size, Bucket_Size (Bucket_Of (E)));
+      end loop;
+
+      Place_Buckets :
+      for Size in reverse 1 .. Max_Size loop
+         for B in Bucket_Size'Range loop
+            if Bucket_Size (B) = Size then
+               Place_Bucket (B);
+               exit Place_Buckets when not Found;
+            end if;
+         end loop;
+      end loop Place_Buckets;
+
+      NL (CU);
+      if Found then
+         PL (CU, "Dispatch_Displacements : constant array (Natural range 0 .. "
+             & Img (N_Buckets - 1) & ") of Natural :=");
+         for B in Displacements'Range loop
+            if B = Displacements'First then
+               Put (CU, "  (");
+            else
+               PL (CU, ",");
+               Put (CU, "   ");
+            end if;
+            Put (CU, Img (B) & " => " & Img (Displacements (B)));
+         end loop;
+         PL (CU, ");");
+         NL (CU);
+      end if;
+
+      PL (CU, "function Dispatch_Index");
+      PL (CU, "  (Operation : PolyORB.Std.String)");
+      PL (CU, "  return Integer;");
+      NL (CU);
+      PL (CU, "function Dispatch_Index");
+      PL (CU, "  (Operation : PolyORB.Std.String)");
+      PL (CU, "  return Integer");
+      PL (CU, "is");
+
+      if Found then
+         Add_With (CU, "PolyORB.Utils.HFunctions.Mul");
+         II (CU);
+         PL (CU, "use PolyORB.Utils.HFunctions.Mul;");
+         NL (CU);
+         PL (CU, "Bucket : constant Natural :=");
+         PL (CU, "  Hash_Mul (Operation, 1, " & Prime & ", "
+             & Img (N_Buckets) & ");");
+         DI (CU);
+         PL (CU, "begin");
+         II (CU);
+         PL (CU, "case Hash_Mul");
+         PL (CU, "  (Operation, Dispatch_Displacements (Bucket), "
+             & Prime & ", " & Img (N_Entries) & ")");
+         PL (CU, "is");
+         II (CU);
+
+         for Slot in Entry_Of'Range loop
+            PL (CU, "when " & Img (Slot) & " =>");
+            II (CU);
+            PL (CU, "if Operation = """ & Name (Entry_Of (Slot)) & """ then");
+            II (CU);
+            PL (CU, "return "
+                & Img (D.Entries.Table (Entry_Of (Slot)).Branch) & ";");
+            DI (CU);
+            PL (CU, "end if;");
+            DI (CU);
+         end loop;
+
+         PL (CU, "when others =>");
+         II (CU);
+         PL (CU, "null;");
+         DI (CU);
+         DI (CU);
+         PL (CU, "end case;");
+
+      else
+         --  No perfect hash function could be found (this can only happen
+         --  if the hash values of two names are equal for any multiplier):
+         --  fall back to a linear search.
+
+         PL (CU, "begin");
+         II (CU);
+
+         for E in Bucket_Of'Range loop
+            if E = Bucket_Of'First then
+               Put (CU, "if");
+            else
+               Put (CU, "elsif");
+            end if;
+            PL (CU, " Operation = """ & Name (E) & """ then");
+            II (CU);
+            PL (CU, "return " & Img (D.Entries.Table (E).Branch) & ";");
+            DI (CU);
+         end loop;
+         PL (CU, "end if;");
+      end if;
+
+      PL (CU, "return -1;");
+      DI (CU);
+      PL (CU, "end Dispatch_Index;");
+
+      for E in Bucket_Of'Range loop
+         Free (D.Entries.Table (E).Name);
+      end loop;
+      Dispatch_Tables.Free (D.Entries);
+   end Gen_Dispatch_Index;
+
    ----------------------------
    --  Gen_Body_Common_Start --
    ----------------------------
@@ -402,7 +730,12 @@ package body Ada_Be.Idl2Ada.Skel is
 
       Add_With (CU, "CORBA.ORB");
       PL (CU, "CORBA.ORB.Create_List (0, " & T_Arg_List & ");");
+      NL (CU);
+      PL (CU, "case Dispatch_Index (Operation) is");
+      II (CU);
 
+      Dispatch_Tables.Init (Dispatchers (Is_Delegate).Entries);
+      Dispatchers (Is_Delegate).Branches := 0;
    end Gen_Body_Common_Start;
 
    -------------------------
@@ -421,11 +754,12 @@ package body Ada_Be.Idl2Ada.Skel is
       pragma Assert ((NK = K_Interface) or else (NK = K_ValueType));
 
       NL (CU);
-      PL (CU, "else");
+      PL (CU, "when others =>");
       II (CU);
       PL (CU, "CORBA.Raise_Bad_Operation (CORBA.Default_Sys_Member);");
       DI (CU);
-      PL (CU, "end if;");
+      DI (CU);
+      PL (CU, "end case;");
       DI (CU);
       PL (CU, "exception");
       II (CU);
@@ -443,6 +777,7 @@ package body Ada_Be.Idl2Ada.Skel is
       DI (CU);
       PL (CU, "end Invoke;");
       Divert (CU, Decls_Div);
+      Gen_Dispatch_Index (CU, Is_Delegate);
       Undivert (CU, Operation_Body);
 
       if not Is_Delegate then
@@ -492,8 +827,9 @@ package body Ada_Be.Idl2Ada.Skel is
    ----------------
 
    procedure Gen_Invoke
-     (CU   : in out Compilation_Unit;
-      Node : Node_Id) is
+     (CU          : in out Compilation_Unit;
+      Node        : Node_Id;
+      Is_Delegate : Boolean) is
    begin
       case Kind (Node) is
 
@@ -553,11 +889,7 @@ package body Ada_Be.Idl2Ada.Skel is
                end;
 
                NL (CU);
-               PL (CU,
-                   "elsif Operation = """
-                   & Idl_Operation_Id (Node)
-                   & """ then");
-               II (CU);
+               Gen_Dispatch_Branch (CU, Is_Delegate, Idl_Operation_Id (Node));
 
                Arg_Seen := False;
                declare
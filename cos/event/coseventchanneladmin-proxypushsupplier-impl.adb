@@ -30,6 +30,8 @@
 --                                                                          --
 ------------------------------------------------------------------------------
 
+with Interfaces;
+
 with CORBA.Impl;
 
 with CosEventComm.PushConsumer;
@@ -37,8 +39,14 @@ with CosTypedEventComm.TypedPushConsumer;
 with CosTypedEventComm.TypedPushConsumer.Impl;
 
 with PolyORB.CORBA_P.Server_Tools;
+with PolyORB.Initialization;
 with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Tasking.Condition_Variables;
 with PolyORB.Tasking.Mutexes;
+with PolyORB.Tasking.Threads;
+with PolyORB.Utils.Chained_Lists;
+with PolyORB.Utils.Strings;
 
 with CosEventChannelAdmin.ProxyPushSupplier.Skel;
 pragma Warnings (Off, CosEventChannelAdmin.ProxyPushSupplier.Skel);
@@ -53,8 +61,11 @@ package body CosEventChannelAdmin.ProxyPushSupplier.Impl is
    use PortableServer;
 
    use PolyORB.CORBA_P.Server_Tools;
+   use PolyORB.Tasking.Condition_Variables;
    use PolyORB.Tasking.Mutexes;
 
+   use type Interfaces.Unsigned_64;
+
    use PolyORB.Log;
    package L is new PolyORB.Log.Facility_Log ("proxypushsupplier");
    procedure O (Message : Standard.String; Level : Log_Level := Debug)
@@ -63,12 +74,73 @@ package body CosEventChannelAdmin.ProxyPushSupplier.Impl is
      renames L.Enabled;
    pragma Unreferenced (C); --  For conditional pragma Debug
 
+   package Event_Queues is new PolyORB.Utils.Chained_Lists
+     (CORBA.Any, CORBA."=");
+
    type Proxy_Push_Supplier_Record is record
       This   : Object_Ptr;
       Peer   : PushConsumer.Ref;
       Admin  : ConsumerAdmin.Ref;
+
+      Queue  : Event_Queues.List;
+      Queued : Natural := 0;
+      --  Events posted to the proxy and not yet pushed to its consumer
+
+      Scheduled : Boolean := False;
+      --  True while the proxy is in the Ready list or drained by a worker
+
+      Dropped : Interfaces.Unsigned_64 := 0;
+      --  Events discarded because the queue was full (wraps around)
    end record;
 
+   --  Events are pushed to consumers by a pool of dispatching tasks, so
+   --  that posting an event does not wait for any consumer. Each proxy has
+   --  its own queue of events, and is drained by at most one task at a
+   --  time so that its consumer receives events in order.
+
+   package Proxy_Lists is new PolyORB.Utils.Chained_Lists (Object_Ptr);
+
+   type Pool_State is (Not_Started, Running, Unavailable);
+
+   State : Pool_State := Not_Started;
+   --  Unavailable if dispatching tasks cannot be created (no tasking
+   --  profile), in which case events are pushed synchronously by Post.
+
+   Ready : Proxy_Lists.List;
+   --  Proxies that have queued events and are not being drained
+
+   Work_Available : Condition_Access;
+   --  Signalled when a proxy is appended to Ready, broadcast when the pool
+   --  is stopped.
+
+   Stopping : Boolean := False;
+   --  Set when the dispatching tasks must exit
+
+   Pool_Tasks : Natural := 0;
+   --  Count of dispatching tasks that have not exited yet
+
+   Pool_Stopped : Condition_Access;
+   --  Signalled when Pool_Tasks drops to 0 after Stopping is set
+
+   Batch_Size     : Positive;
+   Max_Queue_Size : Positive;
+   --  Set from the configuration when the pool is started
+
+   procedure Dispatch_Loop;
+   --  Main loop of the dispatching tasks
+
+   procedure Start_Pool;
+   --  Start the dispatching tasks. Must be called with Self_Mutex held.
+
+   procedure Stop_Pool (Wait_For_Completion : Boolean);
+   --  Have the dispatching tasks exit once they have pushed their current
+   --  batch, discarding the events still queued, and if Wait_For_Completion
+   --  is True wait until they have all exited. Must be called with
+   --  Self_Mutex held.
+
+   procedure Shutdown (Wait_For_Completion : Boolean);
+   --  Module shutdown: stop the dispatching tasks, if any
+
    ---------------------------
    -- Ensure_Initialization --
    ---------------------------
@@ -154,6 +226,11 @@ package body CosEventChannelAdmin.ProxyPushSupplier.Impl is
       Enter (Self_Mutex);
       Peer        := Self.X.Peer;
       Self.X.Peer := Nil_Ref;
+
+      --  Discard the events not yet pushed
+
+      Event_Queues.Deallocate (Self.X.Queue);
+      Self.X.Queued := 0;
       Leave (Self_Mutex);
 
       if PushConsumer.Is_Nil (Peer) then
@@ -161,6 +238,72 @@ package body CosEventChannelAdmin.ProxyPushSupplier.Impl is
       end if;
    end Disconnect_Push_Supplier;
 
+   -------------------
+   -- Dispatch_Loop --
+   -------------------
+
+   procedure Dispatch_Loop is
+      Proxy : Object_Ptr;
+   begin
+      loop
+         Enter (Self_Mutex);
+
+         while Proxy_Lists.Is_Empty (Ready) and then not Stopping loop
+            Wait (Work_Available, Self_Mutex);
+         end loop;
+
+         if Stopping then
+            Pool_Tasks := Pool_Tasks - 1;
+            if Pool_Tasks = 0 then
+               Broadcast (Pool_Stopped);
+            end if;
+            Leave (Self_Mutex);
+            exit;
+         end if;
+
+         Proxy_Lists.Extract_First (Ready, Proxy);
+
+         --  Take a batch of events from the queue of Proxy, and push them
+         --  with the lock released.
+
+         declare
+            Batch : array (1 .. Natural'Min (Proxy.X.Queued, Batch_Size))
+              of CORBA.Any;
+            Peer  : constant PushConsumer.Ref := Proxy.X.Peer;
+         begin
+            for J in Batch'Range loop
+               Event_Queues.Extract_First (Proxy.X.Queue, Batch (J));
+            end loop;
+            Proxy.X.Queued := Proxy.X.Queued - Batch'Length;
+
+            Leave (Self_Mutex);
+
+            for J in Batch'Range loop
+               exit when PushConsumer.Is_Nil (Peer);
+
+               begin
+                  PushConsumer.push (Peer, Batch (J));
+               exception
+                  when others =>
+                     pragma Debug (O ("Got exception in Dispatch_Loop"));
+                     null;
+               end;
+            end loop;
+         end;
+
+         --  Give the other proxies a chance before draining Proxy again
+
+         Enter (Self_Mutex);
+         if Proxy.X.Queued > 0 then
+            Proxy_Lists.Append (Ready, Proxy);
+            Signal (Work_Available);
+         else
+            Proxy.X.Scheduled := False;
+         end if;
+         Leave (Self_Mutex);
+      end loop;
+   end Dispatch_Loop;
+
    ----------
    -- Post --
    ----------
@@ -172,13 +315,56 @@ package body CosEventChannelAdmin.ProxyPushSupplier.Impl is
       pragma Debug
         (O ("post new data from proxy push supplier to push consumer"));
 
-      begin
-         PushConsumer.push (Self.X.Peer, Data);
-      exception
-         when others =>
-            pragma Debug (O ("Got exception in Post"));
-            raise;
-      end;
+      Ensure_Initialization;
+
+      Enter (Self_Mutex);
+
+      if State = Not_Started then
+         Start_Pool;
+      end if;
+
+      if State = Unavailable then
+         Leave (Self_Mutex);
+
+         begin
+            PushConsumer.push (Self.X.Peer, Data);
+         exception
+            when others =>
+               pragma Debug (O ("Got exception in Post"));
+               raise;
+         end;
+         return;
+      end if;
+
+      --  Events posted before a consumer is connected are not delivered
+
+      if PushConsumer.Is_Nil (Self.X.Peer) then
+         Leave (Self_Mutex);
+         return;
+      end if;
+
+      if Self.X.Queued = Max_Queue_Size then
+         declare
+            Oldest : CORBA.Any;
+         begin
+            Event_Queues.Extract_First (Self.X.Queue, Oldest);
+         end;
+         Self.X.Queued := Self.X.Queued - 1;
+         Self.X.Dropped := Self.X.Dropped + 1;
+         pragma Debug (O ("queue full, dropped" & Self.X.Dropped'Img
+                          & " event(s)"));
+      end if;
+
+      Event_Queues.Append (Self.X.Queue, Data);
+      Self.X.Queued := Self.X.Queued + 1;
+
+      if not Self.X.Scheduled then
+         Self.X.Scheduled := True;
+         Proxy_Lists.Append (Ready, Self.X.This);
+         Signal (Work_Available);
+      end if;
+
+      Leave (Self_Mutex);
    end Post;
 
    ----------
@@ -210,4 +396,103 @@ package body CosEventChannelAdmin.ProxyPushSupplier.Impl is
 
    end Post;
 
+   ----------------
+   -- Start_Pool --
+   ----------------
+
+   procedure Start_Pool is
+      use PolyORB.Parameters;
+
+      Threads : constant Integer :=
+        Get_Conf ("cos_event", "dispatch_threads", 4);
+
+   begin
+      Batch_Size :=
+        Positive'Max (1, Get_Conf ("cos_event", "dispatch_batch", 64));
+      Max_Queue_Size :=
+        Positive'Max (1, Get_Conf ("cos_event", "dispatch_queue_size", 1024));
+      Create (Work_Available);
+      Create (Pool_Stopped);
+
+      for J in 1 .. Positive'Max (1, Threads) loop
+         PolyORB.Tasking.Threads.Create_Task
+           (Dispatch_Loop'Access, "cos_event_dispatch");
+         Pool_Tasks := Pool_Tasks + 1;
+      end loop;
+      State := Running;
+
+   exception
+      when Tasking_Error =>
+         pragma Debug (O ("no dispatching tasks, pushing synchronously"));
+
+         --  Have the tasks created before the failure, if any, exit as
+         --  soon as Self_Mutex is released.
+
+         Stop_Pool (Wait_For_Completion => False);
+         State := Unavailable;
+   end Start_Pool;
+
+   ---------------
+   -- Stop_Pool --
+   ---------------
+
+   procedure Stop_Pool (Wait_For_Completion : Boolean) is
+   begin
+      Stopping := True;
+      Broadcast (Work_Available);
+
+      if Wait_For_Completion then
+         while Pool_Tasks > 0 loop
+            Wait (Pool_Stopped, Self_Mutex);
+         end loop;
+      end if;
+   end Stop_Pool;
+
+   --------------
+   -- Shutdown --
+   --------------
+
+   procedure Shutdown (Wait_For_Completion : Boolean) is
+   begin
+      if not T_Initialized then
+         return;
+      end if;
+
+      Enter (Self_Mutex);
+      if State = Running then
+         Stop_Pool (Wait_For_Completion);
+
+         --  Events posted from now on are pushed synchronously
+
+         State := Unavailable;
+      end if;
+      Leave (Self_Mutex);
+   end Shutdown;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize;
+
+   procedure Initialize is
+   begin
+      Ensure_Initialization;
+   end Initialize;
+
+   use PolyORB.Initialization;
+   use PolyORB.Initialization.String_Lists;
+   use PolyORB.Utils.Strings;
+
+begin
+   Register_Module
+     (Module_Info'
+      (Name      => +"cos_event.dispatch",
+       Conflicts => Empty,
+       Depends   => +"tasking.mutexes"
+         & "tasking.condition_variables",
+       Provides  => Empty,
+       Implicit  => False,
+       Init      => Initialize'Access,
+       Shutdown  => Shutdown'Access));
 end CosEventChannelAdmin.ProxyPushSupplier.Impl;
@@ -0,0 +1,1515 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--          C O S N O T I F Y F I L T E R . C O N S T R A I N T S           --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+with Ada.Characters.Handling;
+with Ada.Unchecked_Deallocation;
+
+with PolyORB.Any;
+with PolyORB.Log;
+
+with CosNotification.Helper;
+
+package body CosNotifyFilter.Constraints is
+
+   use CosNotification;
+   use IDL_SEQUENCE_CosNotification_EventType;
+   use IDL_SEQUENCE_CosNotification_Property;
+
+   use PolyORB.Log;
+   package L is new PolyORB.Log.Facility_Log ("constraints");
+   procedure O (Message : Standard.String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+   pragma Unreferenced (C); --  For conditional pragma Debug
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Instruction_Array, Code_Access);
+
+   Evaluation_Error : exception;
+   --  Raised when the evaluation of a constraint fails
+
+   package Instruction_Tables is new PolyORB.Utils.Dynamic_Tables
+     (Instruction, Natural, 1, 32, 32);
+
+   procedure Compile
+     (Set   : in out Constraint_Set;
+      Text  : Standard.String;
+      Code  : out Code_Access;
+      Depth : out Positive);
+   --  Compile constraint expression Text into Code, recording the shared
+   --  constants, components and predicates in Set. Depth is the maximum
+   --  depth of the stack when running Code. Raise Invalid_Constraint if
+   --  Text is not a valid expression.
+
+   procedure Compact (Set : in out Constraint_Set);
+   --  Remove from the tables of Set the constants, components and
+   --  predicates that no constraint uses anymore, and renumber the others.
+
+   function Compare
+     (Left  : Value;
+      Rel   : Relation;
+      Right : Value) return Boolean;
+   --  Compare Left and Right according to Rel
+
+   procedure Find_Property
+     (Props  : PropertySeq;
+      Name   : Unbounded_String;
+      Result : out Value;
+      Found  : out Boolean);
+   --  Return the value of property Name in Props in Result, and set Found
+   --  to True, or set Found to False if Props has no such property.
+
+   function Matches (Pattern, Name : Standard.String) return Boolean;
+   --  True if Name matches Pattern, in which '*' matches any sequence of
+   --  characters. An empty pattern and "%ALL" match any name.
+
+   function To_Boolean (V : Value) return Boolean;
+   --  Return the value of boolean V
+
+   function To_Value (A : CORBA.Any) return Value;
+   --  Return the value of A if it is of a basic type, else Missing
+
+   generic
+      with function Component_Value (Comp : Component) return Value;
+      --  Return the value of Comp in the event being matched
+
+      with function Type_Matches (Types : EventTypeSeq) return Boolean;
+      --  True if the type of the event is one of Types
+
+   function Match_G (Set : Constraint_Set) return Boolean;
+   --  Common part of the Match functions
+
+   ---------
+   -- Add --
+   ---------
+
+   procedure Add
+     (Set : in out Constraint_Set;
+      Id  : ConstraintID;
+      Exp : ConstraintExp)
+   is
+      Code  : Code_Access;
+      Depth : Positive;
+
+   begin
+      begin
+         Compile (Set, CORBA.To_Standard_String (Exp.constraint_expr),
+                  Code, Depth);
+      exception
+         when Invalid_Constraint =>
+
+            --  Drop the entries interned before the error was detected
+
+            Compact (Set);
+            raise;
+      end;
+
+      Constraint_Lists.Append
+        (Set.Constraints, (Id    => Id,
+                           Types => Exp.event_types,
+                           Code  => Code,
+                           Depth => Depth));
+   end Add;
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Exp : ConstraintExp) is
+      Set : Constraint_Set;
+   begin
+      Initialize (Set);
+      Add (Set, 0, Exp);
+      Destroy (Set);
+   exception
+      when Invalid_Constraint =>
+         Destroy (Set);
+         raise;
+   end Check;
+
+   -----------
+   -- Clear --
+   -----------
+
+   procedure Clear (Set : in out Constraint_Set) is
+      use Constraint_Lists;
+
+      It : Iterator := First (Set.Constraints);
+
+   begin
+      while not Last (It) loop
+         Free (Constraint_Lists.Value (It).Code);
+         Next (It);
+      end loop;
+      Deallocate (Set.Constraints);
+
+      Value_Tables.Set_Last (Set.Constants, 0);
+      Component_Tables.Set_Last (Set.Components, 0);
+      Predicate_Tables.Set_Last (Set.Predicates, 0);
+   end Clear;
+
+   -------------
+   -- Compact --
+   -------------
+
+   procedure Compact (Set : in out Constraint_Set) is
+      use Constraint_Lists;
+
+      type Index_Map is array (Positive range <>) of Natural;
+      --  New index of each entry of a table, 0 for unused entries
+
+      Constant_Map  : Index_Map (1 .. Value_Tables.Last (Set.Constants)) :=
+                        (others => 0);
+      Component_Map : Index_Map
+                        (1 .. Component_Tables.Last (Set.Components)) :=
+                        (others => 0);
+      Predicate_Map : Index_Map
+                        (1 .. Predicate_Tables.Last (Set.Predicates)) :=
+                        (others => 0);
+      Count : Natural;
+      It    : Iterator;
+
+   begin
+      --  Mark the entries used by the remaining constraints
+
+      It := First (Set.Constraints);
+      while not Last (It) loop
+         declare
+            Code : Instruction_Array renames
+              Constraint_Lists.Value (It).Code.all;
+         begin
+            for J in Code'Range loop
+               case Code (J).Op is
+                  when Push_Constant =>
+                     Constant_Map (Code (J).Arg) := 1;
+                  when Push_Component | Exist =>
+                     Component_Map (Code (J).Arg) := 1;
+                  when Test =>
+                     Predicate_Map (Code (J).Arg) := 1;
+                  when others =>
+                     null;
+               end case;
+            end loop;
+         end;
+         Next (It);
+      end loop;
+
+      for J in Predicate_Map'Range loop
+         if Predicate_Map (J) /= 0 then
+            Component_Map (Set.Predicates.Table (J).Comp) := 1;
+            Constant_Map (Set.Predicates.Table (J).Literal) := 1;
+         end if;
+      end loop;
+
+      --  Move the used entries down, preserving their order
+
+      Count := 0;
+      for J in Constant_Map'Range loop
+         if Constant_Map (J) /= 0 then
+            Count := Count + 1;
+            Constant_Map (J) := Count;
+            Set.Constants.Table (Count) := Set.Constants.Table (J);
+         end if;
+      end loop;
+      Value_Tables.Set_Last (Set.Constants, Count);
+
+      Count := 0;
+      for J in Component_Map'Range loop
+         if Component_Map (J) /= 0 then
+            Count := Count + 1;
+            Component_Map (J) := Count;
+            Set.Components.Table (Count) := Set.Components.Table (J);
+         end if;
+      end loop;
+      Component_Tables.Set_Last (Set.Components, Count);
+
+      Count := 0;
+      for J in Predicate_Map'Range loop
+         if Predicate_Map (J) /= 0 then
+            Count := Count + 1;
+            Predicate_Map (J) := Count;
+
+            declare
+               P : constant Predicate := Set.Predicates.Table (J);
+            begin
+               Set.Predicates.Table (Count) :=
+                 (Comp     => Component_Map (P.Comp),
+                  Rel      => P.Rel,
+                  Literal  => Constant_Map (P.Literal),
+                  Reversed => P.Reversed);
+            end;
+         end if;
+      end loop;
+      Predicate_Tables.Set_Last (Set.Predicates, Count);
+
+      --  Renumber the references of the code of the constraints
+
+      It := First (Set.Constraints);
+      while not Last (It) loop
+         declare
+            Code : Instruction_Array renames
+              Constraint_Lists.Value (It).Code.all;
+         begin
+            for J in Code'Range loop
+               case Code (J).Op is
+                  when Push_Constant =>
+                     Code (J).Arg := Constant_Map (Code (J).Arg);
+                  when Push_Component | Exist =>
+                     Code (J).Arg := Component_Map (Code (J).Arg);
+                  when Test =>
+                     Code (J).Arg := Predicate_Map (Code (J).Arg);
+                  when others =>
+                     null;
+               end case;
+            end loop;
+         end;
+         Next (It);
+      end loop;
+   end Compact;
+
+   -------------
+   -- Compare --
+   -------------
+
+   function Compare
+     (Left  : Value;
+      Rel   : Relation;
+      Right : Value) return Boolean
+   is
+      Order : Integer;
+      --  Negative, zero or positive if Left is lower than, equal to, or
+      --  greater than Right.
+
+   begin
+      if Left.Kind /= Right.Kind or else Left.Kind = Missing then
+         raise Evaluation_Error;
+      end if;
+
+      if Rel = Substring then
+         if Left.Kind /= String_Value then
+            raise Evaluation_Error;
+         end if;
+         return Length (Left.S) = 0
+           or else Index (Right.S, To_String (Left.S)) > 0;
+      end if;
+
+      case Left.Kind is
+         when Boolean_Value =>
+            Order := Boolean'Pos (Left.B) - Boolean'Pos (Right.B);
+
+         when Number_Value =>
+            if Left.N < Right.N then
+               Order := -1;
+            elsif Left.N > Right.N then
+               Order := 1;
+            else
+               Order := 0;
+            end if;
+
+         when String_Value =>
+            if Left.S < Right.S then
+               Order := -1;
+            elsif Left.S > Right.S then
+               Order := 1;
+            else
+               Order := 0;
+            end if;
+
+         when Missing =>
+            raise Program_Error;
+      end case;
+
+      case Rel is
+         when Eq =>
+            return Order = 0;
+         when Ne =>
+            return Order /= 0;
+         when Lt =>
+            return Order < 0;
+         when Le =>
+            return Order <= 0;
+         when Gt =>
+            return Order > 0;
+         when Ge =>
+            return Order >= 0;
+         when Substring =>
+            raise Program_Error;
+      end case;
+   end Compare;
+
+   -------------
+   -- Compile --
+   -------------
+
+   procedure Compile
+     (Set   : in out Constraint_Set;
+      Text  : Standard.String;
+      Code  : out Code_Access;
+      Depth : out Positive)
+   is
+      use Instruction_Tables;
+
+      type Token_Kind is
+        (End_Of_Text, Number, String_Literal, Component_Name,
+         True_Literal, False_Literal, And_Op, Or_Op, Not_Op, Exist_Op,
+         Left_Paren, Right_Paren, Eq_Op, Ne_Op, Lt_Op, Le_Op, Gt_Op, Ge_Op,
+         Tilde, Plus, Minus, Times, Slash);
+
+      Program : Instruction_Tables.Instance;
+
+      Pos         : Positive := Text'First;
+      Token       : Token_Kind;
+      Token_Value : Value;
+      --  Current token and, for literals, its value
+
+      Token_Component : Component;
+      --  For Component_Name, the designated component
+
+      Current_Depth : Natural := 0;
+      Max_Depth     : Natural := 0;
+
+      procedure Emit (Op : Opcode; Arg : Natural := 0);
+      --  Append an instruction to Program
+
+      function Intern_Constant (V : Value) return Positive;
+      function Intern_Component (Comp : Component) return Positive;
+      function Intern_Predicate (P : Predicate) return Positive;
+      --  Return the index of V, Comp or P in the tables of Set, adding
+      --  them if necessary.
+
+      procedure Next_Token;
+      --  Scan the next token of Text
+
+      procedure Parse_Or;
+      procedure Parse_And;
+      procedure Parse_Not;
+      procedure Parse_Comparison;
+      procedure Parse_Sum;
+      procedure Parse_Product;
+      procedure Parse_Unary;
+      procedure Parse_Primary;
+      --  Recursive descent parser, one procedure per precedence level, each
+      --  emitting the code of the expression starting at the current token.
+
+      procedure Syntax_Error;
+      pragma No_Return (Syntax_Error);
+
+      ----------
+      -- Emit --
+      ----------
+
+      procedure Emit (Op : Opcode; Arg : Natural := 0) is
+      begin
+         case Op is
+            when Push_Constant | Push_Component | Exist | Test =>
+               Current_Depth := Current_Depth + 1;
+            when Compare | Add | Subtract | Multiply | Divide
+              | Jump_If_False | Jump_If_True =>
+               Current_Depth := Current_Depth - 1;
+            when Negate | Logical_Not =>
+               null;
+         end case;
+         Max_Depth := Natural'Max (Max_Depth, Current_Depth);
+
+         Increment_Last (Program);
+         Program.Table (Last (Program)) := (Op => Op, Arg => Arg);
+      end Emit;
+
+      ----------------------
+      -- Intern_Component --
+      ----------------------
+
+      function Intern_Component (Comp : Component) return Positive is
+         use Component_Tables;
+      begin
+         for J in First (Set.Components) .. Last (Set.Components) loop
+            if Set.Components.Table (J) = Comp then
+               return J;
+            end if;
+         end loop;
+         Increment_Last (Set.Components);
+         Set.Components.Table (Last (Set.Components)) := Comp;
+         return Last (Set.Components);
+      end Intern_Component;
+
+      ---------------------
+      -- Intern_Constant --
+      ---------------------
+
+      function Intern_Constant (V : Value) return Positive is
+         use Value_Tables;
+      begin
+         for J in First (Set.Constants) .. Last (Set.Constants) loop
+            if Set.Constants.Table (J) = V then
+               return J;
+            end if;
+         end loop;
+         Increment_Last (Set.Constants);
+         Set.Constants.Table (Last (Set.Constants)) := V;
+         return Last (Set.Constants);
+      end Intern_Constant;
+
+      ----------------------
+      -- Intern_Predicate --
+      ----------------------
+
+      function Intern_Predicate (P : Predicate) return Positive is
+         use Predicate_Tables;
+      begin
+         for J in First (Set.Predicates) .. Last (Set.Predicates) loop
+            if Set.Predicates.Table (J) = P then
+               return J;
+            end if;
+         end loop;
+         Increment_Last (Set.Predicates);
+         Set.Predicates.Table (Last (Set.Predicates)) := P;
+         return Last (Set.Predicates);
+      end Intern_Predicate;
+
+      ----------------
+      -- Next_Token --
+      ----------------
+
+      procedure Next_Token is
+         use Ada.Characters.Handling;
+
+         First : Positive;
+
+         function Is_Name_Character (C : Character) return Boolean;
+         --  True for the characters of identifiers
+
+         function Is_Name_Character (C : Character) return Boolean is
+         begin
+            return Is_Alphanumeric (C) or else C = '_';
+         end Is_Name_Character;
+
+      begin
+         while Pos <= Text'Last
+           and then (Text (Pos) = ' ' or else Is_Control (Text (Pos)))
+         loop
+            Pos := Pos + 1;
+         end loop;
+
+         if Pos > Text'Last then
+            Token := End_Of_Text;
+            return;
+         end if;
+
+         First := Pos;
+         Pos := Pos + 1;
+
+         case Text (First) is
+            when '(' =>
+               Token := Left_Paren;
+            when ')' =>
+               Token := Right_Paren;
+            when '+' =>
+               Token := Plus;
+            when '-' =>
+               Token := Minus;
+            when '*' =>
+               Token := Times;
+            when '/' =>
+               Token := Slash;
+            when '~' =>
+               Token := Tilde;
+
+            when '=' | '!' | '<' | '>' =>
+               if Pos <= Text'Last and then Text (Pos) = '=' then
+                  Pos := Pos + 1;
+                  case Text (First) is
+                     when '=' =>
+                        Token := Eq_Op;
+                     when '!' =>
+                        Token := Ne_Op;
+                     when '<' =>
+                        Token := Le_Op;
+                     when others =>
+                        Token := Ge_Op;
+                  end case;
+
+               elsif Text (First) = '<' then
+                  Token := Lt_Op;
+               elsif Text (First) = '>' then
+                  Token := Gt_Op;
+               else
+                  Syntax_Error;
+               end if;
+
+            when ''' =>
+               declare
+                  S : Unbounded_String;
+               begin
+                  loop
+                     if Pos > Text'Last then
+                        Syntax_Error;
+                     end if;
+
+                     exit when Text (Pos) = ''';
+
+                     if Text (Pos) = '\' and then Pos < Text'Last then
+                        Pos := Pos + 1;
+                     end if;
+                     Append (S, Text (Pos));
+                     Pos := Pos + 1;
+                  end loop;
+                  Pos := Pos + 1;
+
+                  Token := String_Literal;
+                  Token_Value := (Kind => String_Value, S => S);
+               end;
+
+            when '0' .. '9' =>
+               while Pos <= Text'Last
+                 and then (Is_Digit (Text (Pos)) or else Text (Pos) = '.')
+               loop
+                  Pos := Pos + 1;
+               end loop;
+
+               if Pos <= Text'Last
+                 and then (Text (Pos) = 'e' or else Text (Pos) = 'E')
+               then
+                  Pos := Pos + 1;
+                  if Pos <= Text'Last
+                    and then (Text (Pos) = '+' or else Text (Pos) = '-')
+                  then
+                     Pos := Pos + 1;
+                  end if;
+                  while Pos <= Text'Last and then Is_Digit (Text (Pos)) loop
+                     Pos := Pos + 1;
+                  end loop;
+               end if;
+
+               begin
+                  Token := Number;
+                  Token_Value :=
+                    (Kind => Number_Value,
+                     N    => Long_Long_Float'Value (Text (First .. Pos - 1)));
+               exception
+                  when Constraint_Error =>
+                     Syntax_Error;
+               end;
+
+            when '$' =>
+               while Pos <= Text'Last
+                 and then (Is_Name_Character (Text (Pos))
+                             or else Text (Pos) = '.')
+               loop
+                  Pos := Pos + 1;
+               end loop;
+
+               declare
+                  Name   : constant Standard.String :=
+                    Text (First + 1 .. Pos - 1);
+                  Header : constant Standard.String :=
+                    ".header.fixed_header.";
+               begin
+                  Token := Component_Name;
+                  if Name = "" then
+                     Token_Component := (Whole_Event, Null_Unbounded_String);
+                  elsif Name = "domain_name"
+                    or else Name = Header & "event_type.domain_name"
+                  then
+                     Token_Component := (Domain_Name, Null_Unbounded_String);
+                  elsif Name = "type_name"
+                    or else Name = Header & "event_type.type_name"
+                  then
+                     Token_Component := (Type_Name, Null_Unbounded_String);
+                  elsif Name = "event_name"
+                    or else Name = Header & "event_name"
+                  then
+                     Token_Component := (Event_Name, Null_Unbounded_String);
+                  elsif Index (To_Unbounded_String (Name), ".") = 0 then
+                     Token_Component :=
+                       (Property, To_Unbounded_String (Name));
+                  else
+                     Syntax_Error;
+                  end if;
+               end;
+
+            when 'a' .. 'z' | 'A' .. 'Z' =>
+               while Pos <= Text'Last
+                 and then Is_Name_Character (Text (Pos))
+               loop
+                  Pos := Pos + 1;
+               end loop;
+
+               declare
+                  Word : constant Standard.String := Text (First .. Pos - 1);
+               begin
+                  if Word = "and" then
+                     Token := And_Op;
+                  elsif Word = "or" then
+                     Token := Or_Op;
+                  elsif Word = "not" then
+                     Token := Not_Op;
+                  elsif Word = "exist" then
+                     Token := Exist_Op;
+                  elsif To_Upper (Word) = "TRUE" then
+                     Token := True_Literal;
+                  elsif To_Upper (Word) = "FALSE" then
+                     Token := False_Literal;
+                  else
+                     Syntax_Error;
+                  end if;
+               end;
+
+            when others =>
+               Syntax_Error;
+         end case;
+      end Next_Token;
+
+      ---------------
+      -- Parse_And --
+      ---------------
+
+      procedure Parse_And is
+         Jump : Positive;
+      begin
+         Parse_Not;
+         while Token = And_Op loop
+            Emit (Jump_If_False);
+            Jump := Last (Program);
+            Next_Token;
+            Parse_Not;
+            Program.Table (Jump).Arg := Last (Program) + 1;
+         end loop;
+      end Parse_And;
+
+      ----------------------
+      -- Parse_Comparison --
+      ----------------------
+
+      procedure Parse_Comparison is
+         Left_First  : constant Positive := Last (Program) + 1;
+         Right_First : Positive;
+         Rel         : Relation;
+
+      begin
+         Parse_Sum;
+
+         case Token is
+            when Eq_Op =>
+               Rel := Eq;
+            when Ne_Op =>
+               Rel := Ne;
+            when Lt_Op =>
+               Rel := Lt;
+            when Le_Op =>
+               Rel := Le;
+            when Gt_Op =>
+               Rel := Gt;
+            when Ge_Op =>
+               Rel := Ge;
+            when Tilde =>
+               Rel := Substring;
+            when others =>
+               return;
+         end case;
+
+         Right_First := Last (Program) + 1;
+         Next_Token;
+         Parse_Sum;
+
+         --  Comparisons of a component with a literal are shared by all
+         --  the constraints of Set.
+
+         if Right_First = Left_First + 1
+           and then Last (Program) = Right_First
+         then
+            declare
+               Left  : constant Instruction := Program.Table (Left_First);
+               Right : constant Instruction := Program.Table (Right_First);
+               P     : Predicate;
+            begin
+               if Left.Op = Push_Component
+                 and then Right.Op = Push_Constant
+               then
+                  P := (Comp     => Left.Arg,
+                        Rel      => Rel,
+                        Literal  => Right.Arg,
+                        Reversed => False);
+
+               elsif Left.Op = Push_Constant
+                 and then Right.Op = Push_Component
+               then
+                  P := (Comp     => Right.Arg,
+                        Rel      => Rel,
+                        Literal  => Left.Arg,
+                        Reversed => True);
+
+               else
+                  Emit (Compare, Relation'Pos (Rel));
+                  return;
+               end if;
+
+               Set_Last (Program, Left_First - 1);
+               Current_Depth := Current_Depth - 2;
+               Emit (Test, Intern_Predicate (P));
+               return;
+            end;
+         end if;
+
+         Emit (Compare, Relation'Pos (Rel));
+      end Parse_Comparison;
+
+      ---------------
+      -- Parse_Not --
+      ---------------
+
+      procedure Parse_Not is
+      begin
+         if Token = Not_Op then
+            Next_Token;
+            Parse_Not;
+            Emit (Logical_Not);
+         else
+            Parse_Comparison;
+         end if;
+      end Parse_Not;
+
+      --------------
+      -- Parse_Or --
+      --------------
+
+      procedure Parse_Or is
+         Jump : Positive;
+      begin
+         Parse_And;
+         while Token = Or_Op loop
+            Emit (Jump_If_True);
+            Jump := Last (Program);
+            Next_Token;
+            Parse_And;
+            Program.Table (Jump).Arg := Last (Program) + 1;
+         end loop;
+      end Parse_Or;
+
+      -------------------
+      -- Parse_Primary --
+      -------------------
+
+      procedure Parse_Primary is
+      begin
+         case Token is
+            when Number | String_Literal =>
+               Emit (Push_Constant, Intern_Constant (Token_Value));
+
+            when True_Literal | False_Literal =>
+               Emit (Push_Constant, Intern_Constant
+                 ((Kind => Boolean_Value, B => Token = True_Literal)));
+
+            when Component_Name =>
+               Emit (Push_Component, Intern_Component (Token_Component));
+
+            when Exist_Op =>
+               Next_Token;
+               if Token /= Component_Name then
+                  Syntax_Error;
+               end if;
+               Emit (Exist, Intern_Component (Token_Component));
+
+            when Left_Paren =>
+               Next_Token;
+               Parse_Or;
+               if Token /= Right_Paren then
+                  Syntax_Error;
+               end if;
+
+            when others =>
+               Syntax_Error;
+         end case;
+         Next_Token;
+      end Parse_Primary;
+
+      -------------------
+      -- Parse_Product --
+      -------------------
+
+      procedure Parse_Product is
+         Op : Opcode;
+      begin
+         Parse_Unary;
+         while Token = Times or else Token = Slash loop
+            if Token = Times then
+               Op := Multiply;
+            else
+               Op := Divide;
+            end if;
+            Next_Token;
+            Parse_Unary;
+            Emit (Op);
+         end loop;
+      end Parse_Product;
+
+      ---------------
+      -- Parse_Sum --
+      ---------------
+
+      procedure Parse_Sum is
+         Op : Opcode;
+      begin
+         Parse_Product;
+         while Token = Plus or else Token = Minus loop
+            if Token = Plus then
+               Op := Add;
+            else
+               Op := Subtract;
+            end if;
+            Next_Token;
+            Parse_Product;
+            Emit (Op);
+         end loop;
+      end Parse_Sum;
+
+      -----------------
+      -- Parse_Unary --
+      -----------------
+
+      procedure Parse_Unary is
+      begin
+         if Token = Minus then
+            Next_Token;
+            Parse_Unary;
+            Emit (Negate);
+         else
+            Parse_Primary;
+         end if;
+      end Parse_Unary;
+
+      ------------------
+      -- Syntax_Error --
+      ------------------
+
+      procedure Syntax_Error is
+      begin
+         pragma Debug (O ("invalid constraint: " & Text));
+         Deallocate (Program);
+         raise Invalid_Constraint;
+      end Syntax_Error;
+
+   begin
+      Initialize (Program);
+      Next_Token;
+
+      --  An empty constraint is satisfied by all events
+
+      if Token = End_Of_Text then
+         Emit (Push_Constant, Intern_Constant
+           ((Kind => Boolean_Value, B => True)));
+      else
+         Parse_Or;
+         if Token /= End_Of_Text then
+            Syntax_Error;
+         end if;
+      end if;
+
+      Code  := new Instruction_Array'
+        (Instruction_Array (Program.Table (1 .. Last (Program))));
+      Depth := Max_Depth;
+      Deallocate (Program);
+   end Compile;
+
+   -------------
+   -- Destroy --
+   -------------
+
+   procedure Destroy (Set : in out Constraint_Set) is
+   begin
+      Clear (Set);
+      Value_Tables.Deallocate (Set.Constants);
+      Component_Tables.Deallocate (Set.Components);
+      Predicate_Tables.Deallocate (Set.Predicates);
+   end Destroy;
+
+   -------------------
+   -- Find_Property --
+   -------------------
+
+   procedure Find_Property
+     (Props  : PropertySeq;
+      Name   : Unbounded_String;
+      Result : out Value;
+      Found  : out Boolean)
+   is
+   begin
+      for J in 1 .. Length (Props) loop
+         declare
+            Prop : constant Property := Get_Element (Props, J);
+         begin
+            if Unbounded_String (Prop.name) = Name then
+               Result := To_Value (Prop.value);
+               Found := True;
+               return;
+            end if;
+         end;
+      end loop;
+      Result := (Kind => Missing);
+      Found := False;
+   end Find_Property;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize (Set : in out Constraint_Set) is
+   begin
+      Value_Tables.Initialize (Set.Constants);
+      Component_Tables.Initialize (Set.Components);
+      Predicate_Tables.Initialize (Set.Predicates);
+   end Initialize;
+
+   -----------
+   -- Match --
+   -----------
+
+   function Match
+     (Set  : Constraint_Set;
+      Data : CORBA.Any) return Boolean
+   is
+      use CORBA.TypeCode;
+
+      Data_Type : constant CORBA.TypeCode.Object := CORBA.Get_Type (Data);
+
+   begin
+      if Data_Type = CosNotification.Helper.TC_StructuredEvent then
+         return Match_Structured
+           (Set, CosNotification.Helper.From_Any (Data));
+      elsif Data_Type = CosNotification.Helper.TC_PropertySeq then
+         return Match_Typed (Set, CosNotification.Helper.From_Any (Data));
+      end if;
+
+      declare
+         function Component_Value (Comp : Component) return Value;
+         function Type_Matches (Types : EventTypeSeq) return Boolean;
+
+         function Component_Value (Comp : Component) return Value is
+         begin
+            if Comp.Kind = Whole_Event then
+               return To_Value (Data);
+            else
+               return (Kind => Missing);
+            end if;
+         end Component_Value;
+
+         function Type_Matches (Types : EventTypeSeq) return Boolean is
+            pragma Unreferenced (Types);
+         begin
+            return True;
+         end Type_Matches;
+
+         function Match_Any is new Match_G (Component_Value, Type_Matches);
+
+      begin
+         return Match_Any (Set);
+      end;
+   end Match;
+
+   -------------
+   -- Match_G --
+   -------------
+
+   function Match_G (Set : Constraint_Set) return Boolean is
+      type Value_Array is array (Positive range <>) of Value;
+
+      type Test_Result is (Unknown, Satisfied, Not_Satisfied, Failed);
+      type Test_Result_Array is array (Positive range <>) of Test_Result;
+
+      Components : Value_Array (1 .. Component_Tables.Last (Set.Components));
+      Known      : array (Components'Range) of Boolean := (others => False);
+      --  Values of the components, computed on demand
+
+      Results : Test_Result_Array
+                  (1 .. Predicate_Tables.Last (Set.Predicates)) :=
+                  (others => Unknown);
+      --  Results of the predicates, computed on demand
+
+      function Get_Component (Index : Positive) return Value;
+      --  Return the value of component Index
+
+      function Get_Test (Index : Positive) return Boolean;
+      --  Return the result of predicate Index, or raise Evaluation_Error
+
+      function Run (C : Constraint) return Boolean;
+      --  Run the code of C
+
+      -------------------
+      -- Get_Component --
+      -------------------
+
+      function Get_Component (Index : Positive) return Value is
+      begin
+         if not Known (Index) then
+            Components (Index) :=
+              Component_Value (Set.Components.Table (Index));
+            Known (Index) := True;
+         end if;
+         return Components (Index);
+      end Get_Component;
+
+      --------------
+      -- Get_Test --
+      --------------
+
+      function Get_Test (Index : Positive) return Boolean is
+         R : Test_Result renames Results (Index);
+      begin
+         if R = Unknown then
+            declare
+               P        : Predicate renames Set.Predicates.Table (Index);
+               Comp     : constant Value := Get_Component (P.Comp);
+               Literal  : Value renames Set.Constants.Table (P.Literal);
+               Result   : Boolean;
+            begin
+               if P.Reversed then
+                  Result := Compare (Literal, P.Rel, Comp);
+               else
+                  Result := Compare (Comp, P.Rel, Literal);
+               end if;
+
+               if Result then
+                  R := Satisfied;
+               else
+                  R := Not_Satisfied;
+               end if;
+            exception
+               when Evaluation_Error =>
+                  R := Failed;
+            end;
+         end if;
+
+         case R is
+            when Satisfied =>
+               return True;
+            when Not_Satisfied =>
+               return False;
+            when others =>
+               raise Evaluation_Error;
+         end case;
+      end Get_Test;
+
+      ---------
+      -- Run --
+      ---------
+
+      function Run (C : Constraint) return Boolean is
+         Stack : Value_Array (1 .. C.Depth);
+         Top   : Natural := 0;
+         PC    : Positive := C.Code'First;
+
+      begin
+         while PC <= C.Code'Last loop
+            declare
+               I : Instruction renames C.Code (PC);
+            begin
+               PC := PC + 1;
+
+               case I.Op is
+                  when Push_Constant =>
+                     Top := Top + 1;
+                     Stack (Top) := Set.Constants.Table (I.Arg);
+
+                  when Push_Component =>
+                     Top := Top + 1;
+                     Stack (Top) := Get_Component (I.Arg);
+
+                  when Exist =>
+                     Top := Top + 1;
+                     Stack (Top) :=
+                       (Kind => Boolean_Value,
+                        B    => Get_Component (I.Arg).Kind /= Missing);
+
+                  when Test =>
+                     Top := Top + 1;
+                     Stack (Top) :=
+                       (Kind => Boolean_Value, B => Get_Test (I.Arg));
+
+                  when Compare =>
+                     Top := Top - 1;
+                     Stack (Top) :=
+                       (Kind => Boolean_Value,
+                        B    => Compare
+                          (Stack (Top), Relation'Val (I.Arg),
+                           Stack (Top + 1)));
+
+                  when Add | Subtract | Multiply | Divide =>
+                     Top := Top - 1;
+                     if Stack (Top).Kind /= Number_Value
+                       or else Stack (Top + 1).Kind /= Number_Value
+                     then
+                        raise Evaluation_Error;
+                     end if;
+
+                     declare
+                        Left  : constant Long_Long_Float := Stack (Top).N;
+                        Right : constant Long_Long_Float := Stack (Top + 1).N;
+                        N     : Long_Long_Float;
+                     begin
+                        case I.Op is
+                           when Add =>
+                              N := Left + Right;
+                           when Subtract =>
+                              N := Left - Right;
+                           when Multiply =>
+                              N := Left * Right;
+                           when others =>
+                              if Right = 0.0 then
+                                 raise Evaluation_Error;
+                              end if;
+                              N := Left / Right;
+                        end case;
+                        Stack (Top) := (Kind => Number_Value, N => N);
+                     end;
+
+                  when Negate =>
+                     if Stack (Top).Kind /= Number_Value then
+                        raise Evaluation_Error;
+                     end if;
+                     Stack (Top) :=
+                       (Kind => Number_Value, N => -Stack (Top).N);
+
+                  when Logical_Not =>
+                     Stack (Top) :=
+                       (Kind => Boolean_Value,
+                        B    => not To_Boolean (Stack (Top)));
+
+                  when Jump_If_False | Jump_If_True =>
+                     if To_Boolean (Stack (Top)) = (I.Op = Jump_If_True) then
+                        PC := I.Arg;
+                     else
+                        Top := Top - 1;
+                     end if;
+               end case;
+            end;
+         end loop;
+
+         return To_Boolean (Stack (Top));
+      end Run;
+
+      use Constraint_Lists;
+
+      It : Iterator := First (Set.Constraints);
+
+   begin
+      while not Last (It) loop
+         declare
+            C : Constraint renames Constraint_Lists.Value (It).all;
+         begin
+            if Type_Matches (C.Types) and then Run (C) then
+               return True;
+            end if;
+         exception
+            when Evaluation_Error =>
+               null;
+         end;
+         Next (It);
+      end loop;
+      return False;
+   end Match_G;
+
+   ----------------------
+   -- Match_Structured --
+   ----------------------
+
+   function Match_Structured
+     (Set   : Constraint_Set;
+      Event : CosNotification.StructuredEvent) return Boolean
+   is
+      Header : FixedEventHeader renames Event.header.fixed_header;
+      Domain : constant Standard.String :=
+        CORBA.To_Standard_String (Header.event_type.domain_name);
+      Name   : constant Standard.String :=
+        CORBA.To_Standard_String (Header.event_type.type_name);
+
+      function Component_Value (Comp : Component) return Value;
+      function Type_Matches (Types : EventTypeSeq) return Boolean;
+
+      ---------------------
+      -- Component_Value --
+      ---------------------
+
+      function Component_Value (Comp : Component) return Value is
+      begin
+         case Comp.Kind is
+            when Whole_Event =>
+               return (Kind => Missing);
+
+            when Domain_Name =>
+               return (Kind => String_Value,
+                       S    => Unbounded_String
+                                 (Header.event_type.domain_name));
+
+            when Type_Name =>
+               return (Kind => String_Value,
+                       S    => Unbounded_String
+                                 (Header.event_type.type_name));
+
+            when Event_Name =>
+               return (Kind => String_Value,
+                       S    => Unbounded_String (Header.event_name));
+
+            when Property =>
+               declare
+                  Result : Value;
+                  Found  : Boolean;
+               begin
+                  Find_Property (PropertySeq (Event.filterable_data),
+                                 Comp.Name, Result, Found);
+                  if not Found then
+                     Find_Property
+                       (PropertySeq (Event.header.variable_header),
+                        Comp.Name, Result, Found);
+                  end if;
+                  return Result;
+               end;
+         end case;
+      end Component_Value;
+
+      ------------------
+      -- Type_Matches --
+      ------------------
+
+      function Type_Matches (Types : EventTypeSeq) return Boolean is
+      begin
+         if Length (Types) = 0 then
+            return True;
+         end if;
+
+         for J in 1 .. Length (Types) loop
+            declare
+               T : constant EventType := Get_Element (Types, J);
+            begin
+               if Matches (CORBA.To_Standard_String (T.domain_name), Domain)
+                 and then Matches (CORBA.To_Standard_String (T.type_name),
+                                   Name)
+               then
+                  return True;
+               end if;
+            end;
+         end loop;
+         return False;
+      end Type_Matches;
+
+      function Match_Event is new Match_G (Component_Value, Type_Matches);
+
+   begin
+      return Match_Event (Set);
+   end Match_Structured;
+
+   -----------------
+   -- Match_Typed --
+   -----------------
+
+   function Match_Typed
+     (Set  : Constraint_Set;
+      Data : CosNotification.PropertySeq) return Boolean
+   is
+      function Component_Value (Comp : Component) return Value;
+      function Type_Matches (Types : EventTypeSeq) return Boolean;
+
+      ---------------------
+      -- Component_Value --
+      ---------------------
+
+      function Component_Value (Comp : Component) return Value is
+         Result : Value;
+         Found  : Boolean;
+      begin
+         if Comp.Kind = Property then
+            Find_Property (Data, Comp.Name, Result, Found);
+         end if;
+         return Result;
+      end Component_Value;
+
+      ------------------
+      -- Type_Matches --
+      ------------------
+
+      function Type_Matches (Types : EventTypeSeq) return Boolean is
+         pragma Unreferenced (Types);
+      begin
+         return True;
+      end Type_Matches;
+
+      function Match_Properties is
+        new Match_G (Component_Value, Type_Matches);
+
+   begin
+      return Match_Properties (Set);
+   end Match_Typed;
+
+   -------------
+   -- Matches --
+   -------------
+
+   function Matches (Pattern, Name : Standard.String) return Boolean is
+
+      function Match_Rest (Pattern, Name : Standard.String) return Boolean;
+      --  True if all of Name matches Pattern
+
+      ----------------
+      -- Match_Rest --
+      ----------------
+
+      function Match_Rest (Pattern, Name : Standard.String) return Boolean is
+      begin
+         if Pattern'Length = 0 then
+            return Name'Length = 0;
+
+         elsif Pattern (Pattern'First) = '*' then
+            for J in Name'First .. Name'Last + 1 loop
+               if Match_Rest (Pattern (Pattern'First + 1 .. Pattern'Last),
+                              Name (J .. Name'Last))
+               then
+                  return True;
+               end if;
+            end loop;
+            return False;
+
+         else
+            return Name'Length > 0
+              and then Name (Name'First) = Pattern (Pattern'First)
+              and then Match_Rest
+                         (Pattern (Pattern'First + 1 .. Pattern'Last),
+                          Name (Name'First + 1 .. Name'Last));
+         end if;
+      end Match_Rest;
+
+   begin
+      return Pattern'Length = 0
+        or else Pattern = "%ALL"
+        or else Match_Rest (Pattern, Name);
+   end Matches;
+
+   ------------
+   -- Remove --
+   ------------
+
+   procedure Remove (Set : in out Constraint_Set; Id : ConstraintID) is
+      use Constraint_Lists;
+
+      It : Iterator := First (Set.Constraints);
+
+   begin
+      while not Last (It) loop
+         if Constraint_Lists.Value (It).Id = Id then
+            Free (Constraint_Lists.Value (It).Code);
+            Remove (Set.Constraints, It);
+            Compact (Set);
+            return;
+         end if;
+         Next (It);
+      end loop;
+   end Remove;
+
+   ----------------
+   -- To_Boolean --
+   ----------------
+
+   function To_Boolean (V : Value) return Boolean is
+   begin
+      if V.Kind /= Boolean_Value then
+         raise Evaluation_Error;
+      end if;
+      return V.B;
+   end To_Boolean;
+
+   --------------
+   -- To_Value --
+   --------------
+
+   function To_Value (A : CORBA.Any) return Value is
+      use PolyORB.Any;
+
+      function Number (N : Long_Long_Float) return Value;
+      --  Return numeric value N
+
+      function Number (N : Long_Long_Float) return Value is
+      begin
+         return (Kind => Number_Value, N => N);
+      end Number;
+
+   begin
+      case TypeCode.Kind (Get_Unwound_Type (PolyORB.Any.Any (A))) is
+         when Tk_Boolean =>
+            return (Kind => Boolean_Value, B => CORBA.From_Any (A));
+
+         when Tk_Short =>
+            return Number (Long_Long_Float
+              (CORBA.Short'(CORBA.From_Any (A))));
+         when Tk_Long =>
+            return Number (Long_Long_Float
+              (CORBA.Long'(CORBA.From_Any (A))));
+         when Tk_Longlong =>
+            return Number (Long_Long_Float
+              (CORBA.Long_Long'(CORBA.From_Any (A))));
+         when Tk_Ushort =>
+            return Number (Long_Long_Float
+              (CORBA.Unsigned_Short'(CORBA.From_Any (A))));
+         when Tk_Ulong =>
+            return Number (Long_Long_Float
+              (CORBA.Unsigned_Long'(CORBA.From_Any (A))));
+         when Tk_Ulonglong =>
+            return Number (Long_Long_Float
+              (CORBA.Unsigned_Long_Long'(CORBA.From_Any (A))));
+         when Tk_Octet =>
+            return Number (Long_Long_Float
+              (CORBA.Octet'(CORBA.From_Any (A))));
+         when Tk_Float =>
+            return Number (Long_Long_Float
+              (CORBA.Float'(CORBA.From_Any (A))));
+         when Tk_Double =>
+            return Number (Long_Long_Float
+              (CORBA.Double'(CORBA.From_Any (A))));
+         when Tk_Longdouble =>
+            return Number (Long_Long_Float
+              (CORBA.Long_Double'(CORBA.From_Any (A))));
+
+         when Tk_Char =>
+            return (Kind => String_Value,
+                    S    => To_Unbounded_String
+                              ((1 => CORBA.Char'(CORBA.From_Any (A)))));
+         when Tk_String =>
+            return (Kind => String_Value,
+                    S    => Unbounded_String
+                              (CORBA.String'(CORBA.From_Any (A))));
+
+         when Tk_Any =>
+            return To_Value (CORBA.Any'(CORBA.From_Any (A)));
+
+         when others =>
+            return (Kind => Missing);
+      end case;
+   end To_Value;
+
+end CosNotifyFilter.Constraints;
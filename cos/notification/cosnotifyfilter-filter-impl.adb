@@ -34,6 +34,8 @@ with PolyORB.CORBA_P.Server_Tools;
 with PolyORB.Log;
 with PolyORB.Tasking.Mutexes;
 
+with CosNotifyFilter.Constraints;
+with CosNotifyFilter.Helper;
 with CosNotifyFilter.Filter.Skel;
 pragma Warnings (Off, CosNotifyFilter.Filter.Skel);
 
@@ -52,8 +54,69 @@ package body CosNotifyFilter.Filter.Impl is
 
    type Filter_Record is record
       This    : Object_Ptr;
+
+      Lock : Mutex_Access;
+      --  Protects the components below
+
+      Infos : ConstraintInfoSeq;
+      --  The constraints of the filter, as given by the client
+
+      Compiled : CosNotifyFilter.Constraints.Constraint_Set;
+      --  The constraints of the filter, compiled for matching
+
+      Next_Id : ConstraintID := 1;
+      --  Identifier of the next constraint added to the filter
    end record;
 
+   function Find (Self : access Object; Id : ConstraintID) return Natural;
+   --  Return the index of constraint Id in Self.X.Infos. Raise
+   --  ConstraintNotFound if there is no such constraint. Must be called
+   --  with Self.X.Lock held.
+
+   procedure Raise_Constraint_Not_Found (Id : ConstraintID);
+   pragma No_Return (Raise_Constraint_Not_Found);
+   --  Raise ConstraintNotFound for Id
+
+   procedure Raise_Invalid_Constraint (Exp : ConstraintExp);
+   pragma No_Return (Raise_Invalid_Constraint);
+   --  Raise InvalidConstraint for Exp
+
+   ----------
+   -- Find --
+   ----------
+
+   function Find (Self : access Object; Id : ConstraintID) return Natural is
+   begin
+      for J in 1 .. Length (Self.X.Infos) loop
+         if Get_Element (Self.X.Infos, J).constraint_id = Id then
+            return J;
+         end if;
+      end loop;
+
+      Leave (Self.X.Lock);
+      Raise_Constraint_Not_Found (Id);
+   end Find;
+
+   --------------------------------
+   -- Raise_Constraint_Not_Found --
+   --------------------------------
+
+   procedure Raise_Constraint_Not_Found (Id : ConstraintID) is
+   begin
+      CosNotifyFilter.Helper.Raise_ConstraintNotFound
+        ((CORBA.IDL_Exception_Members with id => Id));
+   end Raise_Constraint_Not_Found;
+
+   ------------------------------
+   -- Raise_Invalid_Constraint --
+   ------------------------------
+
+   procedure Raise_Invalid_Constraint (Exp : ConstraintExp) is
+   begin
+      CosNotifyFilter.Helper.Raise_InvalidConstraint
+        ((CORBA.IDL_Exception_Members with constr => Exp));
+   end Raise_Invalid_Constraint;
+
    ---------------------------
    -- Ensure_Initialization --
    ---------------------------
@@ -84,16 +147,11 @@ package body CosNotifyFilter.Filter.Impl is
       pragma Warnings (Off); --  WAG:3.14
       pragma Unreferenced (Self);
       pragma Warnings (On);  --  WAG:3.14
-      MyGrammar : CORBA.String;
    begin
       pragma Debug (O ("get_constraint_grammar in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
-
-      return MyGrammar;
+      return CORBA.To_CORBA_String
+        (CosNotifyFilter.Constraints.Default_Grammar);
    end Get_Constraint_Grammar;
 
    ---------------------
@@ -105,17 +163,42 @@ package body CosNotifyFilter.Filter.Impl is
       Constraint_List : CosNotifyFilter.ConstraintExpSeq)
      return CosNotifyFilter.ConstraintInfoSeq
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self, Constraint_List);
-      pragma Warnings (On);  --  WAG:3.14
       MySeq : CosNotifyFilter.ConstraintInfoSeq;
+      Exp   : ConstraintExp;
+      Info  : ConstraintInfo;
+
    begin
       pragma Debug (O ("add_constraints in filter"));
 
-      Ensure_Initialization;
+      Enter (Self.X.Lock);
 
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
+      for J in 1 .. Length (Constraint_List) loop
+         Exp := Get_Element (Constraint_List, J);
+         Info := (constraint_expression => Exp,
+                  constraint_id         => Self.X.Next_Id);
+
+         begin
+            CosNotifyFilter.Constraints.Add
+              (Self.X.Compiled, Info.constraint_id, Exp);
+         exception
+            when CosNotifyFilter.Constraints.Invalid_Constraint =>
+
+               --  Undo the additions of the previous constraints
+
+               for K in 1 .. Length (MySeq) loop
+                  CosNotifyFilter.Constraints.Remove
+                    (Self.X.Compiled, Get_Element (MySeq, K).constraint_id);
+               end loop;
+               Leave (Self.X.Lock);
+               Raise_Invalid_Constraint (Exp);
+         end;
+
+         Self.X.Next_Id := Self.X.Next_Id + 1;
+         Append (MySeq, Info);
+      end loop;
+
+      Append (Self.X.Infos, MySeq);
+      Leave (Self.X.Lock);
 
       return MySeq;
    end Add_Constraints;
@@ -129,16 +212,76 @@ package body CosNotifyFilter.Filter.Impl is
       Del_List    : CosNotifyFilter.ConstraintIDSeq;
       Modify_List : CosNotifyFilter.ConstraintInfoSeq)
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self, Del_List, Modify_List);
-      pragma Warnings (On);  --  WAG:3.14
+      Id    : ConstraintID;
+      Index : Natural;
+
    begin
       pragma Debug (O ("modify_constraints in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
+      --  Check all the arguments before changing anything
+
+      Enter (Self.X.Lock);
+
+      for J in 1 .. Length (Del_List) loop
+         Id := Get_Element (Del_List, J);
+         Index := Find (Self, Id);
+
+         --  A constraint listed twice would not be found anymore when it is
+         --  deleted the second time.
+
+         for K in 1 .. J - 1 loop
+            if Get_Element (Del_List, K) = Id then
+               Leave (Self.X.Lock);
+               Raise_Constraint_Not_Found (Id);
+            end if;
+         end loop;
+      end loop;
+
+      for J in 1 .. Length (Modify_List) loop
+         declare
+            Info : constant ConstraintInfo := Get_Element (Modify_List, J);
+         begin
+            Index := Find (Self, Info.constraint_id);
+
+            --  Likewise for a constraint that is both deleted and modified
+
+            for K in 1 .. Length (Del_List) loop
+               if Get_Element (Del_List, K) = Info.constraint_id then
+                  Leave (Self.X.Lock);
+                  Raise_Constraint_Not_Found (Info.constraint_id);
+               end if;
+            end loop;
+
+            CosNotifyFilter.Constraints.Check (Info.constraint_expression);
+         exception
+            when CosNotifyFilter.Constraints.Invalid_Constraint =>
+               Leave (Self.X.Lock);
+               Raise_Invalid_Constraint (Info.constraint_expression);
+         end;
+      end loop;
+
+      for J in 1 .. Length (Del_List) loop
+         Index := Find (Self, Get_Element (Del_List, J));
+         CosNotifyFilter.Constraints.Remove
+           (Self.X.Compiled, Get_Element (Del_List, J));
+         Delete (Self.X.Infos, Index, Index);
+      end loop;
+
+      for J in 1 .. Length (Modify_List) loop
+         declare
+            Info : constant ConstraintInfo := Get_Element (Modify_List, J);
+         begin
+            Index := Find (Self, Info.constraint_id);
+            CosNotifyFilter.Constraints.Remove
+              (Self.X.Compiled, Info.constraint_id);
+            CosNotifyFilter.Constraints.Add
+              (Self.X.Compiled, Info.constraint_id,
+               Info.constraint_expression);
+            Replace_Element (Self.X.Infos, Index, Info);
+         end;
+      end loop;
+
+      Leave (Self.X.Lock);
    end Modify_Constraints;
 
    ---------------------
@@ -150,17 +293,16 @@ package body CosNotifyFilter.Filter.Impl is
       Id_List : CosNotifyFilter.ConstraintIDSeq)
      return CosNotifyFilter.ConstraintInfoSeq
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self, Id_List);
-      pragma Warnings (On);  --  WAG:3.14
       MySeq : CosNotifyFilter.ConstraintInfoSeq;
    begin
       pragma Debug (O ("get_constraints in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
+      Enter (Self.X.Lock);
+      for J in 1 .. Length (Id_List) loop
+         Append (MySeq, Get_Element
+                   (Self.X.Infos, Find (Self, Get_Element (Id_List, J))));
+      end loop;
+      Leave (Self.X.Lock);
 
       return MySeq;
    end Get_Constraints;
@@ -173,17 +315,13 @@ package body CosNotifyFilter.Filter.Impl is
      (Self : access Object)
      return CosNotifyFilter.ConstraintInfoSeq
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self);
-      pragma Warnings (On);  --  WAG:3.14
       MySeq : CosNotifyFilter.ConstraintInfoSeq;
    begin
       pragma Debug (O ("get_all_constraints in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
+      Enter (Self.X.Lock);
+      MySeq := Self.X.Infos;
+      Leave (Self.X.Lock);
 
       return MySeq;
    end Get_All_Constraints;
@@ -195,17 +333,13 @@ package body CosNotifyFilter.Filter.Impl is
    procedure Remove_All_Constraints
      (Self : access Object)
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self);
-      pragma Warnings (On);  --  WAG:3.14
    begin
       pragma Debug (O ("remove_all_constraints in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
-
+      Enter (Self.X.Lock);
+      CosNotifyFilter.Constraints.Clear (Self.X.Compiled);
+      Self.X.Infos := Null_Sequence;
+      Leave (Self.X.Lock);
    end Remove_All_Constraints;
 
    -------------
@@ -215,17 +349,13 @@ package body CosNotifyFilter.Filter.Impl is
    procedure Destroy
      (Self : access Object)
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self);
-      pragma Warnings (On);  --  WAG:3.14
    begin
       pragma Debug (O ("destroy in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
-
+      Enter (Self.X.Lock);
+      CosNotifyFilter.Constraints.Clear (Self.X.Compiled);
+      Self.X.Infos := Null_Sequence;
+      Leave (Self.X.Lock);
    end Destroy;
 
    -----------
@@ -237,19 +367,20 @@ package body CosNotifyFilter.Filter.Impl is
       Filterable_Data : CORBA.Any)
      return CORBA.Boolean
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self, Filterable_Data);
-      pragma Warnings (On);  --  WAG:3.14
-      Res : constant CORBA.Boolean := True;
+      Res : CORBA.Boolean;
    begin
       pragma Debug (O ("match in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
-
-      raise Program_Error;
+      Enter (Self.X.Lock);
+      begin
+         Res := CosNotifyFilter.Constraints.Match
+           (Self.X.Compiled, Filterable_Data);
+      exception
+         when others =>
+            Leave (Self.X.Lock);
+            raise;
+      end;
+      Leave (Self.X.Lock);
 
       return Res;
    end Match;
@@ -263,19 +394,20 @@ package body CosNotifyFilter.Filter.Impl is
       Filterable_Data : CosNotification.StructuredEvent)
      return CORBA.Boolean
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self, Filterable_Data);
-      pragma Warnings (On);  --  WAG:3.14
-      Res : constant CORBA.Boolean := True;
+      Res : CORBA.Boolean;
    begin
       pragma Debug (O ("match_structured in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
-
-      raise Program_Error;
+      Enter (Self.X.Lock);
+      begin
+         Res := CosNotifyFilter.Constraints.Match_Structured
+           (Self.X.Compiled, Filterable_Data);
+      exception
+         when others =>
+            Leave (Self.X.Lock);
+            raise;
+      end;
+      Leave (Self.X.Lock);
 
       return Res;
    end Match_Structured;
@@ -289,19 +421,20 @@ package body CosNotifyFilter.Filter.Impl is
       Filterable_Data : CosNotification.PropertySeq)
      return CORBA.Boolean
    is
-      pragma Warnings (Off); --  WAG:3.14
-      pragma Unreferenced (Self, Filterable_Data);
-      pragma Warnings (On);  --  WAG:3.14
-      Res : constant CORBA.Boolean := True;
+      Res : CORBA.Boolean;
    begin
       pragma Debug (O ("match_typed in filter"));
 
-      Ensure_Initialization;
-
-      Enter (Self_Mutex);
-      Leave (Self_Mutex);
-
-      raise Program_Error;
+      Enter (Self.X.Lock);
+      begin
+         Res := CosNotifyFilter.Constraints.Match_Typed
+           (Self.X.Compiled, Filterable_Data);
+      exception
+         when others =>
+            Leave (Self.X.Lock);
+            raise;
+      end;
+      Leave (Self.X.Lock);
 
       return Res;
    end Match_Typed;
@@ -392,6 +525,8 @@ package body CosNotifyFilter.Filter.Impl is
       Filter         := new Object;
       Filter.X       := new Filter_Record;
       Filter.X.This  := Filter;
+      Create (Filter.X.Lock);
+      CosNotifyFilter.Constraints.Initialize (Filter.X.Compiled);
       Initiate_Servant (PortableServer.Servant (Filter), My_Ref);
 
       return Filter;
@@ -30,6 +30,8 @@
 --                                                                          --
 ------------------------------------------------------------------------------
 
+with Ada.Unchecked_Deallocation;
+
 with CORBA.Object;
 
 with PolyORB.Annotations;
@@ -77,20 +79,32 @@ package body PolyORB.CORBA_P.Interceptors is
 
    --  Client Interceptors
 
-   function "="
-     (Left, Right : PortableInterceptor.ClientRequestInterceptor.Local_Ref)
-      return Boolean;
+   type Client_Chain is array (Positive range <>)
+     of PortableInterceptor.ClientRequestInterceptor.Local_Ref;
 
-   package ClientRequestInterceptor_Lists is
-      new PolyORB.Utils.Chained_Lists
-           (PortableInterceptor.ClientRequestInterceptor.Local_Ref);
+   type Client_Chain_Access is access Client_Chain;
 
-   All_Client_Interceptors : ClientRequestInterceptor_Lists.List;
+   Client_Interceptors : Client_Chain_Access := new Client_Chain (1 .. 0);
+   --  Registered client request interceptors, in registration order. This
+   --  chain is replaced only while ORB initializers are run, before any
+   --  request is invoked.
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Client_Chain, Client_Chain_Access);
+
+   Default_Client_Invoke : Interceptors_Hooks.Client_Invoke_Handler;
+   --  Invocation handler used when no client interceptor is registered
 
    procedure Client_Invoke
      (Request : access PolyORB.Requests.Request;
       Flags   : PolyORB.Requests.Flags);
 
+   procedure Intercepted_Client_Invoke
+     (Request : access PolyORB.Requests.Request;
+      Flags   : PolyORB.Requests.Flags);
+   --  Invoke Request, calling the client interceptors at each interception
+   --  point.
+
    function Create_Client_Request_Info
      (Request    : PolyORB.Requests.Request_Access;
       Request_Id : CORBA.Unsigned_Long;
@@ -119,21 +133,34 @@ package body PolyORB.CORBA_P.Interceptors is
       Intermediate_Called : Boolean;
    end record;
 
-   function "="
-     (Left, Right : PortableInterceptor.ServerRequestInterceptor.Local_Ref)
-      return Boolean;
+   type Server_Chain is array (Positive range <>)
+     of PortableInterceptor.ServerRequestInterceptor.Local_Ref;
 
-   package ServerRequestInterceptor_Lists is
-      new PolyORB.Utils.Chained_Lists
-           (PortableInterceptor.ServerRequestInterceptor.Local_Ref);
+   type Server_Chain_Access is access Server_Chain;
+
+   Server_Interceptors : Server_Chain_Access := new Server_Chain (1 .. 0);
+   --  Registered server request interceptors, in registration order. This
+   --  chain is replaced only while ORB initializers are run, before any
+   --  request is received.
 
-   All_Server_Interceptors : ServerRequestInterceptor_Lists.List;
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Server_Chain, Server_Chain_Access);
+
+   Default_Server_Invoke : Interceptors_Hooks.Server_Invoke_Handler;
+   --  Invocation handler used when no server interceptor is registered
 
    procedure Server_Invoke
      (Servant : access PSPCE.Entity'Class;
       Request : access PolyORB.Requests.Request;
       Profile : PolyORB.Binding_Data.Profile_Access);
 
+   procedure Intercepted_Server_Invoke
+     (Servant : access PSPCE.Entity'Class;
+      Request : access PolyORB.Requests.Request;
+      Profile : PolyORB.Binding_Data.Profile_Access);
+   --  Invoke Request on Servant, calling the server interceptors at each
+   --  interception point.
+
    procedure Server_Intermediate
      (Request        : access PolyORB.Requests.Request;
       From_Arguments : Boolean);
@@ -205,18 +232,6 @@ package body PolyORB.CORBA_P.Interceptors is
    -- "=" --
    ---------
 
-   function "="
-     (Left, Right : PortableInterceptor.ClientRequestInterceptor.Local_Ref)
-      return Boolean
-   is
-   begin
-      return CORBA.Object.Is_Equivalent (CORBA.Object.Ref (Left), Right);
-   end "=";
-
-   ---------
-   -- "=" --
-   ---------
-
    function "=" (Left, Right : PortableInterceptor.IORInterceptor.Local_Ref)
      return Boolean
    is
@@ -236,18 +251,6 @@ package body PolyORB.CORBA_P.Interceptors is
       return CORBA.Object.Is_Equivalent (CORBA.Object.Ref (Left), Right);
    end "=";
 
-   ---------
-   -- "=" --
-   ---------
-
-   function "="
-     (Left, Right : PortableInterceptor.ServerRequestInterceptor.Local_Ref)
-      return Boolean
-   is
-   begin
-      return CORBA.Object.Is_Equivalent (CORBA.Object.Ref (Left), Right);
-   end "=";
-
    ------------------------------------
    -- Add_Client_Request_Interceptor --
    ------------------------------------
@@ -255,9 +258,11 @@ package body PolyORB.CORBA_P.Interceptors is
    procedure Add_Client_Request_Interceptor
      (Interceptor : PortableInterceptor.ClientRequestInterceptor.Local_Ref)
    is
+      Old_Chain : Client_Chain_Access := Client_Interceptors;
    begin
-      ClientRequestInterceptor_Lists.Append
-        (All_Client_Interceptors, Interceptor);
+      Client_Interceptors :=
+        new Client_Chain'(Old_Chain.all & Interceptor);
+      Free (Old_Chain);
    end Add_Client_Request_Interceptor;
 
    -------------------------
@@ -278,9 +283,11 @@ package body PolyORB.CORBA_P.Interceptors is
    procedure Add_Server_Request_Interceptor
      (Interceptor : PortableInterceptor.ServerRequestInterceptor.Local_Ref)
    is
+      Old_Chain : Server_Chain_Access := Server_Interceptors;
    begin
-      ServerRequestInterceptor_Lists.Append
-        (All_Server_Interceptors, Interceptor);
+      Server_Interceptors :=
+        new Server_Chain'(Old_Chain.all & Interceptor);
+      Free (Old_Chain);
    end Add_Server_Request_Interceptor;
 
    -------------------------
@@ -501,8 +508,76 @@ package body PolyORB.CORBA_P.Interceptors is
      (Request : access PolyORB.Requests.Request;
       Flags   : PolyORB.Requests.Flags)
    is
-      use ClientRequestInterceptor_Lists;
+   begin
+      --  Requests for which no interceptor is to be called are invoked as
+      --  if PortableInterceptor was not configured.
+
+      if Client_Interceptors'Length = 0 then
+         Default_Client_Invoke (Request, Flags);
+      else
+         Intercepted_Client_Invoke (Request, Flags);
+      end if;
+   end Client_Invoke;
 
+   --------------------------------
+   -- Create_Client_Request_Info --
+   --------------------------------
+
+   function Create_Client_Request_Info
+     (Request    : PolyORB.Requests.Request_Access;
+      Request_Id : CORBA.Unsigned_Long;
+      Point      : Client_Interception_Point;
+      Target     : CORBA.Object.Ref)
+      return PortableInterceptor.ClientRequestInfo.Local_Ref
+   is
+      Info_Ptr : constant PortableInterceptor.ClientRequestInfo.Impl.Object_Ptr
+         := new PortableInterceptor.ClientRequestInfo.Impl.Object;
+      Info_Ref : PortableInterceptor.ClientRequestInfo.Local_Ref;
+
+   begin
+      PortableInterceptor.ClientRequestInfo.Impl.Init
+       (Info_Ptr, Point, Request, Request_Id, Target);
+
+      PortableInterceptor.ClientRequestInfo.Set
+        (Info_Ref, PolyORB.Smart_Pointers.Entity_Ptr (Info_Ptr));
+
+      return Info_Ref;
+   end Create_Client_Request_Info;
+
+   --------------------------------
+   -- Create_Server_Request_Info --
+   --------------------------------
+
+   function Create_Server_Request_Info
+     (Servant      : PortableServer.Servant;
+      Request      : PolyORB.Requests.Request_Access;
+      Request_Id   : CORBA.Unsigned_Long;
+      Profile      : PolyORB.Binding_Data.Profile_Access;
+      Point        : Server_Interception_Point;
+      Args_Present : Boolean)
+      return PortableInterceptor.ServerRequestInfo.Local_Ref
+   is
+      Info_Ptr : constant PortableInterceptor.ServerRequestInfo.Impl.Object_Ptr
+         := new PortableInterceptor.ServerRequestInfo.Impl.Object;
+      Info_Ref : PortableInterceptor.ServerRequestInfo.Local_Ref;
+   begin
+      PortableInterceptor.ServerRequestInfo.Impl.Init
+       (Info_Ptr, Point, Servant, Request, Request_Id, Profile, Args_Present);
+
+      PortableInterceptor.ServerRequestInfo.Set
+        (Info_Ref, PolyORB.Smart_Pointers.Entity_Ptr (Info_Ptr));
+
+      return Info_Ref;
+   end Create_Server_Request_Info;
+
+   -------------------------------
+   -- Intercepted_Client_Invoke --
+   -------------------------------
+
+   procedure Intercepted_Client_Invoke
+     (Request : access PolyORB.Requests.Request;
+      Flags   : PolyORB.Requests.Flags)
+   is
       procedure Call_Send_Request is
          new Call_Client_Request_Interceptor_Operation
               (PortableInterceptor.ClientRequestInterceptor.send_request);
@@ -519,6 +594,8 @@ package body PolyORB.CORBA_P.Interceptors is
          new Call_Client_Request_Interceptor_Operation
               (PortableInterceptor.ClientRequestInterceptor.receive_other);
 
+      Chain   : Client_Chain renames Client_Interceptors.all;
+
       Req_Id  : constant CORBA.Unsigned_Long := Allocate_Request_Id;
 
       Target  : constant CORBA.Object.Ref :=
@@ -526,6 +603,37 @@ package body PolyORB.CORBA_P.Interceptors is
       TSC     : Slots_Note;
       Index   : Natural;
 
+      Info       : PortableInterceptor.ClientRequestInfo.Local_Ref;
+      Info_Point : Client_Interception_Point;
+
+      function Info_At
+        (Point : Client_Interception_Point)
+         return PortableInterceptor.ClientRequestInfo.Local_Ref;
+      --  Return the request information passed to interceptors at Point.
+      --  It is created on first use, and shared by all the interceptors
+      --  called in turn at the same interception point.
+
+      -------------
+      -- Info_At --
+      -------------
+
+      function Info_At
+        (Point : Client_Interception_Point)
+         return PortableInterceptor.ClientRequestInfo.Local_Ref
+      is
+      begin
+         if PortableInterceptor.ClientRequestInfo.Is_Null (Info)
+           or else Info_Point /= Point
+         then
+            Info :=
+              Create_Client_Request_Info
+                (Request.all'Unchecked_Access, Req_Id, Point, Target);
+            Info_Point := Point;
+         end if;
+
+         return Info;
+      end Info_At;
+
    begin
       --  Getting thread scope slots information (allocating thread scope
       --  slots if it is not allocated), and make "logical copy" and place it
@@ -542,15 +650,14 @@ package body PolyORB.CORBA_P.Interceptors is
 
          Rebuild_Request_Service_Contexts (Request.all);
 
-         Index := Length (All_Client_Interceptors);
+         Index := Chain'Length;
 
          --  Call Send_Request on all interceptors.
 
-         for J in 0 .. Index - 1 loop
+         for J in Chain'Range loop
             Call_Send_Request
-              (Element (All_Client_Interceptors, J).all,
-               Create_Client_Request_Info
-                 (Request.all'Unchecked_Access, Req_Id, Send_Request, Target),
+              (Chain (J),
+               Info_At (Send_Request),
                True,
                Request.Exception_Info);
 
@@ -558,7 +665,7 @@ package body PolyORB.CORBA_P.Interceptors is
             --  Send_Request on other Interceptors.
 
             if not PolyORB.Any.Is_Empty (Request.Exception_Info) then
-               Index := J;
+               Index := J - 1;
                exit;
             end if;
          end loop;
@@ -568,7 +675,7 @@ package body PolyORB.CORBA_P.Interceptors is
          --  Avoid operation invocation if interceptor raise system
          --  exception.
 
-         if Index = Length (All_Client_Interceptors) then
+         if Index = Chain'Length then
             PolyORB.Requests.Invoke (Request, Flags);
 
             --  Restore request scope slots, because it may be changed
@@ -580,7 +687,7 @@ package body PolyORB.CORBA_P.Interceptors is
          Rebuild_Request_Service_Contexts (Request.all);
          Rebuild_Reply_Service_Contexts (Request.all);
 
-         for J in reverse 0 .. Index - 1 loop
+         for J in reverse 1 .. Index loop
             if not PolyORB.Any.Is_Empty (Request.Exception_Info) then
                if PolyORB.Any.Get_Type (Request.Exception_Info)
                     = PolyORB.Errors.Helper.TC_ForwardRequest
@@ -588,23 +695,15 @@ package body PolyORB.CORBA_P.Interceptors is
                     = PolyORB.Errors.Helper.TC_NeedsAddressingMode
                then
                   Call_Receive_Other
-                    (Element (All_Client_Interceptors, J).all,
-                     Create_Client_Request_Info
-                       (Request.all'Unchecked_Access,
-                        Req_Id,
-                        Receive_Other,
-                        Target),
+                    (Chain (J),
+                     Info_At (Receive_Other),
                      True,
                      Request.Exception_Info);
 
                else
                   Call_Receive_Exception
-                    (Element (All_Client_Interceptors, J).all,
-                     Create_Client_Request_Info
-                       (Request.all'Unchecked_Access,
-                        Req_Id,
-                        Receive_Exception,
-                        Target),
+                    (Chain (J),
+                     Info_At (Receive_Exception),
                      True,
                      Request.Exception_Info);
                end if;
@@ -616,22 +715,14 @@ package body PolyORB.CORBA_P.Interceptors is
                   --  A reply is expected
 
                   Call_Receive_Reply
-                    (Element (All_Client_Interceptors, J).all,
-                     Create_Client_Request_Info
-                       (Request.all'Unchecked_Access,
-                        Req_Id,
-                        Receive_Reply,
-                        Target),
+                    (Chain (J),
+                     Info_At (Receive_Reply),
                      False,
                      Request.Exception_Info);
                else
                   Call_Receive_Other
-                    (Element (All_Client_Interceptors, J).all,
-                     Create_Client_Request_Info
-                       (Request.all'Unchecked_Access,
-                        Req_Id,
-                        Receive_Other,
-                        Target),
+                    (Chain (J),
+                     Info_At (Receive_Other),
                      True,
                      Request.Exception_Info);
                end if;
@@ -695,58 +786,188 @@ package body PolyORB.CORBA_P.Interceptors is
       --  Restoring thread scope slots.
 
       Set_Note (Get_Current_Thread_Notepad.all, TSC);
-   end Client_Invoke;
+   end Intercepted_Client_Invoke;
 
-   --------------------------------
-   -- Create_Client_Request_Info --
-   --------------------------------
+   -------------------------------
+   -- Intercepted_Server_Invoke --
+   -------------------------------
 
-   function Create_Client_Request_Info
-     (Request    : PolyORB.Requests.Request_Access;
-      Request_Id : CORBA.Unsigned_Long;
-      Point      : Client_Interception_Point;
-      Target     : CORBA.Object.Ref)
-      return PortableInterceptor.ClientRequestInfo.Local_Ref
+   procedure Intercepted_Server_Invoke
+     (Servant : access PSPCE.Entity'Class;
+      Request : access PolyORB.Requests.Request;
+      Profile : PolyORB.Binding_Data.Profile_Access)
    is
-      Info_Ptr : constant PortableInterceptor.ClientRequestInfo.Impl.Object_Ptr
-         := new PortableInterceptor.ClientRequestInfo.Impl.Object;
-      Info_Ref : PortableInterceptor.ClientRequestInfo.Local_Ref;
+      package PISRI renames PortableInterceptor.ServerRequestInterceptor;
 
-   begin
-      PortableInterceptor.ClientRequestInfo.Impl.Init
-       (Info_Ptr, Point, Request, Request_Id, Target);
+      procedure Call_Receive_Request_Service_Contexts is
+         new Call_Server_Request_Interceptor_Operation
+              (PISRI.receive_request_service_contexts);
 
-      PortableInterceptor.ClientRequestInfo.Set
-        (Info_Ref, PolyORB.Smart_Pointers.Entity_Ptr (Info_Ptr));
+      procedure Call_Send_Reply is
+         new Call_Server_Request_Interceptor_Operation (PISRI.send_reply);
 
-      return Info_Ref;
-   end Create_Client_Request_Info;
+      procedure Call_Send_Exception is
+         new Call_Server_Request_Interceptor_Operation (PISRI.send_exception);
 
-   --------------------------------
-   -- Create_Server_Request_Info --
-   --------------------------------
+      procedure Call_Send_Other is
+         new Call_Server_Request_Interceptor_Operation (PISRI.send_other);
+
+      Chain           : Server_Chain renames Server_Interceptors.all;
+      RSC             : Slots_Note;
+      Empty_Any       : PolyORB.Any.Any;
+      Skip_Invocation : Boolean := False;
+      Note            : Server_Interceptor_Note
+        := (PolyORB.Annotations.Note with
+              Servant             => PortableServer.Servant (Servant),
+              Profile             => Profile,
+              Request_Id          => Allocate_Request_Id,
+              Last_Interceptor    => Chain'Length,
+              Exception_Info      => Empty_Any,
+              Intermediate_Called => False);
+
+      Info       : PortableInterceptor.ServerRequestInfo.Local_Ref;
+      Info_Point : Server_Interception_Point;
+
+      function Info_At
+        (Point        : Server_Interception_Point;
+         Args_Present : Boolean)
+         return PortableInterceptor.ServerRequestInfo.Local_Ref;
+      --  Return the request information passed to interceptors at Point.
+      --  It is created on first use, and shared by all the interceptors
+      --  called in turn at the same interception point.
+
+      -------------
+      -- Info_At --
+      -------------
+
+      function Info_At
+        (Point        : Server_Interception_Point;
+         Args_Present : Boolean)
+         return PortableInterceptor.ServerRequestInfo.Local_Ref
+      is
+      begin
+         if PortableInterceptor.ServerRequestInfo.Is_Null (Info)
+           or else Info_Point /= Point
+         then
+            Info :=
+              Create_Server_Request_Info
+                (null,
+                 Request.all'Unchecked_Access,
+                 Note.Request_Id,
+                 Profile,
+                 Point,
+                 Args_Present);
+            Info_Point := Point;
+         end if;
+
+         return Info;
+      end Info_At;
 
-   function Create_Server_Request_Info
-     (Servant      : PortableServer.Servant;
-      Request      : PolyORB.Requests.Request_Access;
-      Request_Id   : CORBA.Unsigned_Long;
-      Profile      : PolyORB.Binding_Data.Profile_Access;
-      Point        : Server_Interception_Point;
-      Args_Present : Boolean)
-      return PortableInterceptor.ServerRequestInfo.Local_Ref
-   is
-      Info_Ptr : constant PortableInterceptor.ServerRequestInfo.Impl.Object_Ptr
-         := new PortableInterceptor.ServerRequestInfo.Impl.Object;
-      Info_Ref : PortableInterceptor.ServerRequestInfo.Local_Ref;
    begin
-      PortableInterceptor.ServerRequestInfo.Impl.Init
-       (Info_Ptr, Point, Servant, Request, Request_Id, Profile, Args_Present);
+      --  Allocating thread request scope slots. Storing it in the request.
 
-      PortableInterceptor.ServerRequestInfo.Set
-        (Info_Ref, PolyORB.Smart_Pointers.Entity_Ptr (Info_Ptr));
+      Allocate_Slots (RSC);
+      Set_Note (Request.Notepad, RSC);
 
-      return Info_Ref;
-   end Create_Server_Request_Info;
+      Rebuild_Request_Service_Contexts (Request.all);
+
+      for J in Chain'Range loop
+         Call_Receive_Request_Service_Contexts
+           (Chain (J),
+            Info_At (Receive_Request_Service_Contexts, False),
+            True,
+            Request.Exception_Info);
+
+         --  If got system or ForwardRequest exception then avoid call
+         --  Receive_Request_Service_Contexts on other Interceptors.
+
+         if not PolyORB.Any.Is_Empty (Request.Exception_Info) then
+            Note.Last_Interceptor  := J - 1;
+            Skip_Invocation        := True;
+            exit;
+         end if;
+      end loop;
+
+      Rebuild_Reply_QoS_Parameters (Request.all);
+
+      --  Copy ing request scope slots to thread scope slots
+
+      Get_Note (Request.Notepad, RSC);
+      Set_Note (Get_Current_Thread_Notepad.all, RSC);
+
+      --  Saving in request information for calling intermediate
+      --  interception point.
+
+      Set_Note (Request.Notepad, Note);
+
+      if not Skip_Invocation then
+         PortableServer.Invoke
+           (PortableServer.DynamicImplementation'Class (Servant.all)'Access,
+            Request.all'Unchecked_Access);
+         --  Redispatch
+      end if;
+
+      Get_Note (Request.Notepad, Note);
+
+      if not PolyORB.Any.Is_Empty (Note.Exception_Info) then
+         --  If a system exception or ForwardRequest exception will be
+         --  raised in Receive_Request interception point then replace
+         --  Request exception information, because it may be replaced
+         --  in skeleton.
+
+         Request.Exception_Info := Note.Exception_Info;
+      end if;
+
+      --  Retrieve thread scope slots and copy it back to request
+      --  scope slots.
+
+      Get_Note (Get_Current_Thread_Notepad.all, RSC);
+      Set_Note (Request.Notepad, RSC);
+
+      for J in reverse 1 .. Note.Last_Interceptor loop
+         if not PolyORB.Any.Is_Empty (Request.Exception_Info) then
+            if PolyORB.Any.Get_Type (Request.Exception_Info)
+                 = PolyORB.Errors.Helper.TC_ForwardRequest
+              or else PolyORB.Any.Get_Type (Request.Exception_Info)
+                 = PolyORB.Errors.Helper.TC_NeedsAddressingMode
+            then
+               Call_Send_Other
+                 (Chain (J),
+                  Info_At (Send_Other, True),
+                  True,
+                  Request.Exception_Info);
+
+            else
+               Call_Send_Exception
+                 (Chain (J),
+                  Info_At (Send_Exception, True),
+                  True,
+                  Request.Exception_Info);
+            end if;
+
+         else
+            if Is_Set (Requests.Sync_With_Server, Request.Req_Flags)
+              or else Is_Set (Requests.Sync_With_Target, Request.Req_Flags)
+            then
+               --  A reply is expected
+
+               Call_Send_Reply
+                 (Chain (J),
+                  Info_At (Send_Reply, True),
+                  False,
+                  Request.Exception_Info);
+            else
+               Call_Send_Other
+                 (Chain (J),
+                  Info_At (Send_Other, True),
+                  True,
+                  Request.Exception_Info);
+            end if;
+         end if;
+      end loop;
+
+      Rebuild_Reply_QoS_Parameters (Request.all);
+   end Intercepted_Server_Invoke;
 
    ------------------------------------------
    -- Is_Client_Request_Interceptor_Exists --
@@ -756,23 +977,19 @@ package body PolyORB.CORBA_P.Interceptors is
      (Name : String)
       return Boolean
    is
-      Iter : ClientRequestInterceptor_Lists.Iterator
-         := ClientRequestInterceptor_Lists.First (All_Client_Interceptors);
    begin
       if Name = "" then
          return False;
       end if;
 
-      while not ClientRequestInterceptor_Lists.Last (Iter) loop
+      for J in Client_Interceptors'Range loop
          if CORBA.To_Standard_String
               (PortableInterceptor.ClientRequestInterceptor.get_name
-                (ClientRequestInterceptor_Lists.Value (Iter).all))
+                (Client_Interceptors (J)))
              = Name
          then
             return True;
          end if;
-
-         ClientRequestInterceptor_Lists.Next (Iter);
       end loop;
 
       return False;
@@ -816,23 +1033,19 @@ package body PolyORB.CORBA_P.Interceptors is
      (Name : String)
       return Boolean
    is
-      Iter : ServerRequestInterceptor_Lists.Iterator
-         := ServerRequestInterceptor_Lists.First (All_Server_Interceptors);
    begin
       if Name = "" then
          return False;
       end if;
 
-      while not ServerRequestInterceptor_Lists.Last (Iter) loop
+      for J in Server_Interceptors'Range loop
          if CORBA.To_Standard_String
               (PortableInterceptor.ServerRequestInterceptor.get_name
-                (ServerRequestInterceptor_Lists.Value (Iter).all))
+                (Server_Interceptors (J)))
              = Name
          then
             return True;
          end if;
-
-         ServerRequestInterceptor_Lists.Next (Iter);
       end loop;
 
       return False;
@@ -922,35 +1135,39 @@ package body PolyORB.CORBA_P.Interceptors is
      (Request        : access PolyORB.Requests.Request;
       From_Arguments : Boolean)
    is
-      use ServerRequestInterceptor_Lists;
-
       procedure Call_Receive_Request is
          new Call_Server_Request_Interceptor_Operation
               (PortableInterceptor.ServerRequestInterceptor.receive_request);
 
+      Chain            : Server_Chain renames Server_Interceptors.all;
       Note             : Server_Interceptor_Note;
+      Info             : PortableInterceptor.ServerRequestInfo.Local_Ref;
       Break_Invocation : Boolean := False;
 
-      It : Iterator := First (All_Server_Interceptors);
-
    begin
+      --  Nothing to do if Server_Invoke called no interceptor
+
+      if Chain'Length = 0 then
+         return;
+      end if;
+
       PolyORB.Annotations.Get_Note (Request.Notepad, Note);
 
       if not Note.Intermediate_Called then
          Note.Intermediate_Called := True;
 
-         while not Last (It) loop
+         Info :=
+           Create_Server_Request_Info
+             (Note.Servant,
+              Request.all'Unchecked_Access,
+              Note.Request_Id,
+              Note.Profile,
+              Receive_Request,
+              From_Arguments);
+
+         for J in Chain'Range loop
             Call_Receive_Request
-              (Value (It).all,
-               Create_Server_Request_Info
-                 (Note.Servant,
-                  Request.all'Unchecked_Access,
-                  Note.Request_Id,
-                  Note.Profile,
-                  Receive_Request,
-                  From_Arguments),
-               True,
-               Note.Exception_Info);
+              (Chain (J), Info, True, Note.Exception_Info);
 
             if not PolyORB.Any.Is_Empty (Note.Exception_Info) then
                --  Exception information can't be saved in Request,
@@ -960,7 +1177,6 @@ package body PolyORB.CORBA_P.Interceptors is
                Break_Invocation := True;
                exit;
             end if;
-            Next (It);
          end loop;
       end if;
 
@@ -984,168 +1200,21 @@ package body PolyORB.CORBA_P.Interceptors is
       Request : access PolyORB.Requests.Request;
       Profile : PolyORB.Binding_Data.Profile_Access)
    is
-      use ServerRequestInterceptor_Lists;
-
-      package PISRI renames PortableInterceptor.ServerRequestInterceptor;
-
-      procedure Call_Receive_Request_Service_Contexts is
-         new Call_Server_Request_Interceptor_Operation
-              (PISRI.receive_request_service_contexts);
-
-      procedure Call_Send_Reply is
-         new Call_Server_Request_Interceptor_Operation (PISRI.send_reply);
-
-      procedure Call_Send_Exception is
-         new Call_Server_Request_Interceptor_Operation (PISRI.send_exception);
-
-      procedure Call_Send_Other is
-         new Call_Server_Request_Interceptor_Operation (PISRI.send_other);
-
-      RSC             : Slots_Note;
-      Empty_Any       : PolyORB.Any.Any;
-      Skip_Invocation : Boolean := False;
-      Note            : Server_Interceptor_Note
-        := (PolyORB.Annotations.Note with
-              Servant             => PortableServer.Servant (Servant),
-              Profile             => Profile,
-              Request_Id          => Allocate_Request_Id,
-              Last_Interceptor    => Length (All_Server_Interceptors),
-              Exception_Info      => Empty_Any,
-              Intermediate_Called => False);
    begin
-      --  Allocating thread request scope slots. Storing it in the request.
-
-      Allocate_Slots (RSC);
-      Set_Note (Request.Notepad, RSC);
-
-      Rebuild_Request_Service_Contexts (Request.all);
-
-      for J in 0 .. Note.Last_Interceptor - 1 loop
-         Call_Receive_Request_Service_Contexts
-           (Element (All_Server_Interceptors, J).all,
-            Create_Server_Request_Info
-              (null,
-               Request.all'Unchecked_Access,
-               Note.Request_Id,
-               Profile,
-               Receive_Request_Service_Contexts,
-               False),
-            True,
-            Request.Exception_Info);
-
-         --  If got system or ForwardRequest exception then avoid call
-         --  Receive_Request_Service_Contexts on other Interceptors.
-
-         if not PolyORB.Any.Is_Empty (Request.Exception_Info) then
-            Note.Last_Interceptor  := J;
-            Skip_Invocation        := True;
-            exit;
+      --  Requests for which no interceptor is to be called are invoked as
+      --  if PortableInterceptor was not configured. The servant still gets
+      --  empty thread scope slots, as the request scope slots it would
+      --  otherwise inherit are empty.
+
+      if Server_Interceptors'Length = 0 then
+         if Has_Slots then
+            Set_Note (Get_Current_Thread_Notepad.all, Invalid_Slots_Note);
          end if;
-      end loop;
-
-      Rebuild_Reply_QoS_Parameters (Request.all);
-
-      --  Copy ing request scope slots to thread scope slots
-
-      Get_Note (Request.Notepad, RSC);
-      Set_Note (Get_Current_Thread_Notepad.all, RSC);
-
-      --  Saving in request information for calling intermediate
-      --  interception point.
-
-      Set_Note (Request.Notepad, Note);
-
-      if not Skip_Invocation then
-         PortableServer.Invoke
-           (PortableServer.DynamicImplementation'Class (Servant.all)'Access,
-            Request.all'Unchecked_Access);
-         --  Redispatch
-      end if;
-
-      Get_Note (Request.Notepad, Note);
-
-      if not PolyORB.Any.Is_Empty (Note.Exception_Info) then
-         --  If a system exception or ForwardRequest exception will be
-         --  raised in Receive_Request interception point then replace
-         --  Request exception information, because it may be replaced
-         --  in skeleton.
 
-         Request.Exception_Info := Note.Exception_Info;
+         Default_Server_Invoke (Servant, Request, Profile);
+      else
+         Intercepted_Server_Invoke (Servant, Request, Profile);
       end if;
-
-      --  Retrieve thread scope slots and copy it back to request
-      --  scope slots.
-
-      Get_Note (Get_Current_Thread_Notepad.all, RSC);
-      Set_Note (Request.Notepad, RSC);
-
-      for J in reverse 0 .. Note.Last_Interceptor - 1 loop
-         if not PolyORB.Any.Is_Empty (Request.Exception_Info) then
-            if PolyORB.Any.Get_Type (Request.Exception_Info)
-                 = PolyORB.Errors.Helper.TC_ForwardRequest
-              or else PolyORB.Any.Get_Type (Request.Exception_Info)
-                 = PolyORB.Errors.Helper.TC_NeedsAddressingMode
-            then
-               Call_Send_Other
-                 (Element (All_Server_Interceptors, J).all,
-                  Create_Server_Request_Info
-                    (null,
-                     Request.all'Unchecked_Access,
-                     Note.Request_Id,
-                     Profile,
-                     Send_Other,
-                     True),
-                  True,
-                  Request.Exception_Info);
-
-            else
-               Call_Send_Exception
-                 (Element (All_Server_Interceptors, J).all,
-                  Create_Server_Request_Info
-                    (null,
-                     Request.all'Unchecked_Access,
-                     Note.Request_Id,
-                     Profile,
-                     Send_Exception,
-                     True),
-                  True,
-                  Request.Exception_Info);
-            end if;
-
-         else
-            if Is_Set (Requests.Sync_With_Server, Request.Req_Flags)
-              or else Is_Set (Requests.Sync_With_Target, Request.Req_Flags)
-            then
-               --  A reply is expected
-
-               Call_Send_Reply
-                 (Element (All_Server_Interceptors, J).all,
-                  Create_Server_Request_Info
-                    (null,
-                     Request.all'Unchecked_Access,
-                     Note.Request_Id,
-                     Profile,
-                     Send_Reply,
-                     True),
-                  False,
-                  Request.Exception_Info);
-            else
-               Call_Send_Other
-                 (Element (All_Server_Interceptors, J).all,
-                  Create_Server_Request_Info
-                    (null,
-                     Request.all'Unchecked_Access,
-                     Note.Request_Id,
-                     Profile,
-                     Send_Other,
-                     True),
-                  True,
-                  Request.Exception_Info);
-            end if;
-         end if;
-      end loop;
-
-      Rebuild_Reply_QoS_Parameters (Request.all);
    end Server_Invoke;
 
    -------------------------------------------
@@ -1173,6 +1242,12 @@ package body PolyORB.CORBA_P.Interceptors is
 
    procedure Initialize is
    begin
+      --  Keep the default handlers, set up by the CORBA.Request and
+      --  PortableServer modules, for requests that no interceptor sees.
+
+      Default_Client_Invoke := Interceptors_Hooks.Client_Invoke;
+      Default_Server_Invoke := Interceptors_Hooks.Server_Invoke;
+
       PolyORB.CORBA_P.Interceptors_Hooks.Client_Invoke := Client_Invoke'Access;
       PolyORB.CORBA_P.Interceptors_Hooks.Server_Invoke := Server_Invoke'Access;
       PolyORB.CORBA_P.Interceptors_Hooks.Server_Intermediate :=
@@ -58,16 +58,9 @@ package body PolyORB.CORBA_P.Interceptors_Slots is
    --------------------
 
    procedure Allocate_Slots (Note : in out Slots_Note) is
-      Empty : constant CORBA.Any :=
-        CORBA.Internals.Get_Empty_Any (CORBA.TC_Null);
-
    begin
       Note.Slots := Null_Sequence;
-
-      for J in 1 .. Last_Allocated_Slot_Id loop
-         Append (Note.Slots, Empty);
-      end loop;
-
+      Note.Count := Last_Allocated_Slot_Id;
       Note.Allocated := True;
    end Allocate_Slots;
 
@@ -83,20 +76,34 @@ package body PolyORB.CORBA_P.Interceptors_Slots is
    begin
       pragma Assert (Note.Allocated);
 
-      if Id not in 1 .. SlotId (Length (Note.Slots)) then
+      if Id not in 1 .. Note.Count then
          Raise_InvalidSlot ((null record));
       end if;
 
+      if Integer (Id) > Length (Note.Slots) then
+         return CORBA.Internals.Get_Empty_Any (CORBA.TC_Null);
+      end if;
+
       return Get_Element (Note.Slots, Integer (Id));
    end Get_Slot;
 
+   ---------------
+   -- Has_Slots --
+   ---------------
+
+   function Has_Slots return Boolean is
+   begin
+      return Last_Allocated_Slot_Id > 0;
+   end Has_Slots;
+
    ------------------------
    -- Invalid_Slots_Note --
    ------------------------
 
    function Invalid_Slots_Note return Slots_Note is
       Aux : constant Slots_Note
-        := (PolyORB.Annotations.Note with False, Any_Sequences.Null_Sequence);
+        := (PolyORB.Annotations.Note with
+              False, 0, Any_Sequences.Null_Sequence);
    begin
       return Aux;
    end Invalid_Slots_Note;
@@ -122,11 +129,26 @@ package body PolyORB.CORBA_P.Interceptors_Slots is
    begin
       pragma Assert (Note.Allocated);
 
-      if Id not in 1 .. SlotId (Length (Note.Slots)) then
+      if Id not in 1 .. Note.Count then
          Raise_InvalidSlot ((null record));
       end if;
 
-      Replace_Element (Note.Slots, Integer (Id), Data);
+      --  Materialize the slots up to Id on first write
+
+      if Integer (Id) > Length (Note.Slots) then
+         declare
+            Empty : constant CORBA.Any :=
+              CORBA.Internals.Get_Empty_Any (CORBA.TC_Null);
+         begin
+            for J in Length (Note.Slots) + 1 .. Integer (Id) - 1 loop
+               Append (Note.Slots, Empty);
+            end loop;
+         end;
+         Append (Note.Slots, Data);
+
+      else
+         Replace_Element (Note.Slots, Integer (Id), Data);
+      end if;
    end Set_Slot;
 
 end PolyORB.CORBA_P.Interceptors_Slots;
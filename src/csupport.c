@@ -6,7 +6,7 @@
  *                                                                          *
  *                       C   s u p p o r t   f i l e                        *
  *                                                                          *
- *         Copyright (C) 2008-2022, Free Software Foundation, Inc.          *
+ *         Copyright (C) 2008-2026, Free Software Foundation, Inc.          *
  *                                                                          *
  * PolyORB is free software; you  can  redistribute  it and/or modify it    *
  * under terms of the  GNU General Public License as published by the  Free *
@@ -28,6 +28,11 @@
 
 #include "config.h"
 
+#if (defined (HAVE_RECVMMSG) || defined (HAVE_SENDMMSG)) \
+  && !defined (_GNU_SOURCE)
+# define _GNU_SOURCE 1
+#endif
+
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -40,6 +45,43 @@
 # include <time.h>
 #endif
 
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined (__GNUC__) && __GNUC__ >= 5 \
+  && (defined (__x86_64__) || defined (__i386__))
+# define POLYORB_HAVE_SIMD_BSWAP 1
+# include <immintrin.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
+#if defined (HAVE_LINUX_FUTEX_H) && defined (HAVE_SYS_SYSCALL_H)
+# define POLYORB_HAVE_FUTEX 1
+# include <linux/futex.h>
+# include <sys/syscall.h>
+#elif defined (HAVE_SCHED_YIELD)
+# include <sched.h>
+#endif
+
+#if defined (HAVE_RECVMMSG) || defined (HAVE_SENDMMSG)
+# include <sys/types.h>
+# include <sys/socket.h>
+# include <netinet/in.h>
+# include <arpa/inet.h>
+#endif
+
+#if defined (HAVE_SYS_EPOLL_H) && defined (HAVE_SYS_EVENTFD_H)
+# define POLYORB_HAVE_EPOLL 1
+# include <sys/epoll.h>
+# include <sys/eventfd.h>
+# include <stdint.h>
+#endif
+
 void
 __PolyORB_detach(void) {
 #ifdef HAVE_SETSID
@@ -62,3 +104,498 @@ __PolyORB_timestamp (char *buf, int bufsize) {
    strftime (buf, bufsize, "%Y-%m-%d %T ", tm);
 #endif
 }
+
+/*
+ * epoll(7) support for PolyORB.Asynch_Ev.Sockets.Epoll
+ *
+ * Sources are registered with EPOLLONESHOT: once an event has been reported
+ * for a descriptor, it is disarmed until it is explicitly rearmed, which
+ * matches the Check_Sources contract (sources with events are removed from
+ * the monitor). The opaque data pointer associated with each descriptor is
+ * returned by __PolyORB_epoll_wait; a null pointer denotes the abort
+ * descriptor.
+ */
+
+int
+__PolyORB_epoll_create (void) {
+#ifdef POLYORB_HAVE_EPOLL
+   return epoll_create1 (EPOLL_CLOEXEC);
+#else
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+int
+__PolyORB_epoll_arm (int epfd, int fd, void *data) {
+#ifdef POLYORB_HAVE_EPOLL
+   struct epoll_event ev;
+
+   ev.events = EPOLLIN | EPOLLONESHOT;
+   ev.data.ptr = data;
+
+   /* Rearm a descriptor that is already known to the kernel (the common
+      case once a connection has been established), else add it. */
+
+   if (epoll_ctl (epfd, EPOLL_CTL_MOD, fd, &ev) == 0)
+      return 0;
+   if (errno != ENOENT)
+      return -1;
+   return epoll_ctl (epfd, EPOLL_CTL_ADD, fd, &ev);
+#else
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+int
+__PolyORB_epoll_disarm (int epfd, int fd) {
+#ifdef POLYORB_HAVE_EPOLL
+   struct epoll_event ev;
+
+   /* A non-null event argument is required by kernels before 2.6.9 */
+
+   if (epoll_ctl (epfd, EPOLL_CTL_DEL, fd, &ev) == 0 || errno == ENOENT)
+      return 0;
+   return -1;
+#else
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+int
+__PolyORB_epoll_wait (int epfd, void **ready, int max_ready, int timeout) {
+#ifdef POLYORB_HAVE_EPOLL
+   struct epoll_event events[64];
+   int n, j;
+
+   if (max_ready > 64)
+      max_ready = 64;
+
+   do {
+      n = epoll_wait (epfd, events, max_ready, timeout);
+   } while (n < 0 && errno == EINTR);
+
+   for (j = 0; j < n; j++)
+      ready[j] = events[j].data.ptr;
+   return n;
+#else
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+int
+__PolyORB_eventfd_create (void) {
+#ifdef POLYORB_HAVE_EPOLL
+   return eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+#else
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+void
+__PolyORB_eventfd_signal (int fd) {
+#ifdef POLYORB_HAVE_EPOLL
+   uint64_t one = 1;
+   (void) write (fd, &one, sizeof one);
+#endif
+}
+
+void
+__PolyORB_eventfd_clear (int fd) {
+#ifdef POLYORB_HAVE_EPOLL
+   uint64_t count;
+   (void) read (fd, &count, sizeof count);
+#endif
+}
+
+/*
+ * Byte swapping of arrays of 2, 4 or 8 byte elements, used by the CDR
+ * fast path when the buffer endianness is not the host's. On x86, SSSE3
+ * or AVX2 shuffle kernels are selected at run time according to the CPU;
+ * they process 16 or 32 bytes at a time, and the remaining elements are
+ * handled by the scalar loop. Target may be equal to source (in-place
+ * swap), but the two areas must not otherwise overlap.
+ */
+
+static void
+bswap_scalar (unsigned char *dst, const unsigned char *src,
+              size_t length, int size)
+{
+   unsigned char tmp[8];
+   size_t j;
+   int k;
+
+   for (j = 0; j < length; j += size) {
+      for (k = 0; k < size; k++)
+         tmp[k] = src[j + size - 1 - k];
+      memcpy (dst + j, tmp, size);
+   }
+}
+
+#ifdef POLYORB_HAVE_SIMD_BSWAP
+
+/* Return the number of bytes processed, a multiple of the vector size */
+
+__attribute__ ((target ("ssse3"))) static size_t
+bswap_ssse3 (unsigned char *dst, const unsigned char *src,
+             size_t length, const unsigned char *mask)
+{
+   const __m128i m = _mm_loadu_si128 ((const __m128i *) mask);
+   size_t j;
+
+   for (j = 0; j + 16 <= length; j += 16)
+      _mm_storeu_si128 ((__m128i *) (dst + j),
+        _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (src + j)), m));
+   return j;
+}
+
+__attribute__ ((target ("avx2"))) static size_t
+bswap_avx2 (unsigned char *dst, const unsigned char *src,
+            size_t length, const unsigned char *mask)
+{
+   const __m256i m = _mm256_loadu_si256 ((const __m256i *) mask);
+   size_t j;
+
+   for (j = 0; j + 32 <= length; j += 32)
+      _mm256_storeu_si256 ((__m256i *) (dst + j),
+        _mm256_shuffle_epi8
+          (_mm256_loadu_si256 ((const __m256i *) (src + j)), m));
+   return j;
+}
+
+/* 0: scalar only, 1: SSSE3, 2: AVX2, -1: not determined yet. Concurrent
+   first calls all compute the same value, so no locking is needed. */
+
+static int bswap_level = -1;
+
+#endif
+
+void
+__PolyORB_bswap_array (void *target, const void *source,
+                       size_t length, int size)
+{
+   unsigned char *dst = target;
+   const unsigned char *src = source;
+   size_t done = 0;
+
+#ifdef POLYORB_HAVE_SIMD_BSWAP
+   unsigned char mask[32];
+   int k;
+
+   if (bswap_level < 0) {
+      __builtin_cpu_init ();
+      if (__builtin_cpu_supports ("avx2"))
+         bswap_level = 2;
+      else if (__builtin_cpu_supports ("ssse3"))
+         bswap_level = 1;
+      else
+         bswap_level = 0;
+   }
+
+   if (bswap_level > 0 && length >= 16) {
+
+      /* Shuffle control reversing each element of each 128-bit lane */
+
+      for (k = 0; k < 32; k++)
+         mask[k] = (k % 16) / size * size + size - 1 - k % size;
+
+      if (bswap_level == 2)
+         done = bswap_avx2 (dst, src, length, mask);
+      else
+         done = bswap_ssse3 (dst, src, length, mask);
+   }
+#endif
+
+   bswap_scalar (dst + done, src + done, length - done, size);
+}
+
+/*
+ * Support for PolyORB.DSA_P.Storages.MMAP
+ *
+ * Shared passive variables are stored in files that are mapped in memory by
+ * all the partitions of a host. Each file starts with a lock word used as a
+ * cross-process mutex: 0 means unlocked, 1 locked, and 2 locked with
+ * possible waiters. Waiters sleep on the word with FUTEX_WAIT where futexes
+ * are available, and yield the processor otherwise.
+ */
+
+void *
+__PolyORB_shm_map (const char *path, size_t min_size, size_t *size) {
+#ifdef HAVE_SYS_MMAN_H
+   struct stat st;
+   void *addr;
+   int fd = open (path, O_RDWR | O_CREAT, 0666);
+
+   if (fd < 0)
+      return NULL;
+
+   /* Extend the file if needed, but never shrink it, since another
+      partition may have extended it concurrently. */
+
+   if (fstat (fd, &st) != 0)
+      goto fail;
+   if ((size_t) st.st_size < min_size) {
+#ifdef HAVE_POSIX_FALLOCATE
+      if (posix_fallocate (fd, 0, min_size) != 0)
+         goto fail;
+#else
+      if (ftruncate (fd, min_size) != 0)
+         goto fail;
+#endif
+      if (fstat (fd, &st) != 0)
+         goto fail;
+   }
+
+   addr = mmap (NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (addr == MAP_FAILED)
+      goto fail;
+
+   close (fd);
+   *size = st.st_size;
+   return addr;
+
+fail:
+   close (fd);
+   return NULL;
+#else
+   errno = ENOSYS;
+   return NULL;
+#endif
+}
+
+void
+__PolyORB_shm_unmap (void *addr, size_t size) {
+#ifdef HAVE_SYS_MMAN_H
+   (void) munmap (addr, size);
+#endif
+}
+
+static void
+shm_wait (int *word) {
+#ifdef POLYORB_HAVE_FUTEX
+   (void) syscall (SYS_futex, word, FUTEX_WAIT, 2, NULL, NULL, 0);
+#elif defined (HAVE_SCHED_YIELD)
+   (void) word;
+   (void) sched_yield ();
+#else
+   (void) word;
+#endif
+}
+
+static void
+shm_wake (int *word) {
+#ifdef POLYORB_HAVE_FUTEX
+   (void) syscall (SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+#else
+   (void) word;
+#endif
+}
+
+void
+__PolyORB_shm_lock (int *word) {
+   int c = __sync_val_compare_and_swap (word, 0, 1);
+
+   while (c != 0) {
+      /* Mark the lock as contended before going to sleep */
+
+      if (c == 2 || __sync_val_compare_and_swap (word, 1, 2) != 0)
+         shm_wait (word);
+      c = __sync_val_compare_and_swap (word, 0, 2);
+   }
+}
+
+void
+__PolyORB_shm_unlock (int *word) {
+   if (__sync_fetch_and_sub (word, 1) != 1) {
+      /* There may be waiters: release the lock and wake one of them */
+
+      __sync_lock_release (word);
+      shm_wake (word);
+   }
+}
+
+/*
+ * Support for PolyORB.MOMA_P.Provider.Message_Log
+ *
+ * Only the data of the log segments needs to reach the disk before a
+ * message is acknowledged to its producer: fdatasync is used where
+ * available so that file metadata updates are not forced as well.
+ */
+
+int
+__PolyORB_log_sync (int fd) {
+#ifdef HAVE_FDATASYNC
+   return fdatasync (fd);
+#elif defined (HAVE_UNISTD_H)
+   return fsync (fd);
+#else
+   (void) fd;
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+int
+__PolyORB_log_truncate (int fd, long long length) {
+#ifdef HAVE_UNISTD_H
+   return ftruncate (fd, (off_t) length);
+#else
+   (void) fd;
+   (void) length;
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+/*
+ * Support for PolyORB.Transport.Datagram.Sockets
+ *
+ * Receive at most COUNT datagrams already queued on FD with a single
+ * system call, without blocking. Datagram J is stored at BUF + J *
+ * SLOT_SIZE and its length is returned in LENGTHS [J], or -1 if it did
+ * not fit in SLOT_SIZE bytes and was truncated. The IPv4 address (in
+ * network byte order) and port of its sender are returned in
+ * ADDRS [4 * J .. 4 * J + 3] and PORTS [J]; PORTS [J] is set to -1 if the
+ * sender is not an IPv4 peer. Return the number of datagrams received,
+ * 0 if none was pending, -2 if the system call is not available, or -1
+ * (with errno set) if it failed.
+ */
+
+#define POLYORB_MAX_BURST 64
+
+int
+__PolyORB_recv_burst (int fd, char *buf, int slot_size, int count,
+                      int *lengths, unsigned char *addrs, int *ports) {
+#ifdef HAVE_RECVMMSG
+   struct mmsghdr msgs[POLYORB_MAX_BURST];
+   struct iovec iovs[POLYORB_MAX_BURST];
+   struct sockaddr_in from[POLYORB_MAX_BURST];
+   int n, j;
+
+   if (count > POLYORB_MAX_BURST)
+      count = POLYORB_MAX_BURST;
+
+   memset (msgs, 0, sizeof (msgs[0]) * count);
+   for (j = 0; j < count; j++) {
+      iovs[j].iov_base = buf + (size_t) j * slot_size;
+      iovs[j].iov_len = slot_size;
+      msgs[j].msg_hdr.msg_iov = &iovs[j];
+      msgs[j].msg_hdr.msg_iovlen = 1;
+      msgs[j].msg_hdr.msg_name = &from[j];
+      msgs[j].msg_hdr.msg_namelen = sizeof (from[j]);
+   }
+
+   do {
+      n = recvmmsg (fd, msgs, count, MSG_DONTWAIT, NULL);
+   } while (n < 0 && errno == EINTR);
+
+   if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+         return 0;
+      return (errno == ENOSYS) ? -2 : -1;
+   }
+
+   for (j = 0; j < n; j++) {
+      lengths[j] = (msgs[j].msg_hdr.msg_flags & MSG_TRUNC)
+                     ? -1 : (int) msgs[j].msg_len;
+      if (from[j].sin_family == AF_INET
+            && msgs[j].msg_hdr.msg_namelen >= sizeof (from[j])) {
+         memcpy (addrs + 4 * j, &from[j].sin_addr.s_addr, 4);
+         ports[j] = ntohs (from[j].sin_port);
+      } else {
+         ports[j] = -1;
+      }
+   }
+   return n;
+#else
+   (void) fd;
+   (void) buf;
+   (void) slot_size;
+   (void) count;
+   (void) lengths;
+   (void) addrs;
+   (void) ports;
+   errno = ENOSYS;
+   return -2;
+#endif
+}
+
+/*
+ * Send COUNT datagrams to the IPv4 peer whose dotted address is HOST, on
+ * PORT, with as few system calls as possible. The data of datagram J is
+ * made of IOV_COUNTS [J] consecutive elements of IOV_ARRAY, an array of
+ * struct iovec. Return the total number of bytes sent, -2 if the system
+ * call is not available or HOST is not an IPv4 address (nothing has been
+ * sent, the caller must fall back to one system call per datagram), or -1
+ * if sending failed, in which case the datagrams that precede the failing
+ * one have been sent.
+ */
+
+long long
+__PolyORB_send_burst (int fd, void *iov_array, const int *iov_counts,
+                      int count, const char *host, int port) {
+#ifdef HAVE_SENDMMSG
+   struct iovec *iovs = iov_array;
+   struct mmsghdr msgs[POLYORB_MAX_BURST];
+   struct sockaddr_in to;
+   long long total = 0;
+   int first = 0, n, j;
+
+   memset (&to, 0, sizeof (to));
+   to.sin_family = AF_INET;
+   to.sin_port = htons ((unsigned short) port);
+   if (inet_pton (AF_INET, host, &to.sin_addr) != 1) {
+      errno = EAFNOSUPPORT;
+      return -2;
+   }
+
+   while (first < count) {
+      int batch = count - first;
+
+      if (batch > POLYORB_MAX_BURST)
+         batch = POLYORB_MAX_BURST;
+
+      memset (msgs, 0, sizeof (msgs[0]) * batch);
+      for (j = 0; j < batch; j++) {
+         msgs[j].msg_hdr.msg_iov = iovs;
+         msgs[j].msg_hdr.msg_iovlen = iov_counts[first + j];
+         msgs[j].msg_hdr.msg_name = &to;
+         msgs[j].msg_hdr.msg_namelen = sizeof (to);
+         iovs += iov_counts[first + j];
+      }
+
+      /* Datagrams are sent atomically: a short count only means that
+         the remaining messages of the batch have to be sent again. */
+
+      j = 0;
+      while (j < batch) {
+         do {
+            n = sendmmsg (fd, msgs + j, batch - j, 0);
+         } while (n < 0 && errno == EINTR);
+
+         if (n < 0 && errno == ENOSYS && total == 0)
+            return -2;
+         if (n <= 0)
+            return -1;
+
+         for (n += j; j < n; j++)
+            total += msgs[j].msg_len;
+      }
+      first += batch;
+   }
+   return total;
+#else
+   (void) fd;
+   (void) iov_array;
+   (void) iov_counts;
+   (void) count;
+   (void) host;
+   (void) port;
+   errno = ENOSYS;
+   return -2;
+#endif
+}
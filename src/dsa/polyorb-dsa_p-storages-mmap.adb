@@ -0,0 +1,460 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--          P O L Y O R B . D S A _ P . S T O R A G E S . M M A P           --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Streams;
+with Interfaces.C;
+with System.Address_To_Access_Conversions;
+
+with PolyORB.Buffers;
+with PolyORB.DSA_P.Conversions;
+with PolyORB.Errors;
+with PolyORB.Log;
+with PolyORB.Representations;
+with PolyORB.Setup;
+
+package body PolyORB.DSA_P.Storages.MMAP is
+
+   use Ada.Streams;
+   use Interfaces;
+   use System.Storage_Elements;
+
+   use PolyORB.Buffers;
+   use PolyORB.DSA_P.Conversions;
+   use PolyORB.Errors;
+   use PolyORB.Log;
+   use PolyORB.Representations;
+
+   use type System.Address;
+
+   -------------
+   -- Logging --
+   -------------
+
+   package L is new Log.Facility_Log ("polyorb.dsa_p.storages.mmap");
+   procedure O (Message : Standard.String; Level : Log_Level := Debug)
+                renames L.Output;
+   function C  (Level : Log_Level := Debug) return Boolean
+                renames L.Enabled;
+
+   ------------------------
+   -- Variable file data --
+   ------------------------
+
+   --  A variable file starts with a header, followed by the marshalled
+   --  value of the variable.
+
+   type Header_Type is record
+      Lock       : aliased Interfaces.C.int;
+      --  Lock word, only accessed through C_Lock and C_Unlock
+
+      Generation : Unsigned_32;
+      --  Incremented by each Write
+
+      Length     : Unsigned_64;
+      --  Length of the marshalled value, 0 if the variable has never been
+      --  written.
+
+      File_Size  : Unsigned_64;
+      --  Size of the file as set by the last partition that extended it, 0
+      --  if it has never been extended.
+   end record;
+   pragma Convention (C, Header_Type);
+   pragma Volatile (Header_Type);
+
+   Header_Size : constant Storage_Count := 64;
+   --  Offset of the value in the file
+
+   Initial_File_Size : constant Storage_Count := 4096;
+
+   package Header_Conversions is
+     new System.Address_To_Access_Conversions (Header_Type);
+
+   subtype Header_Access is Header_Conversions.Object_Pointer;
+
+   Endianness : constant Endianness_Type := Big_Endian;
+   --  Endianness for stream representation
+
+   function C_Map
+     (Path     : System.Address;
+      Min_Size : Interfaces.C.size_t;
+      Size     : access Interfaces.C.size_t) return System.Address;
+   pragma Import (C, C_Map, "__PolyORB_shm_map");
+
+   procedure C_Unmap (Addr : System.Address; Size : Interfaces.C.size_t);
+   pragma Import (C, C_Unmap, "__PolyORB_shm_unmap");
+
+   procedure C_Lock (Word : System.Address);
+   pragma Import (C, C_Lock, "__PolyORB_shm_lock");
+
+   procedure C_Unlock (Word : System.Address);
+   pragma Import (C, C_Unlock, "__PolyORB_shm_unlock");
+
+   function Header (Var_Data : access MMAP_Manager_Type) return Header_Access;
+   pragma Inline (Header);
+   --  Return the header of the variable file, which must be mapped
+
+   procedure Map
+     (Var_Data : access MMAP_Manager_Type;
+      Min_Size : Storage_Count);
+   --  Map the variable file, extending it to Min_Size if it is shorter, and
+   --  unmap the previous mapping, if any.
+
+   procedure Initiate_Request
+     (Var_Data    : access MMAP_Manager_Type;
+      Data_Length : Storage_Count);
+   --  Map the variable file if needed and acquire the file lock, unless it
+   --  is already held for a protected object. Then make sure the mapping
+   --  covers the whole file, which is extended if needed so that it can
+   --  hold a value of Data_Length bytes. The file lock is not held if an
+   --  exception is propagated. Must be called with Var_Data.IO_Mutex held.
+
+   procedure Complete_Request (Var_Data : access MMAP_Manager_Type);
+   --  Release the file lock, unless it is held for a protected object
+
+   ------------
+   -- Create --
+   ------------
+
+   overriding function Create
+     (Manager_Factory : access MMAP_Manager_Type;
+      Full_Name       : String) return Shared_Data_Manager_RACW
+   is
+      Var : constant MMAP_Manager_Access := new MMAP_Manager_Type;
+
+   begin
+      pragma Debug (C, O ("create MMAP manager for variable " & Full_Name));
+
+      Var.Name := new String'(Full_Name);
+      Var.Dir  := Manager_Factory.Dir;
+      Create (Var.IO_Mutex);
+      Create (Var.PO_Mutex);
+
+      return Shared_Data_Manager_RACW (Var);
+   end Create;
+
+   ----------------------
+   -- Complete_Request --
+   ----------------------
+
+   procedure Complete_Request (Var_Data : access MMAP_Manager_Type) is
+   begin
+      if Var_Data.Count = 0 then
+         C_Unlock (Header (Var_Data).Lock'Address);
+      end if;
+   end Complete_Request;
+
+   ------------
+   -- Header --
+   ------------
+
+   function Header (Var_Data : access MMAP_Manager_Type) return Header_Access
+   is
+   begin
+      return Header_Conversions.To_Pointer (Var_Data.Address);
+   end Header;
+
+   ----------------------
+   -- Initiate_Request --
+   ----------------------
+
+   procedure Initiate_Request
+     (Var_Data    : access MMAP_Manager_Type;
+      Data_Length : Storage_Count)
+   is
+      File_Size : Storage_Count;
+
+   begin
+      if Var_Data.Address = System.Null_Address then
+         Map (Var_Data, Initial_File_Size);
+      end if;
+
+      if Var_Data.Count = 0 then
+         C_Lock (Header (Var_Data).Lock'Address);
+      end if;
+
+      begin
+         --  Follow extensions of the file by other partitions
+
+         File_Size := Storage_Count (Header (Var_Data).File_Size);
+         if File_Size > Var_Data.Size then
+            Map (Var_Data, File_Size);
+         end if;
+
+         if Header_Size + Data_Length > Var_Data.Size then
+            Map (Var_Data,
+                 Storage_Count'Max
+                   (Header_Size + Data_Length, 2 * Var_Data.Size));
+            Header (Var_Data).File_Size := Unsigned_64 (Var_Data.Size);
+         end if;
+
+      exception
+         when others =>
+            Complete_Request (Var_Data);
+            raise;
+      end;
+   end Initiate_Request;
+
+   ---------
+   -- Map --
+   ---------
+
+   procedure Map
+     (Var_Data : access MMAP_Manager_Type;
+      Min_Size : Storage_Count)
+   is
+      Path : constant String :=
+        Var_Data.Dir.all & Var_Data.Name.all & ASCII.NUL;
+
+      Size : aliased Interfaces.C.size_t;
+      Addr : System.Address;
+
+   begin
+      Addr := C_Map (Path'Address, Interfaces.C.size_t (Min_Size),
+                     Size'Access);
+
+      if Addr = System.Null_Address then
+         raise Program_Error with "cannot map shared variable file "
+           & Path (Path'First .. Path'Last - 1);
+      end if;
+
+      --  The new mapping is established before the previous one is
+      --  removed, so that a file lock held by the caller is never lost.
+
+      if Var_Data.Address /= System.Null_Address then
+         C_Unmap (Var_Data.Address, Interfaces.C.size_t (Var_Data.Size));
+      end if;
+
+      Var_Data.Address := Addr;
+      Var_Data.Size    := Storage_Count (Size);
+
+      pragma Debug (C, O ("Map variable file " & Var_Data.Name.all & ","
+                       & Var_Data.Size'Img & " bytes"));
+   end Map;
+
+   ----------
+   -- Read --
+   ----------
+
+   overriding procedure Read
+     (Self : access MMAP_Manager_Type;
+      Var  : SDT.Any_Container_Ptr)
+   is
+      Rep : constant Representation_Access :=
+        PolyORB.Setup.Default_Representation;
+
+      Locked : Boolean := False;
+      Hdr    : Header_Access;
+      Buffer : Buffer_Access;
+      Error  : Error_Container;
+
+   begin
+      Enter (Self.IO_Mutex);
+      Initiate_Request (Self, 0);
+      Locked := True;
+
+      Hdr := Header (Self);
+
+      --  Nothing to do if the variable has never been written, or if its
+      --  local value is current.
+
+      if Hdr.Length /= 0
+        and then not (Self.Valid and then Hdr.Generation = Self.Generation)
+      then
+         --  Unmarshall the value directly from the mapped file
+
+         Buffer := new Buffer_Type;
+         Initialize_Buffer
+           (Buffer               => Buffer,
+            Size                 => Stream_Element_Offset (Hdr.Length),
+            Data                 => Self.Address + Header_Size,
+            Endianness           => Endianness,
+            Initial_CDR_Position => 0);
+
+         Unmarshall_To_Any (Rep, Buffer, DAC_To_AC (Var).all, Error);
+         Release (Buffer);
+
+         if Found (Error) then
+            Catch (Error);
+            Self.Valid := False;
+         else
+            Self.Generation := Hdr.Generation;
+            Self.Valid := True;
+         end if;
+      end if;
+
+      Complete_Request (Self);
+      Leave (Self.IO_Mutex);
+
+   exception
+      when others =>
+         if Locked then
+            Complete_Request (Self);
+         end if;
+         Leave (Self.IO_Mutex);
+         raise;
+   end Read;
+
+   ------------------------------
+   -- Register_Passive_Package --
+   ------------------------------
+
+   procedure Register_Passive_Package
+     (Pkg_Name : String;
+      Is_Owner : Boolean;
+      Location : String)
+   is
+      pragma Unreferenced (Is_Owner);
+      Factory : constant MMAP_Manager_Access := new MMAP_Manager_Type;
+
+   begin
+      pragma Debug (C, O ("Register MMAP factory for package "
+        & Pkg_Name));
+
+      --  Location is a directory. Add a separator if the location is
+      --  not empty.
+
+      if Location'Length /= 0 then
+         Factory.Dir := new String'(Location & OS.Directory_Separator);
+      else
+         Factory.Dir := new String'(Location);
+      end if;
+
+      Register_Factory (Pkg_Name, Shared_Data_Manager_RACW (Factory));
+   end Register_Passive_Package;
+
+   -----------
+   -- Write --
+   -----------
+
+   overriding procedure Write
+     (Self : access MMAP_Manager_Type;
+      Var  : SDT.Any_Container_Ptr)
+   is
+      Rep : constant Representation_Access :=
+        PolyORB.Setup.Default_Representation;
+
+      Entered : Boolean := False;
+      Locked  : Boolean := False;
+      Hdr     : Header_Access;
+      Buffer  : Buffer_Access := new Buffer_Type;
+      Error   : Error_Container;
+
+   begin
+      --  Marshall Any into buffer before entering any critical section
+
+      Set_Endianness (Buffer, Endianness);
+      Marshall_From_Any (Rep, Buffer, DAC_To_AC (Var).all, Error);
+
+      if Found (Error) then
+         Catch (Error);
+         Release (Buffer);
+         return;
+      end if;
+
+      declare
+         Value : constant Stream_Element_Array :=
+           To_Stream_Element_Array (Buffer.all);
+      begin
+         Release (Buffer);
+
+         Enter (Self.IO_Mutex);
+         Entered := True;
+         Initiate_Request (Self, Value'Length);
+         Locked := True;
+
+         declare
+            Target : Stream_Element_Array (Value'Range);
+            for Target'Address use Self.Address + Header_Size;
+            pragma Import (Ada, Target);
+         begin
+            Target := Value;
+         end;
+
+         Hdr := Header (Self);
+         Hdr.Length     := Unsigned_64 (Value'Length);
+         Hdr.Generation := Hdr.Generation + 1;
+         Self.Generation := Hdr.Generation;
+         Self.Valid      := True;
+      end;
+
+      Complete_Request (Self);
+      Leave (Self.IO_Mutex);
+
+   exception
+      when others =>
+         if Locked then
+            Complete_Request (Self);
+         end if;
+         if Entered then
+            Leave (Self.IO_Mutex);
+         end if;
+         raise;
+   end Write;
+
+   ----------
+   -- Lock --
+   ----------
+
+   overriding procedure Lock (Self : access MMAP_Manager_Type) is
+   begin
+      Enter (Self.PO_Mutex);
+      Enter (Self.IO_Mutex);
+
+      begin
+         Initiate_Request (Self, 0);
+      exception
+         when others =>
+            Leave (Self.IO_Mutex);
+            Leave (Self.PO_Mutex);
+            raise;
+      end;
+
+      Self.Count := Self.Count + 1;
+      Leave (Self.IO_Mutex);
+   end Lock;
+
+   ------------
+   -- Unlock --
+   ------------
+
+   overriding procedure Unlock (Self : access MMAP_Manager_Type) is
+   begin
+      Enter (Self.IO_Mutex);
+      Self.Count := Self.Count - 1;
+      Complete_Request (Self);
+      Leave (Self.IO_Mutex);
+      Leave (Self.PO_Mutex);
+   end Unlock;
+
+end PolyORB.DSA_P.Storages.MMAP;
@@ -231,4 +231,16 @@ package body PolyORB.GIOP_P.Transport_Mechanisms.DIOP is
         and then Left.Address = DIOP_Transport_Mechanism (Right).Address;
    end Is_Colocated;
 
+   ---------------
+   -- Node_Keys --
+   ---------------
+
+   overriding function Node_Keys
+     (M : DIOP_Transport_Mechanism) return PolyORB.Utils.Strings.Lists.List
+   is
+   begin
+      return PolyORB.Utils.Strings.Lists."+"
+        ("diop:" & Image (M.Address.all));
+   end Node_Keys;
+
 end PolyORB.GIOP_P.Transport_Mechanisms.DIOP;
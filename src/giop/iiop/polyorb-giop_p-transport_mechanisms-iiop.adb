@@ -416,6 +416,24 @@ package body PolyORB.GIOP_P.Transport_Mechanisms.IIOP is
       return False;
    end Is_Colocated;
 
+   ---------------
+   -- Node_Keys --
+   ---------------
+
+   overriding function Node_Keys
+     (M : IIOP_Transport_Mechanism) return PolyORB.Utils.Strings.Lists.List
+   is
+      Iter   : Iterator := First (M.Addresses);
+      Result : PolyORB.Utils.Strings.Lists.List;
+   begin
+      while not Last (Iter) loop
+         PolyORB.Utils.Strings.Lists.Append
+           (Result, "iiop:" & Image (Value (Iter).all.all));
+         Next (Iter);
+      end loop;
+      return Result;
+   end Node_Keys;
+
 begin
    declare
       use PolyORB.Initialization;
@@ -403,6 +403,22 @@ package body PolyORB.GIOP_P.Transport_Mechanisms.SSLIOP is
               "polyorb.protocols.ssliop.verify_client_once",
               False)));
 
+         Set_Session_Cache
+           (Binding_Context,
+            (Size     => Get_Conf
+                           ("ssliop",
+                            "polyorb.protocols.ssliop.session_cache_size",
+                            1024),
+             Lifetime => Get_Conf
+                           ("ssliop",
+                            "polyorb.protocols.ssliop.session_lifetime",
+                            300.0),
+             Tickets  => Get_Conf
+                           ("ssliop",
+                            "polyorb.protocols.ssliop.session_tickets",
+                            True)),
+            Server => False);
+
          Register (Tag_SSL_Sec_Trans, Create'Access);
       end if;
    end Initialize;
@@ -420,6 +436,18 @@ package body PolyORB.GIOP_P.Transport_Mechanisms.SSLIOP is
         and then Left.Address = SSLIOP_Transport_Mechanism (Right).Address;
    end Is_Colocated;
 
+   ---------------
+   -- Node_Keys --
+   ---------------
+
+   overriding function Node_Keys
+     (M : SSLIOP_Transport_Mechanism) return PolyORB.Utils.Strings.Lists.List
+   is
+   begin
+      return PolyORB.Utils.Strings.Lists."+"
+        ("ssliop:" & Image (M.Address.all));
+   end Node_Keys;
+
    ------------------------
    -- Is_Local_Mechanism --
    ------------------------
@@ -157,6 +157,22 @@ package body PolyORB.Setup.Access_Points.SSLIOP is
                Load_Client_CA (Cont, CA_File);
             end if;
 
+            Set_Session_Cache
+              (Cont,
+               (Size     => Get_Conf
+                              ("ssliop",
+                               "polyorb.protocols.ssliop.session_cache_size",
+                               1024),
+                Lifetime => Get_Conf
+                              ("ssliop",
+                               "polyorb.protocols.ssliop.session_lifetime",
+                               300.0),
+                Tickets  => Get_Conf
+                              ("ssliop",
+                               "polyorb.protocols.ssliop.session_tickets",
+                               True)),
+               Server => True);
+
             --  Initialize APs, with no associated profile factory (the SSL
             --  AP is registered as an additional transport mechanism on the
             --  primary IIOP profile factory).
@@ -35,17 +35,27 @@ pragma Ada_2012;
 --  MIOP filter for data which arrive from network to ORB
 --  this filter MUST be under a GIOP Session
 
+with Ada.Unchecked_Deallocation;
+
 with PolyORB.Filters.Iface;
+with PolyORB.Initialization;
 with PolyORB.Log;
+with PolyORB.Opaque;
+with PolyORB.Parameters;
 with PolyORB.Protocols.GIOP;
+with PolyORB.Tasking.Mutexes;
 
 package body PolyORB.Filters.MIOP.MIOP_In is
 
+   use Ada.Real_Time;
+
    use PolyORB.Buffers;
    use PolyORB.Components;
    use PolyORB.Filters.Iface;
    use PolyORB.Log;
    use PolyORB.Protocols.GIOP;
+   use PolyORB.Tasking.Mutexes;
+   use PolyORB.Types;
 
    package L is new PolyORB.Log.Facility_Log ("polyorb.filters.miop.miop_in");
    procedure O (Message : String; Level : Log_Level := Debug)
@@ -53,6 +63,67 @@ package body PolyORB.Filters.MIOP.MIOP_In is
    function C (Level : Log_Level := Debug) return Boolean
      renames L.Enabled;
 
+   --  Reassembly limits, set from the configuration at initialization
+
+   Reassembly_Timeout : Time_Span;
+   Reassembly_Memory  : Stream_Element_Count;
+
+   Stats_Lock : Mutex_Access;
+   Stats      : Reassembly_Statistics;
+   --  Counters of all MIOP_In filters, protected by Stats_Lock
+
+   type Counter is (Packets, Messages, Dropped, Timeouts, Evictions);
+
+   procedure Count (What : Counter);
+   --  Increment the given counter
+
+   procedure Free is new Ada.Unchecked_Deallocation
+     (Stream_Element_Array, Data_Access);
+
+   procedure Free is new Ada.Unchecked_Deallocation
+     (Collection, Collection_Access);
+
+   procedure Discard
+     (F    : access MIOP_In_Filter;
+      Coll : in out Collection_Access);
+   --  Remove Coll from the reassembly table of F and deallocate it
+
+   function Sender (F : access MIOP_In_Filter) return String;
+   --  Return an image of the address of the sender of the current packet,
+   --  as reported by the transport endpoint.
+
+   procedure Store_Packet (F : access MIOP_In_Filter; Data : Data_Access);
+   --  Record Data as the payload of the current packet of F, and queue the
+   --  GIOP message it completes, if any. Data is either stored or
+   --  deallocated.
+
+   function Serve (F : access MIOP_In_Filter) return Message'Class;
+   --  Hand the data expected by the GIOP layer from the oldest received
+   --  message to the GIOP layer, or ask the lower layer for the next packet
+   --  if no message is ready.
+
+   -----------
+   -- Count --
+   -----------
+
+   procedure Count (What : Counter) is
+   begin
+      Enter (Stats_Lock);
+      case What is
+         when Packets =>
+            Stats.Packets := Stats.Packets + 1;
+         when Messages =>
+            Stats.Messages := Stats.Messages + 1;
+         when Dropped =>
+            Stats.Dropped := Stats.Dropped + 1;
+         when Timeouts =>
+            Stats.Timeouts := Stats.Timeouts + 1;
+         when Evictions =>
+            Stats.Evictions := Stats.Evictions + 1;
+      end case;
+      Leave (Stats_Lock);
+   end Count;
+
    ------------
    -- Create --
    ------------
@@ -69,9 +140,70 @@ package body PolyORB.Filters.MIOP.MIOP_In is
    begin
       MIOP_In_Filter (Res.all).In_Buf := null;
       MIOP_In_Filter (Res.all).MIOP_Buf := new Buffer_Type;
+      MIOP_In_Filter (Res.all).Packet_Buf := new Buffer_Type;
+      Collection_Tables.Initialize (MIOP_In_Filter (Res.all).Collections);
       MIOP_In := Res;
    end Create;
 
+   -------------
+   -- Destroy --
+   -------------
+
+   overriding procedure Destroy (F : in out MIOP_In_Filter) is
+      Data : Data_Access;
+   begin
+      while F.Oldest /= null loop
+         declare
+            Coll : Collection_Access := F.Oldest;
+         begin
+            Discard (F'Access, Coll);
+         end;
+      end loop;
+      Collection_Tables.Finalize (F.Collections);
+
+      while not Data_Lists.Is_Empty (F.Ready) loop
+         Data_Lists.Extract_First (F.Ready, Data);
+         Free (Data);
+      end loop;
+      Free (F.Current);
+
+      Release (F.MIOP_Buf);
+      Release (F.Packet_Buf);
+      Filters.Destroy (Filter (F));
+   end Destroy;
+
+   -------------
+   -- Discard --
+   -------------
+
+   procedure Discard
+     (F    : access MIOP_In_Filter;
+      Coll : in out Collection_Access)
+   is
+   begin
+      Collection_Tables.Delete (F.Collections, Coll.Key.all);
+
+      if Coll.Older = null then
+         F.Oldest := Coll.Newer;
+      else
+         Coll.Older.Newer := Coll.Newer;
+      end if;
+
+      if Coll.Newer = null then
+         F.Newest := Coll.Older;
+      else
+         Coll.Newer.Older := Coll.Older;
+      end if;
+
+      for J in Coll.Packets'Range loop
+         Free (Coll.Packets (J));
+      end loop;
+      F.Held := F.Held - Coll.Size;
+
+      Utils.Strings.Free (Coll.Key);
+      Free (Coll);
+   end Discard;
+
    --------------------
    -- Handle_Message --
    --------------------
@@ -80,8 +212,6 @@ package body PolyORB.Filters.MIOP.MIOP_In is
      (F : not null access MIOP_In_Filter;
       S : Components.Message'Class) return Components.Message'Class
    is
-      use PolyORB.Types;
-
    begin
       if S in Data_Indication then
          case F.State is
@@ -98,8 +228,8 @@ package body PolyORB.Filters.MIOP.MIOP_In is
 
                declare
                   N : Stream_Element_Count :=
-                    Stream_Element_Count (F.Header.Unique_Id_Size +
-                      Types.Unsigned_Long (MIOP_Header_Size));
+                    Stream_Element_Count (F.Header.Unique_Id_Size) +
+                      MIOP_Header_Size;
                begin
                   --  Round up N to nearest greater multiple of 8
 
@@ -107,7 +237,10 @@ package body PolyORB.Filters.MIOP.MIOP_In is
 
                   --  Compute payload size
 
-                  F.Payload := F.Header.Packet_Size - Types.Unsigned_Short (N);
+                  if N > Stream_Element_Count (F.Header.Packet_Size) then
+                     raise MIOP_Packet_Error;
+                  end if;
+                  F.Payload := Stream_Element_Count (F.Header.Packet_Size) - N;
                   pragma Debug (C, O ("Packet payload : " & F.Payload'Img));
 
                   --  Compute data length of unique id + padding
@@ -120,6 +253,7 @@ package body PolyORB.Filters.MIOP.MIOP_In is
 
             when Wait_Unique_Id =>
                --  Unique id received
+
                Unmarshall_Unique_Id (F.MIOP_Buf,
                                      F.Header.Unique_Id_Size,
                                      F.Header.Unique_Id);
@@ -127,111 +261,23 @@ package body PolyORB.Filters.MIOP.MIOP_In is
                                 & To_Standard_String (F.Header.Unique_Id)));
 
                Release_Contents (F.MIOP_Buf.all);
-               F.State := Wait_GIOP_Data;
-
-               if F.Fragment then
-                  --  Check whether the received packet is the expected one
-
-                  if not (F.Header.Collect_Mode
-                    and then F.Header.Unique_Id     = F.Old_Header.Unique_Id
-                    and then F.Header.Packet_Total  = F.Old_Header.Packet_Total
-                    and then F.Header.Packet_Number =
-                               F.Old_Header.Packet_Number + 1)
-                  then
-                     --  XXX error if a packet is missing
-                     raise MIOP_Packet_Error;
-                  end if;
-
-                  --  Check size if last fragment
+               F.State := Wait_Payload;
+               return Emit
+                 (F.Lower,
+                  Data_Expected'(In_Buf => F.Packet_Buf, Max => F.Payload));
 
-                  pragma Assert
-                    (F.Header.Packet_Number + 1 /= F.Header.Packet_Total
-                       or else Stream_Element_Offset (F.Payload) = F.Data_Exp);
+            when Wait_Payload =>
+               --  Packet payload received
 
-                  --  Ask for next fragment
-
-                  return Emit
-                    (F.Lower,
-                     Data_Expected'
-                     (In_Buf => F.In_Buf,
-                      Max => Stream_Element_Offset (F.Payload)));
-
-               else
-                  --  No fragment, ask for data
-
-                  return Emit
-                    (F.Lower,
-                     Data_Expected'(In_Buf => F.In_Buf, Max => F.Data_Exp));
-               end if;
-
-            when Wait_GIOP_Data =>
-               --  GIOP data received
-
-               if not F.Fragment
-                    and then
-                  F.Initial_Data_Exp = Remaining (F.In_Buf) - F.Initial_Remain
-               then
-                  --  Data reception complete
-
-                  pragma Debug (C, O ("Send asked data to upper filter"));
-                  F.Payload := F.Payload - Types.Unsigned_Short (F.Data_Exp);
-                  F.State := Wait_GIOP_Ask;
-                  return Emit (F.Upper, S);
-
-               elsif F.Fragment
-                       and then
-                     F.Header.Packet_Number + 1 = F.Header.Packet_Total
-               then
-                  --  All fragments received
-
-                  pragma Debug (C, O ("Fragment received, number"
-                                   & F.Header.Packet_Number'Img
-                                   & " /"
-                                   & Types.Unsigned_Long
-                                       (F.Header.Packet_Total - 1)'Img
-                                   & ", size :" & F.Header.Packet_Size'Img
-                                   & ", payload :" & F.Payload'Img));
-                  F.Fragment := False;
-                  pragma Debug (C, O ("Send asked data to upper filter"));
-                  F.State := Wait_GIOP_Ask;
-                  return Emit (F.Upper, S);
-
-               else
-                  if not F.Header.Collect_Mode then
-                     --  XXX error if a packet is missing
-                     raise MIOP_Packet_Error;
-                  end if;
-
-                  --  Some fragments left, ask for next
-
-                  pragma Assert (F.Initial_Data_Exp
-                                   >= Remaining (F.In_Buf) - F.Initial_Remain);
-                  begin
-                     F.Data_Exp :=
-                       F.Data_Exp - Stream_Element_Offset (F.Payload);
-                  exception
-                     when Constraint_Error =>
-                        raise MIOP_Packet_Error;
-                  end;
-
-                  pragma Debug (C, O ("Fragment received, number"
-                                   & F.Header.Packet_Number'Img
-                                   & " /"
-                                   & Types.Unsigned_Long
-                                   (F.Header.Packet_Total - 1)'Img
-                                   & ", size :" & F.Header.Packet_Size'Img
-                                   & ", payload :" & F.Payload'Img));
-                  pragma Debug (C, O ("Bytes left to receive:"
-                                   & F.Data_Exp'Img));
-                  F.Fragment := True;
-                  F.Old_Header := F.Header;
-                  F.State := Wait_MIOP_Header;
-                  pragma Debug (C, O ("Wait for MIOP Header"));
-                  return Emit (F.Lower,
-                               Data_Expected'
-                               (In_Buf => F.MIOP_Buf,
-                                Max => MIOP_Header_Size));
-               end if;
+               declare
+                  Data : constant Data_Access :=
+                    new Stream_Element_Array'
+                      (To_Stream_Element_Array (F.Packet_Buf.all));
+               begin
+                  Release_Contents (F.Packet_Buf.all);
+                  Store_Packet (F, Data);
+               end;
+               return Serve (F);
 
             when others =>
                raise MIOP_Packet_Error;
@@ -241,71 +287,24 @@ package body PolyORB.Filters.MIOP.MIOP_In is
          declare
             D : GIOP_Data_Expected renames GIOP_Data_Expected (S);
          begin
+            if F.State /= Wait_For_GIOP_Layer then
+               raise MIOP_Packet_Error;
+            end if;
+
             F.In_Buf := D.In_Buf;
             F.Data_Exp := D.Max;
-            F.Initial_Data_Exp := D.Max;
-            F.Initial_Remain := Remaining (F.In_Buf);
-
-            case F.State is
-               when Wait_For_GIOP_Layer =>
-                  --  GIOP layer ask for next packet
-
-                  pragma Assert (D.State = Expect_Header);
-                  F.State := Wait_MIOP_Header;
-                  pragma Debug (C, O ("Wait for MIOP Header"));
-                  return Emit (F.Lower,
-                               Data_Expected'
-                               (In_Buf => F.MIOP_Buf,
-                                Max => MIOP_Header_Size));
-
-               when Wait_GIOP_Ask =>
-
-                  if D.State = Expect_Header then
-                     --  GIOP layer ask for next packet
-
-                     F.State := Wait_MIOP_Header;
-                     pragma Debug (C, O ("Wait for MIOP Header"));
-                     return Emit (F.Lower,
-                                  Data_Expected'
-                                  (In_Buf => F.MIOP_Buf,
-                                   Max => MIOP_Header_Size));
-
-                  else
-                     --  GIOP layer ask for data
-
-                     pragma Debug (C, O ("Upper requests"
-                                      & F.Data_Exp'Img
-                                      & " bytes"));
-                     F.State := Wait_GIOP_Data;
-
-                     --  Test if requested data are in the current packet
-
-                     if F.Data_Exp > Stream_Element_Offset (F.Payload) then
-                        --  Not all data are here, fragment mode needed
-
-                        if not F.Header.Collect_Mode then
-                           raise MIOP_Packet_Error;
-                        end if;
-
-                        return Emit (F.Lower,
-                                     Data_Expected'
-                                     (In_Buf => F.In_Buf,
-                                      Max =>
-                                        Stream_Element_Offset (F.Payload)));
-
-                     else
-                        --  No fragment, data are in packet
-
-                        return Emit (F.Lower,
-                                     Data_Expected'
-                                     (In_Buf => F.In_Buf,
-                                      Max => F.Data_Exp));
-                     end if;
-                  end if;
 
-               when others =>
-                  raise MIOP_Packet_Error;
-            end case;
+            --  A new GIOP message starts: drop whatever remains of the
+            --  previous one.
+
+            if D.State = Expect_Header and then F.Current /= null then
+               pragma Debug (C, O ("Discarding trailing data"));
+               Free (F.Current);
+            end if;
+
+            pragma Debug (C, O ("Upper requests" & F.Data_Exp'Img
+                                & " bytes"));
+            return Serve (F);
          end;
 
       else
@@ -313,4 +312,276 @@ package body PolyORB.Filters.MIOP.MIOP_In is
       end if;
    end Handle_Message;
 
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize;
+
+   procedure Initialize is
+      use PolyORB.Parameters;
+   begin
+      Create (Stats_Lock);
+      Reassembly_Timeout := To_Time_Span
+        (Get_Conf ("miop", "polyorb.miop.reassembly_timeout", 2.0));
+      Reassembly_Memory := Stream_Element_Count
+        (Get_Conf ("miop", "polyorb.miop.reassembly_memory", 4_194_304));
+   end Initialize;
+
+   -----------
+   -- Serve --
+   -----------
+
+   function Serve (F : access MIOP_In_Filter) return Message'Class is
+   begin
+      if F.Current = null and then not Data_Lists.Is_Empty (F.Ready) then
+         Data_Lists.Extract_First (F.Ready, F.Current);
+         F.Current_Pos := F.Current'First;
+      end if;
+
+      if F.Current = null then
+         --  No message is ready, wait for the next packet
+
+         F.State := Wait_MIOP_Header;
+         pragma Debug (C, O ("Wait for MIOP Header"));
+         return Emit
+           (F.Lower,
+            Data_Expected'(In_Buf => F.MIOP_Buf, Max => MIOP_Header_Size));
+      end if;
+
+      declare
+         Last : constant Stream_Element_Offset :=
+           F.Current_Pos + F.Data_Exp - 1;
+         Data : Opaque.Opaque_Pointer;
+
+         Saved_CDR_Position : constant Stream_Element_Offset :=
+           CDR_Position (F.In_Buf);
+      begin
+         if Last > F.Current'Last then
+            --  The message is shorter than announced by its GIOP header
+
+            Free (F.Current);
+            raise MIOP_Packet_Error;
+         end if;
+
+         Allocate_And_Insert_Cooked_Data (F.In_Buf, F.Data_Exp, Data);
+         declare
+            Z : Stream_Element_Array (1 .. F.Data_Exp);
+            for Z'Address use Data;
+            pragma Import (Ada, Z);
+         begin
+            Z := F.Current (F.Current_Pos .. Last);
+         end;
+
+         --  As for data received from a transport endpoint, the CDR
+         --  position of In_Buf is left at the start of the new data.
+
+         Set_CDR_Position (F.In_Buf, Saved_CDR_Position);
+
+         F.Current_Pos := Last + 1;
+         if F.Current_Pos > F.Current'Last then
+            Free (F.Current);
+         end if;
+      end;
+
+      --  The GIOP layer may ask for more data before Emit returns
+
+      pragma Debug (C, O ("Send asked data to upper filter"));
+      F.State := Wait_For_GIOP_Layer;
+      return Emit (F.Upper, Data_Indication'(Data_Amount => F.Data_Exp));
+   end Serve;
+
+   ------------
+   -- Sender --
+   ------------
+
+   function Sender (F : access MIOP_In_Filter) return String is
+      Reply : constant Message'Class :=
+        Emit (F.Lower, Get_Peer_Name'(null record));
+   begin
+      if Reply in Peer_Name then
+         return To_Standard_String (Peer_Name (Reply).Name);
+      else
+         return "";
+      end if;
+   end Sender;
+
+   ----------------
+   -- Statistics --
+   ----------------
+
+   function Statistics return Reassembly_Statistics is
+      Result : Reassembly_Statistics;
+   begin
+      Enter (Stats_Lock);
+      Result := Stats;
+      Leave (Stats_Lock);
+      return Result;
+   end Statistics;
+
+   ------------------
+   -- Store_Packet --
+   ------------------
+
+   procedure Store_Packet (F : access MIOP_In_Filter; Data : Data_Access) is
+      H    : MIOP_Header renames F.Header;
+      Now  : constant Time := Clock;
+      Coll : Collection_Access;
+      Item : Data_Access := Data;
+
+   begin
+      Count (Packets);
+
+      --  Discard the collections that have timed out. Collections are
+      --  created with the same timeout, so the oldest ones expire first.
+
+      while F.Oldest /= null and then F.Oldest.Deadline < Now loop
+         Coll := F.Oldest;
+         O ("MIOP collection timed out: " & Coll.Key.all
+            & ", received" & Coll.Received'Img & " of" & Coll.Total'Img
+            & " packets", Notice);
+         Discard (F, Coll);
+         Count (Timeouts);
+      end loop;
+
+      --  Unfragmented message
+
+      if not H.Collect_Mode or else H.Packet_Total = 1 then
+         if H.Packet_Number /= 0 then
+            Count (Dropped);
+            Free (Item);
+         else
+            Data_Lists.Append (F.Ready, Item);
+            Count (Messages);
+         end if;
+         return;
+      end if;
+
+      if H.Packet_Number >= H.Packet_Total then
+         O ("invalid MIOP packet number" & H.Packet_Number'Img
+            & " /" & H.Packet_Total'Img, Notice);
+         Count (Dropped);
+         Free (Item);
+         return;
+      end if;
+
+      declare
+         Key : constant String :=
+           Sender (F) & " " & To_Standard_String (H.Unique_Id);
+         Index_Size : constant Stream_Element_Count :=
+           Stream_Element_Count (H.Packet_Total)
+             * Data_Access'Max_Size_In_Storage_Elements;
+      begin
+         Coll := Collection_Tables.Lookup (F.Collections, Key, null);
+
+         if Coll = null then
+            --  First packet of a new collection. The packet table of the
+            --  collection is accounted for in the memory it holds.
+
+            if Index_Size + Item'Length > Reassembly_Memory then
+               O ("MIOP collection too large: " & Key, Notice);
+               Count (Dropped);
+               Free (Item);
+               return;
+            end if;
+
+            Coll := new Collection (Total => H.Packet_Total);
+            Coll.Key := new String'(Key);
+            Coll.Deadline := Now + Reassembly_Timeout;
+            Coll.Size := Index_Size;
+            F.Held := F.Held + Index_Size;
+
+            Coll.Older := F.Newest;
+            if F.Newest = null then
+               F.Oldest := Coll;
+            else
+               F.Newest.Newer := Coll;
+            end if;
+            F.Newest := Coll;
+            Collection_Tables.Insert (F.Collections, Key, Coll);
+
+         elsif Coll.Total /= H.Packet_Total
+           or else Coll.Packets (H.Packet_Number + 1) /= null
+         then
+            --  Inconsistent or duplicated packet
+
+            pragma Debug (C, O ("Dropping packet" & H.Packet_Number'Img
+                                & " of " & Key));
+            Count (Dropped);
+            Free (Item);
+            return;
+         end if;
+      end;
+
+      --  Make room for the packet by evicting the oldest collections. Coll
+      --  itself may be evicted if it is the oldest, in which case the packet
+      --  is dropped.
+
+      while F.Held + Item'Length > Reassembly_Memory loop
+         declare
+            Victim : Collection_Access := F.Oldest;
+            Last   : constant Boolean := Victim = Coll;
+         begin
+            O ("MIOP reassembly memory exhausted, discarding "
+               & Victim.Key.all, Notice);
+            Discard (F, Victim);
+            Count (Evictions);
+
+            if Last then
+               Count (Dropped);
+               Free (Item);
+               return;
+            end if;
+         end;
+      end loop;
+
+      Coll.Packets (H.Packet_Number + 1) := Item;
+      Coll.Received := Coll.Received + 1;
+      Coll.Size := Coll.Size + Item'Length;
+      F.Held := F.Held + Item'Length;
+
+      pragma Debug (C, O ("Packet" & H.Packet_Number'Img & " /"
+                          & H.Packet_Total'Img & " of " & Coll.Key.all
+                          & ", payload :" & Item'Length'Img));
+
+      if Coll.Received = Coll.Total then
+         --  All packets received: assemble the GIOP message
+
+         declare
+            Length : Stream_Element_Count := 0;
+            Pos    : Stream_Element_Offset := 1;
+            Msg    : Data_Access;
+         begin
+            for J in Coll.Packets'Range loop
+               Length := Length + Coll.Packets (J)'Length;
+            end loop;
+
+            Msg := new Stream_Element_Array (1 .. Length);
+            for J in Coll.Packets'Range loop
+               Msg (Pos .. Pos + Coll.Packets (J)'Length - 1) :=
+                 Coll.Packets (J).all;
+               Pos := Pos + Coll.Packets (J)'Length;
+            end loop;
+
+            Discard (F, Coll);
+            Data_Lists.Append (F.Ready, Msg);
+            Count (Messages);
+         end;
+      end if;
+   end Store_Packet;
+
+   use PolyORB.Initialization;
+   use PolyORB.Initialization.String_Lists;
+   use PolyORB.Utils.Strings;
+
+begin
+   Register_Module
+     (Module_Info'
+      (Name      => +"filters.miop.miop_in",
+       Conflicts => Empty,
+       Depends   => +"tasking.mutexes" & "parameters",
+       Provides  => Empty,
+       Implicit  => False,
+       Init      => Initialize'Access,
+       Shutdown  => null));
 end PolyORB.Filters.MIOP.MIOP_In;
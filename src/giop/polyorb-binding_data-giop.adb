@@ -191,6 +191,45 @@ package body PolyORB.Binding_Data.GIOP is
       return False;
    end Is_Local_Profile;
 
+   ---------------
+   -- Node_Keys --
+   ---------------
+
+   overriding function Node_Keys
+     (P : GIOP_Profile_Type) return PolyORB.Utils.Strings.Lists.List
+   is
+      use PolyORB.Utils.Strings.Lists;
+      use Transport_Mechanism_Lists;
+
+      M_Iter : Transport_Mechanism_Lists.Iterator := First (P.Mechanisms);
+      Result : PolyORB.Utils.Strings.Lists.List;
+
+   begin
+      while not Last (M_Iter) loop
+         declare
+            M_Keys : PolyORB.Utils.Strings.Lists.List :=
+              Node_Keys (Value (M_Iter).all.all);
+            K_Iter : PolyORB.Utils.Strings.Lists.Iterator := First (M_Keys);
+
+         begin
+            if Is_Empty (M_Keys) then
+               Deallocate (Result);
+               return PolyORB.Utils.Strings.Lists.Empty;
+            end if;
+
+            while not Last (K_Iter) loop
+               Append (Result, Value (K_Iter).all);
+               Next (K_Iter);
+            end loop;
+            Deallocate (M_Keys);
+         end;
+
+         Next (M_Iter);
+      end loop;
+
+      return Result;
+   end Node_Keys;
+
    -------------------
    -- Get_Component --
    -------------------
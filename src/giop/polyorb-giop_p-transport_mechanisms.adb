@@ -135,6 +135,18 @@ package body PolyORB.GIOP_P.Transport_Mechanisms is
       return False;
    end Is_Colocated;
 
+   ---------------
+   -- Node_Keys --
+   ---------------
+
+   function Node_Keys
+     (M : Transport_Mechanism) return PolyORB.Utils.Strings.Lists.List
+   is
+      pragma Unreferenced (M);
+   begin
+      return PolyORB.Utils.Strings.Lists.Empty;
+   end Node_Keys;
+
    --------------
    -- Register --
    --------------
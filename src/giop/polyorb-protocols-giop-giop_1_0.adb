@@ -164,6 +164,7 @@ package body PolyORB.Protocols.GIOP.GIOP_1_0 is
       --  Free (Sess.SCtx);
       --  There is no SCtx for GIOP 1.0
 
+      Release (GIOP_1_0_CDR_Representation (Sess.Repr.all));
       Free (GIOP_1_0_CDR_Representation_Access (Sess.Repr));
       pragma Debug (C, O ("Finalize context for GIOP session 1.0"));
    end Finalize_Session;
@@ -162,6 +162,11 @@ package body PolyORB.Protocols.GIOP.GIOP_1_2 is
       Implem.Max_Body              :=
         Implem.Max_GIOP_Message_Size - Types.Unsigned_Long (GIOP_Header_Size);
       Implem.Permitted_Sync_Scopes := Permitted_Sync_Scopes;
+      Implem.Max_Reassembly_Size   :=
+        Types.Unsigned_Long (Get_Conf
+          (To_Standard_String (Implem.Section),
+           Get_Conf_Chain (Implem) & ".max_reassembly_size",
+           Default_Max_Reassembly_Size_1_2));
    end Initialize_Implem;
 
    ------------------------
@@ -199,15 +204,34 @@ package body PolyORB.Protocols.GIOP.GIOP_1_2 is
       pragma Unreferenced (Implem);
       pragma Warnings (On);
 
+      use GIOP_Message_Context_Lists;
+
       Sess : GIOP_Session renames GIOP_Session (S.all);
       MCtx : GIOP_Message_Context_1_2
                renames GIOP_Message_Context_1_2 (Sess.MCtx.all);
+      SCtx : GIOP_Session_Context_1_2
+               renames GIOP_Session_Context_1_2 (Sess.SCtx.all);
+
+      It     : Iterator := First (SCtx.Reassembly_Contexts);
+      U_MCtx : GIOP_Message_Context_Access;
    begin
       if MCtx.Frag_Buf /= null then
          Release (MCtx.Frag_Buf);
       end if;
       Free (Sess.MCtx);
 
+      --  Release messages whose reassembly was interrupted
+
+      while not Last (It) loop
+         U_MCtx := Value (It).all;
+         if GIOP_Message_Context_1_2 (U_MCtx.all).Frag_Buf /= null then
+            Release (GIOP_Message_Context_1_2 (U_MCtx.all).Frag_Buf);
+         end if;
+         Free (U_MCtx);
+         Next (It);
+      end loop;
+      Deallocate (SCtx.Reassembly_Contexts);
+
       Release
         (QoS_Parameter_Access
            (GIOP_Session_Context_1_2 (Sess.SCtx.all).CS_Context));
@@ -356,6 +380,28 @@ package body PolyORB.Protocols.GIOP.GIOP_1_2 is
                   pragma Debug (C, O ("Request ID :" & MCtx.Request_Id'Img));
                   pragma Debug (C, O ("Frag Size  :" & MCtx.Frag_Size'Img));
 
+                  --  Check that the reassembled message stays within
+                  --  bounds before receiving any more of it. This applies
+                  --  to the body of the first fragment as well, since the
+                  --  First state falls through to this one. The test is
+                  --  Message_Size + Frag_Size > Max_Reassembly_Size,
+                  --  written so that it cannot wrap around. If it fails,
+                  --  give up on the whole connection: the rest of the
+                  --  message cannot be skipped reliably, since fragments
+                  --  of other messages may be interleaved with it.
+
+                  if MCtx.Frag_Size > Implem.Max_Reassembly_Size
+                    or else GMC_1_2 (U_MCtx.all).Message_Size
+                              > Implem.Max_Reassembly_Size - MCtx.Frag_Size
+                  then
+                     O ("fragmented message exceeds max_reassembly_size ("
+                        & Implem.Max_Reassembly_Size'Img & "), request id"
+                        & MCtx.Request_Id'Img, Notice);
+                     Release (GMC_1_2 (U_MCtx.all).Frag_Buf);
+                     Remove_Reassembly_Context (SCtx'Access, U_MCtx);
+                     raise GIOP_Error;
+                  end if;
+
                   if MCtx.Frag_Size > 0 then
                      --  Receive fragment body into reassembly buffer
 
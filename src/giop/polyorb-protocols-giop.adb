@@ -170,7 +170,8 @@ package body PolyORB.Protocols.GIOP is
       --  All pending requests have been flushed, and its state has been
       --  reset to Not_Initialized.
 
-      Pend_Req_Tables.Deallocate (S.Pending_Reqs);
+      Pend_Req_Maps.Deallocate (S.Pending_Reqs);
+      Pend_Req_Maps.Deallocate (S.Pending_Locates);
       Destroy (S.Mutex);
 
       if S.Buffer_In /= null then
@@ -337,60 +338,73 @@ package body PolyORB.Protocols.GIOP is
    overriding procedure Handle_Disconnect
      (Sess : access GIOP_Session; Error : Errors.Error_Container)
    is
-      use Pend_Req_Tables;
-      P   : Pending_Request_Access;
       ORB : constant ORB_Access := ORB_Access (Sess.Server);
 
-   begin
-      pragma Debug (C, O ("Handle_Disconnect: enter"));
-
-      Enter (Sess.Mutex);
+      procedure Flush_Pending_Request
+        (Id : Types.Unsigned_Long;
+         P  : Pending_Request_Access);
+      --  Complete or abort P, and deallocate it
 
-      Sess.State := Not_Initialized;
+      procedure Flush_Pending_Requests is
+        new Pend_Req_Maps.Iterate (Flush_Pending_Request);
 
-      if Sess.Buffer_In /= null then
-         Release (Sess.Buffer_In);
-      end if;
+      ---------------------------
+      -- Flush_Pending_Request --
+      ---------------------------
 
-      for J in First (Sess.Pending_Reqs) .. Last (Sess.Pending_Reqs) loop
-         if Sess.Pending_Reqs.Table /= null
-           and then Sess.Pending_Reqs.Table (J) /= null
-         then
-            P := Sess.Pending_Reqs.Table (J);
-            Sess.Pending_Reqs.Table (J) := null;
+      procedure Flush_Pending_Request
+        (Id : Types.Unsigned_Long;
+         P  : Pending_Request_Access)
+      is
+         pragma Unreferenced (Id);
 
-            if Sess.Role = Client then
-               --  Client case: return with exception
+         P_Copy : Pending_Request_Access := P;
+      begin
+         if Sess.Role = Client then
+            --  Client case: return with exception
 
-               Set_Exception (P.Req.all, Error);
-               References.Binding.Unbind (P.Req.Target);
+            Set_Exception (P.Req.all, Error);
+            References.Binding.Unbind (P.Req.Target);
 
-               --  After the following call, P.Req is destroyed
+            --  After the following call, P.Req is destroyed
 
-               Emit_No_Reply (Component_Access (ORB),
-                              Servants.Iface.Executed_Request'(Req => P.Req));
+            Emit_No_Reply (Component_Access (ORB),
+                           Servants.Iface.Executed_Request'(Req => P.Req));
 
-            else
-               if P.Req.Surrogate /= null then
-                  --  Note: Req can't disappear from under our feet, because
-                  --  its destruction is preceded by a call to Send_Reply,
-                  --  which takes Sess.Mutex.
+         else
+            if P.Req.Surrogate /= null then
+               --  Note: Req can't disappear from under our feet, because
+               --  its destruction is preceded by a call to Send_Reply,
+               --  which takes Sess.Mutex.
 
-                  --  Server case: abort upcall, ORB will clean up the request
+               --  Server case: abort upcall, ORB will clean up the request
 
-                  Emit_No_Reply
-                    (P.Req.Surrogate,
-                     Servants.Iface.Abort_Request'(Req => P.Req));
-               end if;
+               Emit_No_Reply
+                 (P.Req.Surrogate,
+                  Servants.Iface.Abort_Request'(Req => P.Req));
             end if;
-
-            Free (P);
          end if;
-      end loop;
 
-      --  All pending request entries have been cleared: reset table
+         Free (P_Copy);
+      end Flush_Pending_Request;
 
-      Set_Last (Sess.Pending_Reqs, First (Sess.Pending_Reqs) - 1);
+   begin
+      pragma Debug (C, O ("Handle_Disconnect: enter"));
+
+      Enter (Sess.Mutex);
+
+      Sess.State := Not_Initialized;
+
+      if Sess.Buffer_In /= null then
+         Release (Sess.Buffer_In);
+      end if;
+
+      Flush_Pending_Requests (Sess.Pending_Reqs);
+
+      --  All pending request entries have been cleared: reset maps
+
+      Pend_Req_Maps.Clear (Sess.Pending_Reqs);
+      Pend_Req_Maps.Clear (Sess.Pending_Locates);
 
       Leave (Sess.Mutex);
       pragma Debug (C, O ("Handle_Disconnect: leave"));
@@ -456,12 +470,14 @@ package body PolyORB.Protocols.GIOP is
 
       if Sess.Implem.Locate_Then_Request then
          New_Pending_Req.Locate_Req_Id := Get_Request_Id (Sess);
-         Add_Pending_Request (Sess, New_Pending_Req);
+         Add_Pending_Request (Sess, New_Pending_Req, Success);
+         pragma Assert (Success);
          Leave (Sess.Mutex);
          Locate_Object (Sess.Implem, Sess, New_Pending_Req, Error);
 
       else
-         Add_Pending_Request (Sess, New_Pending_Req);
+         Add_Pending_Request (Sess, New_Pending_Req, Success);
+         pragma Assert (Success);
          Leave (Sess.Mutex);
          Send_Request (Sess.Implem, Sess, New_Pending_Req, Error);
       end if;
@@ -525,6 +541,7 @@ package body PolyORB.Protocols.GIOP is
       Error   : in out Errors.Error_Container)
    is
       New_Pending_Req : Pending_Request_Access;
+      Success         : Boolean;
 
    begin
       if not Sess.Implem.Locate_Then_Request then
@@ -541,7 +558,8 @@ package body PolyORB.Protocols.GIOP is
       Enter (Sess.Mutex);
       New_Pending_Req.Request_Id    := Get_Request_Id (Sess);
       New_Pending_Req.Locate_Req_Id := Get_Request_Id (Sess);
-      Add_Pending_Request (Sess, New_Pending_Req);
+      Add_Pending_Request (Sess, New_Pending_Req, Success);
+      pragma Assert (Success);
       Leave (Sess.Mutex);
 
       Locate_Object (Sess.Implem, Sess, New_Pending_Req, Error);
@@ -894,23 +912,22 @@ package body PolyORB.Protocols.GIOP is
       Req     : out Pending_Request;
       Success : out Boolean)
    is
-      use Pend_Req_Tables;
+      P, Ignored : Pending_Request_Access;
    begin
       pragma Debug (C, O ("Retrieving pending request with id"
                        & Types.Unsigned_Long'Image (Id)));
 
-      Success := False;
+      Pend_Req_Maps.Remove (Sess.Pending_Reqs, Id, P);
+      Success := P /= null;
 
-      for J in First (Sess.Pending_Reqs) .. Last (Sess.Pending_Reqs) loop
-         if Sess.Pending_Reqs.Table (J) /= null
-           and then Sess.Pending_Reqs.Table (J).Request_Id = Id
-         then
-            Req := Sess.Pending_Reqs.Table (J).all;
-            Free (Sess.Pending_Reqs.Table (J));
-            Success := True;
-            exit;
+      if Success then
+         if P.Locate_Req_Id /= 0 then
+            Pend_Req_Maps.Remove
+              (Sess.Pending_Locates, P.Locate_Req_Id, Ignored);
          end if;
-      end loop;
+         Req := P.all;
+         Free (P);
+      end if;
    end Get_Pending_Request;
 
    -----------------------------------
@@ -924,29 +941,26 @@ package body PolyORB.Protocols.GIOP is
       Success : out Boolean;
       Remove  : Boolean)
    is
-      use Pend_Req_Tables;
+      Ignored : Pending_Request_Access;
    begin
       pragma Debug (C, O ("Retrieving pending request with locate id"
                        & Types.Unsigned_Long'Image (L_Id)));
 
-      Success := False;
       Enter (Sess.Mutex);
 
-      for J in First (Sess.Pending_Reqs) .. Last (Sess.Pending_Reqs) loop
-         if Sess.Pending_Reqs.Table (J) /= null
-           and then Sess.Pending_Reqs.Table (J).Locate_Req_Id = L_Id
-         then
-            if Remove then
-               Free (Sess.Pending_Reqs.Table (J));
-            end if;
+      if Remove then
+         Pend_Req_Maps.Remove (Sess.Pending_Locates, L_Id, Req);
+      else
+         Req := Pend_Req_Maps.Lookup (Sess.Pending_Locates, L_Id);
+      end if;
+      Success := Req /= null;
 
-            --  Req is returned as null if found and removed
+      if Success and then Remove then
+         Pend_Req_Maps.Remove (Sess.Pending_Reqs, Req.Request_Id, Ignored);
+         Free (Req);
 
-            Req := Sess.Pending_Reqs.Table (J);
-            Success := True;
-            exit;
-         end if;
-      end loop;
+         --  Req is returned as null if found and removed
+      end if;
 
       Leave (Sess.Mutex);
    end Get_Pending_Request_By_Locate;
@@ -1004,28 +1018,36 @@ package body PolyORB.Protocols.GIOP is
 
    procedure Add_Pending_Request
      (Sess     : access GIOP_Session;
-      Pend_Req : Pending_Request_Access)
+      Pend_Req : Pending_Request_Access;
+      Success  : out Boolean)
    is
-      use Pend_Req_Tables;
+      Ignored_Req : Pending_Request_Access;
+
    begin
       pragma Debug (C, O ("Adding pending request with id"
                           & Pend_Req.Request_Id'Img));
-      Set_Note
-        (Pend_Req.Req.Notepad,
-         Request_Note'(Annotations.Note with Id => Pend_Req.Request_Id));
 
-      for J in First (Sess.Pending_Reqs) .. Last (Sess.Pending_Reqs) loop
-         if Sess.Pending_Reqs.Table (J) = null then
-            Sess.Pending_Reqs.Table (J) := Pend_Req;
+      Pend_Req_Maps.Insert
+        (Sess.Pending_Reqs, Pend_Req.Request_Id, Pend_Req, Success);
+      if not Success then
+         pragma Debug (C, O ("Request id already pending"));
+         return;
+      end if;
+
+      if Pend_Req.Locate_Req_Id /= 0 then
+         Pend_Req_Maps.Insert
+           (Sess.Pending_Locates, Pend_Req.Locate_Req_Id, Pend_Req, Success);
+         if not Success then
+            pragma Debug (C, O ("Locate request id already pending"));
+            Pend_Req_Maps.Remove
+              (Sess.Pending_Reqs, Pend_Req.Request_Id, Ignored_Req);
             return;
          end if;
-      end loop;
-
-      --  Here if there was no available slot in the pending requests table:
-      --  allocate a new one.
+      end if;
 
-      Increment_Last (Sess.Pending_Reqs);
-      Sess.Pending_Reqs.Table (Last (Sess.Pending_Reqs)) := Pend_Req;
+      Set_Note
+        (Pend_Req.Req.Notepad,
+         Request_Note'(Annotations.Note with Id => Pend_Req.Request_Id));
    end Add_Pending_Request;
 
    --------------------
@@ -1035,9 +1057,21 @@ package body PolyORB.Protocols.GIOP is
    function Get_Request_Id
      (Sess : access GIOP_Session) return Types.Unsigned_Long
    is
-      R : constant Types.Unsigned_Long := Sess.Req_Index;
+      R : Types.Unsigned_Long;
    begin
-      Sess.Req_Index := Sess.Req_Index + 1;
+      loop
+         R := Sess.Req_Index;
+         Sess.Req_Index := Sess.Req_Index + 1;
+
+         --  Identifiers wrap around: skip those still used by requests
+         --  that have been pending for a full cycle of the counter. Locate
+         --  request ids share the counter, and 0 denotes the absence of a
+         --  locate request id.
+
+         exit when R /= 0
+           and then Pend_Req_Maps.Lookup (Sess.Pending_Reqs, R) = null
+           and then Pend_Req_Maps.Lookup (Sess.Pending_Locates, R) = null;
+      end loop;
       return R;
    end Get_Request_Id;
 
@@ -1102,13 +1136,25 @@ package body PolyORB.Protocols.GIOP is
       if not (Is_Set (Sync_None, Req.Req_Flags)
               or else Is_Set (Sync_With_Transport, Req.Req_Flags))
       then
-         Sess.Mutex.Enter;
-         Add_Pending_Request
-           (Sess, new Pending_Request'(Req            => Req,
-                                       Locate_Req_Id  => 0,
-                                       Request_Id     => Req_Id,
-                                       Target_Profile => null));
-         Sess.Mutex.Leave;
+         declare
+            Pend_Req : Pending_Request_Access :=
+              new Pending_Request'(Req            => Req,
+                                   Locate_Req_Id  => 0,
+                                   Request_Id     => Req_Id,
+                                   Target_Profile => null);
+            Success  : Boolean;
+         begin
+            Sess.Mutex.Enter;
+            Add_Pending_Request (Sess, Pend_Req, Success);
+            Sess.Mutex.Leave;
+
+            --  The client reused the id of a request that is still pending:
+            --  the new request is not recorded, and cannot be aborted.
+
+            if not Success then
+               Free (Pend_Req);
+            end if;
+         end;
       end if;
 
       Queue_Request_To_Handler (ORB_Access (Sess.Server),
@@ -171,6 +171,7 @@ package body PolyORB.Representations.CDR.GIOP_1_1 is
    begin
       Free (R.C_Converter);
       Free (R.W_Converter);
+      Release (CDR_Representation (R));
    end Release;
 
    --------------------
@@ -0,0 +1,317 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                 POLYORB.MOMA_P.PROVIDER.DELIVERY_QUEUES                  --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Exceptions;
+
+with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Tasking.Threads;
+
+package body PolyORB.MOMA_P.Provider.Delivery_Queues is
+
+   use Interfaces;
+
+   use PolyORB.Log;
+   use PolyORB.Tasking.Condition_Variables;
+   use PolyORB.Tasking.Mutexes;
+   use PolyORB.Tasking.Threads;
+
+   package L is new PolyORB.Log.Facility_Log ("moma.provider.delivery_queues");
+   procedure O (Message : Standard.String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   type Queue_Access is access all Delivery_Queue;
+
+   function Queue_Of (Q : Queue_Ref) return Queue_Access;
+   pragma Inline (Queue_Of);
+   --  Return the queue designated by Q
+
+   type Worker is new Runnable with record
+      Queue : Queue_Ref;
+   end record;
+
+   overriding procedure Run (W : not null access Worker);
+   --  Deliver the messages of W.Queue until it is closed
+
+   -----------
+   -- Close --
+   -----------
+
+   procedure Close (Q : Queue_Ref) is
+      DQ : constant Queue_Access := Queue_Of (Q);
+   begin
+      pragma Abort_Defer;
+      Enter (DQ.Lock);
+      DQ.Closed := True;
+      Broadcast (DQ.Not_Empty);
+      Broadcast (DQ.Not_Full);
+      Leave (DQ.Lock);
+   end Close;
+
+   ------------
+   -- Create --
+   ------------
+
+   function Create
+     (Pool    : MOMA.Destinations.Destination;
+      Deliver : Deliver_Procedure) return Queue_Ref
+   is
+      Policy_Name : constant String :=
+        PolyORB.Parameters.Get_Conf
+          ("moma", "fanout_overflow_policy", "drop_oldest");
+      Size        : constant Integer :=
+        PolyORB.Parameters.Get_Conf ("moma", "fanout_queue_size", 256);
+
+      DQ     : constant Queue_Access :=
+        new Delivery_Queue (Capacity => Positive'Max (1, Size));
+      Result : Queue_Ref;
+      W      : Runnable_Access := new Worker;
+
+   begin
+      DQ.Pool    := Pool;
+      DQ.Deliver := Deliver;
+
+      --  By default, a slow pool loses its oldest messages rather than
+      --  holding up the publisher and the other pools of the topic.
+
+      if Policy_Name = "block" then
+         DQ.Policy := Block;
+      elsif Policy_Name = "disconnect" then
+         DQ.Policy := Disconnect;
+      else
+         if Policy_Name /= "drop_oldest" then
+            O ("Unknown fanout_overflow_policy " & Policy_Name
+              & ", using drop_oldest", Warning);
+         end if;
+         DQ.Policy := Drop_Oldest;
+      end if;
+
+      Create (DQ.Lock);
+      Create (DQ.Not_Empty);
+      Create (DQ.Not_Full);
+      Set (Result, PolyORB.Smart_Pointers.Entity_Ptr (DQ));
+
+      Worker (W.all).Queue := Result;
+      begin
+         declare
+            T : constant Thread_Access :=
+              Run_In_Task
+                (TF   => Get_Thread_Factory,
+                 Name => "moma_delivery",
+                 R    => W);
+            pragma Unreferenced (T);
+         begin
+            DQ.Threaded := True;
+         end;
+      exception
+         when Tasking_Error =>
+            pragma Debug (C, O ("No delivery task, delivering to "
+              & MOMA.Destinations.Image (Pool) & " synchronously"));
+            Free (W);
+      end;
+
+      return Result;
+   end Create;
+
+   -------------
+   -- Enqueue --
+   -------------
+
+   procedure Enqueue
+     (Q        : Queue_Ref;
+      Message  : PolyORB.Any.Any;
+      Accepted : out Boolean)
+   is
+      DQ      : constant Queue_Access := Queue_Of (Q);
+      Nothing : PolyORB.Any.Any;
+
+   begin
+      pragma Abort_Defer;
+      Accepted := True;
+
+      if not DQ.Threaded then
+         DQ.Deliver (MOMA.Destinations.Get_Ref (DQ.Pool), Message);
+         return;
+      end if;
+
+      Enter (DQ.Lock);
+
+      loop
+         if DQ.Closed then
+            Leave (DQ.Lock);
+            return;
+         end if;
+
+         exit when DQ.Count < DQ.Capacity;
+
+         case DQ.Policy is
+            when Drop_Oldest =>
+               DQ.Messages (DQ.First) := Nothing;
+               DQ.First := DQ.First mod DQ.Capacity + 1;
+               DQ.Count := DQ.Count - 1;
+               DQ.Dropped := DQ.Dropped + 1;
+
+               --  Report the first drop, then only when the number of
+               --  drops reaches a power of 2, so that a pool that keeps
+               --  falling behind does not flood the log.
+
+               if (DQ.Dropped and (DQ.Dropped - 1)) = 0 then
+                  O ("Delivery queue of "
+                    & MOMA.Destinations.Image (DQ.Pool)
+                    & " is full," & DQ.Dropped'Img
+                    & " message(s) dropped so far", Notice);
+               end if;
+
+            when Block =>
+               Wait (DQ.Not_Full, DQ.Lock);
+
+            when Disconnect =>
+               O ("Delivery queue of "
+                 & MOMA.Destinations.Image (DQ.Pool)
+                 & " is full, disconnecting", Warning);
+               DQ.Closed := True;
+               Broadcast (DQ.Not_Empty);
+               Broadcast (DQ.Not_Full);
+               Accepted := False;
+               Leave (DQ.Lock);
+               return;
+         end case;
+      end loop;
+
+      DQ.Messages ((DQ.First + DQ.Count - 1) mod DQ.Capacity + 1) := Message;
+      DQ.Count := DQ.Count + 1;
+      Signal (DQ.Not_Empty);
+      Leave (DQ.Lock);
+   end Enqueue;
+
+   ----------------------
+   -- Dropped_Messages --
+   ----------------------
+
+   function Dropped_Messages (Q : Queue_Ref) return Unsigned_64 is
+      DQ     : constant Queue_Access := Queue_Of (Q);
+      Result : Unsigned_64;
+   begin
+      pragma Abort_Defer;
+      Enter (DQ.Lock);
+      Result := DQ.Dropped;
+      Leave (DQ.Lock);
+      return Result;
+   end Dropped_Messages;
+
+   --------------
+   -- Finalize --
+   --------------
+
+   overriding procedure Finalize (X : in out Delivery_Queue) is
+   begin
+      if X.Dropped > 0 then
+         O ("Delivery queue of " & MOMA.Destinations.Image (X.Pool)
+           & " finalized," & X.Dropped'Img & " message(s) dropped",
+           Notice);
+      end if;
+      pragma Debug (C, O ("Finalizing delivery queue of "
+        & MOMA.Destinations.Image (X.Pool)));
+
+      Destroy (X.Not_Full);
+      Destroy (X.Not_Empty);
+      Destroy (X.Lock);
+   end Finalize;
+
+   --------------
+   -- Get_Pool --
+   --------------
+
+   function Get_Pool (Q : Queue_Ref) return MOMA.Destinations.Destination is
+   begin
+      return Queue_Of (Q).Pool;
+   end Get_Pool;
+
+   --------------
+   -- Queue_Of --
+   --------------
+
+   function Queue_Of (Q : Queue_Ref) return Queue_Access is
+   begin
+      return Queue_Access (Entity_Of (Q));
+   end Queue_Of;
+
+   ---------
+   -- Run --
+   ---------
+
+   overriding procedure Run (W : not null access Worker) is
+      DQ      : constant Queue_Access := Queue_Of (W.Queue);
+      Message : PolyORB.Any.Any;
+      Nothing : PolyORB.Any.Any;
+
+   begin
+      loop
+         Enter (DQ.Lock);
+         while DQ.Count = 0 and then not DQ.Closed loop
+            Wait (DQ.Not_Empty, DQ.Lock);
+         end loop;
+
+         if DQ.Closed then
+            Leave (DQ.Lock);
+            exit;
+         end if;
+
+         Message := DQ.Messages (DQ.First);
+         DQ.Messages (DQ.First) := Nothing;
+         DQ.First := DQ.First mod DQ.Capacity + 1;
+         DQ.Count := DQ.Count - 1;
+         Signal (DQ.Not_Full);
+         Leave (DQ.Lock);
+
+         begin
+            DQ.Deliver (MOMA.Destinations.Get_Ref (DQ.Pool), Message);
+         exception
+            when E : others =>
+               O ("Delivery to " & MOMA.Destinations.Image (DQ.Pool)
+                 & " failed: " & Ada.Exceptions.Exception_Information (E),
+                 Warning);
+         end;
+         Message := Nothing;
+      end loop;
+
+      pragma Debug (C, O ("Delivery task for "
+        & MOMA.Destinations.Image (DQ.Pool) & " terminated"));
+
+      --  W.Queue is released when W is deallocated by the tasking runtime
+   end Run;
+
+end PolyORB.MOMA_P.Provider.Delivery_Queues;
@@ -0,0 +1,1070 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--  P O L Y O R B . M O M A _ P . P R O V I D E R . M E S S A G E _ L O G   --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Directories;
+with Ada.Unchecked_Deallocation;
+
+with Interfaces.C;
+
+with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Tasking.Threads;
+
+package body PolyORB.MOMA_P.Provider.Message_Log is
+
+   use Ada.Streams;
+   use Interfaces;
+
+   use PolyORB.Log;
+   use PolyORB.Tasking.Condition_Variables;
+   use PolyORB.Tasking.Mutexes;
+   use PolyORB.Utils.Strings;
+
+   use type Interfaces.C.int;
+   use type OS.File_Descriptor;
+
+   package L is new PolyORB.Log.Facility_Log ("moma.provider.message_log");
+   procedure O (Message : Standard.String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   --  A record is made of a header, followed by the characters of the key
+   --  and by the data of the message. The header holds the kind of the
+   --  record (1 octet), an unused octet, the length of the key (2 octets),
+   --  the length of the data (4 octets) and a checksum of the kind, key and
+   --  data (4 octets), all in big endian byte order. Acknowledgement records
+   --  have no data.
+
+   Header_Length : constant := 12;
+
+   Message_Record : constant Stream_Element := Character'Pos ('M');
+   Ack_Record     : constant Stream_Element := Character'Pos ('A');
+
+   Max_Key_Length : constant := 2 ** 16 - 1;
+
+   type Record_Header is record
+      Kind        : Stream_Element;
+      Key_Length  : Natural;
+      Data_Length : Natural;
+      Checksum    : Unsigned_32;
+   end record;
+
+   type Contents_Access is access Stream_Element_Array;
+   --  The key and data of a record
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Stream_Element_Array, Contents_Access);
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Segment_Type, Segment_Access);
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Log_Type, Log_Access);
+
+   type Flusher_Runnable is new PolyORB.Tasking.Threads.Runnable with record
+      Log : Log_Access;
+   end record;
+
+   overriding procedure Run (R : not null access Flusher_Runnable);
+   --  Main loop of the task that synchronizes the records appended to R.Log
+   --  at least every Fsync_Delay, until the log is closed.
+
+   function C_Sync (FD : OS.File_Descriptor) return Interfaces.C.int;
+   pragma Import (C, C_Sync, "__PolyORB_log_sync");
+
+   function C_Truncate
+     (FD     : OS.File_Descriptor;
+      Length : Interfaces.C.long_long) return Interfaces.C.int;
+   pragma Import (C, C_Truncate, "__PolyORB_log_truncate");
+
+   function Append_Record
+     (Log  : Log_Access;
+      Kind : Stream_Element;
+      Key  : String;
+      Data : Stream_Element_Array) return Log_Offset;
+   --  Write a record at the end of the current segment of Log, starting a
+   --  new segment first if the record does not fit in the current one, and
+   --  return its offset. Must be called with Log.Lock held.
+
+   function Checksum
+     (Kind : Stream_Element;
+      Key  : String;
+      Data : Stream_Element_Array) return Unsigned_32;
+   --  FNV-1a hash of the contents of a record
+
+   procedure Compact (Log : Log_Access);
+   --  Delete the oldest segments of Log while they hold no live message,
+   --  relocating the live messages of a sparse oldest segment beforehand.
+   --  Must be called with Log.Lock held.
+
+   function Create_Segment
+     (Log  : Log_Access;
+      Base : Log_Offset) return Segment_Access;
+   --  Open the file of the segment of Log starting at Base, creating it if
+   --  needed. The Size of the result is the size of the file.
+
+   function Data_Of
+     (Header   : Record_Header;
+      Contents : Stream_Element_Array) return Stream_Element_Array;
+   function Key_Of
+     (Header   : Record_Header;
+      Contents : Stream_Element_Array) return String;
+   --  Extract the data and key of a record from its contents
+
+   procedure Delete_Segment (Log : Log_Access);
+   --  Delete the oldest segment of Log and its file
+
+   procedure Index_Message
+     (Log    : Log_Access;
+      Key    : String;
+      Offset : Log_Offset);
+   --  Record that the message record at Offset is the live message for Key
+
+   procedure Read_Record
+     (S        : Segment_Access;
+      Position : Log_Offset;
+      Header   : out Record_Header;
+      Contents : out Contents_Access);
+   --  Read the record at Position in S. Contents is set to null if the
+   --  record is incomplete or corrupted. Otherwise the caller must free it.
+
+   function Record_Length (Header : Record_Header) return Log_Offset;
+   --  Length of a record including its header
+
+   procedure Relocate (Log : Log_Access; S : Segment_Access);
+   --  Copy the live messages of S to the end of Log
+
+   procedure Release_Message (Log : Log_Access; Offset : Log_Offset);
+   --  Record that the message at Offset is no longer live
+
+   procedure Replay (Log : Log_Access; S : Segment_Access);
+   --  Rebuild the index of Log from the records of S, and truncate S
+   --  after its last valid record.
+
+   function Segment_Name
+     (Log  : Log_Access;
+      Base : Log_Offset) return String;
+   --  Name of the file of the segment of Log starting at Base
+
+   function Segment_Of
+     (Log    : Log_Access;
+      Offset : Log_Offset) return Segment_Access;
+   --  Return the segment of Log that holds Offset, or null if there is none
+
+   procedure Sync_Segment (S : Segment_Access);
+   --  Synchronize the file of S to disk, raising Log_Error on failure
+
+   procedure Wait_For_Sync (Log : Log_Access; Count : Unsigned_64);
+   --  Return once the first Count records appended to Log are on disk. Must
+   --  be called with Log.Lock held, which is released while the segment is
+   --  synchronized.
+
+   -----------------
+   -- Acknowledge --
+   -----------------
+
+   procedure Acknowledge (Log : Log_Access; Key : String) is
+      Old : Log_Offset;
+
+   begin
+      pragma Abort_Defer;
+      Enter (Log.Lock);
+
+      Old := Offset_HTables.Lookup (Log.Index, Key, No_Offset);
+      if Old = No_Offset then
+         Leave (Log.Lock);
+         raise Not_Found;
+      end if;
+
+      begin
+         --  Acknowledgement records are not waited for: if one is lost in a
+         --  crash, the message is only delivered again.
+
+         declare
+            Ack : constant Log_Offset := Append_Record
+              (Log, Ack_Record, Key, Stream_Element_Array'(1 .. 0 => 0));
+            pragma Unreferenced (Ack);
+         begin
+            Offset_HTables.Delete (Log.Index, Key);
+         end;
+         Release_Message (Log, Old);
+         Compact (Log);
+      exception
+         when others =>
+            Leave (Log.Lock);
+            raise;
+      end;
+
+      Leave (Log.Lock);
+   end Acknowledge;
+
+   ------------
+   -- Append --
+   ------------
+
+   procedure Append
+     (Log    : Log_Access;
+      Key    : String;
+      Data   : Ada.Streams.Stream_Element_Array;
+      Offset : out Log_Offset)
+   is
+   begin
+      pragma Abort_Defer;
+
+      if Key'Length > Max_Key_Length
+        or else Data'Length > Stream_Element_Offset (Natural'Last)
+      then
+         raise Constraint_Error;
+      end if;
+
+      Enter (Log.Lock);
+
+      begin
+         Offset := Append_Record (Log, Message_Record, Key, Data);
+         Index_Message (Log, Key, Offset);
+
+         if Log.Fsync_Batch > 0
+           and then Log.Appended - Log.Synced >= Unsigned_64 (Log.Fsync_Batch)
+         then
+            Wait_For_Sync (Log, Log.Appended);
+         end if;
+      exception
+         when others =>
+            Leave (Log.Lock);
+            raise;
+      end;
+
+      Leave (Log.Lock);
+   end Append;
+
+   -------------------
+   -- Append_Record --
+   -------------------
+
+   function Append_Record
+     (Log  : Log_Access;
+      Kind : Stream_Element;
+      Key  : String;
+      Data : Stream_Element_Array) return Log_Offset
+   is
+      Rec : Stream_Element_Array
+        (1 .. Header_Length + Key'Length + Data'Length);
+      Sum : constant Unsigned_32 := Checksum (Kind, Key, Data);
+      S   : Segment_Access := Log.Current;
+
+   begin
+      Rec (1) := Kind;
+      Rec (2) := 0;
+      Rec (3) := Stream_Element (Key'Length / 256);
+      Rec (4) := Stream_Element (Key'Length mod 256);
+      for J in 0 .. 3 loop
+         Rec (5 + Stream_Element_Offset (J)) := Stream_Element
+           (Shift_Right (Unsigned_32 (Data'Length), 8 * (3 - J)) and 16#FF#);
+         Rec (9 + Stream_Element_Offset (J)) := Stream_Element
+           (Shift_Right (Sum, 8 * (3 - J)) and 16#FF#);
+      end loop;
+      for J in Key'Range loop
+         Rec (Header_Length + 1 + Stream_Element_Offset (J - Key'First)) :=
+           Character'Pos (Key (J));
+      end loop;
+      Rec (Header_Length + Key'Length + 1 .. Rec'Last) := Data;
+
+      if S.Size > 0 and then S.Size + Rec'Length > Log.Segment_Size then
+
+         --  Start a new segment. Only the current segment is synchronized
+         --  by Wait_For_Sync, so the records of the previous one must be
+         --  on disk first.
+
+         if Log.Fsync_Batch > 0 then
+            Sync_Segment (S);
+         end if;
+
+         S := Create_Segment (Log, S.Base + S.Size);
+         Segment_Lists.Append (Log.Segments, S);
+         Log.Current := S;
+
+         pragma Debug (C, O ("Started segment at" & S.Base'Img));
+      end if;
+
+      OS.Lseek (S.FD, Long_Integer (S.Size), OS.Seek_Set);
+      if OS.Write (S.FD, Rec'Address, Rec'Length) /= Rec'Length then
+
+         --  Do not leave a partial record at the end of the segment
+
+         if C_Truncate (S.FD, Interfaces.C.long_long (S.Size)) /= 0 then
+            O ("Cannot truncate segment at" & S.Base'Img, Error);
+         end if;
+         raise Log_Error;
+      end if;
+
+      S.Size := S.Size + Rec'Length;
+      Log.Appended := Log.Appended + 1;
+      return S.Base + S.Size - Rec'Length;
+   end Append_Record;
+
+   --------------
+   -- Checksum --
+   --------------
+
+   function Checksum
+     (Kind : Stream_Element;
+      Key  : String;
+      Data : Stream_Element_Array) return Unsigned_32
+   is
+      Prime  : constant Unsigned_32 := 16#0100_0193#;
+      Result : Unsigned_32 := 16#811C_9DC5#;
+
+   begin
+      Result := (Result xor Unsigned_32 (Kind)) * Prime;
+      for J in Key'Range loop
+         Result := (Result xor Character'Pos (Key (J))) * Prime;
+      end loop;
+      for J in Data'Range loop
+         Result := (Result xor Unsigned_32 (Data (J))) * Prime;
+      end loop;
+      return Result;
+   end Checksum;
+
+   -----------
+   -- Close --
+   -----------
+
+   procedure Close (Log : in out Log_Access) is
+      S : Segment_Access;
+
+   begin
+      if Log = null then
+         return;
+      end if;
+
+      --  Stop the task enforcing Fsync_Delay, if any
+
+      Enter (Log.Lock);
+      Log.Closing := True;
+      while Log.Flushing loop
+         Wait (Log.Synced_Cond, Log.Lock);
+      end loop;
+      Leave (Log.Lock);
+
+      Sync (Log);
+
+      while not Segment_Lists.Is_Empty (Log.Segments) loop
+         Segment_Lists.Extract_First (Log.Segments, S);
+         OS.Close (S.FD);
+         Free (S);
+      end loop;
+
+      Offset_HTables.Finalize (Log.Index);
+      Destroy (Log.Synced_Cond);
+      Destroy (Log.Lock);
+      Free (Log.Prefix);
+      Free (Log);
+   end Close;
+
+   -------------
+   -- Compact --
+   -------------
+
+   procedure Compact (Log : Log_Access) is
+      S : Segment_Access;
+
+   begin
+      --  A segment is never deleted while the current segment is being
+      --  synchronized, since that segment may have become the oldest one
+      --  in the meantime.
+
+      while not Log.Syncing loop
+         S := Segment_Lists.Value (Segment_Lists.First (Log.Segments)).all;
+         exit when S = Log.Current;
+
+         if S.Live > 0
+           and then S.Live * 100 <= S.Messages * Log.Compaction_Ratio
+         then
+            Relocate (Log, S);
+         end if;
+         exit when S.Live > 0;
+
+         Delete_Segment (Log);
+      end loop;
+   end Compact;
+
+   --------------------
+   -- Create_Segment --
+   --------------------
+
+   function Create_Segment
+     (Log  : Log_Access;
+      Base : Log_Offset) return Segment_Access
+   is
+      Name : constant String := Segment_Name (Log, Base);
+      FD   : OS.File_Descriptor;
+
+   begin
+      FD := OS.Open_Read_Write (Name, OS.Binary);
+      if FD = OS.Invalid_FD then
+         FD := OS.Create_File (Name, OS.Binary);
+         if FD /= OS.Invalid_FD then
+            OS.Close (FD);
+            FD := OS.Open_Read_Write (Name, OS.Binary);
+         end if;
+      end if;
+
+      if FD = OS.Invalid_FD then
+         O ("Cannot open log segment " & Name, Error);
+         raise Log_Error;
+      end if;
+
+      return new Segment_Type'
+        (Base     => Base,
+         FD       => FD,
+         Size     => Log_Offset (OS.File_Length (FD)),
+         Messages => 0,
+         Live     => 0);
+   end Create_Segment;
+
+   -------------
+   -- Data_Of --
+   -------------
+
+   function Data_Of
+     (Header   : Record_Header;
+      Contents : Stream_Element_Array) return Stream_Element_Array is
+   begin
+      return Contents
+        (Contents'First + Stream_Element_Offset (Header.Key_Length)
+         .. Contents'Last);
+   end Data_Of;
+
+   --------------------
+   -- Delete_Segment --
+   --------------------
+
+   procedure Delete_Segment (Log : Log_Access) is
+      S       : Segment_Access;
+      Success : Boolean;
+
+   begin
+      Segment_Lists.Extract_First (Log.Segments, S);
+      OS.Close (S.FD);
+
+      OS.Delete_File (Segment_Name (Log, S.Base), Success);
+      if not Success then
+         O ("Cannot delete log segment at" & S.Base'Img, Warning);
+      end if;
+
+      pragma Debug (C, O ("Deleted segment at" & S.Base'Img));
+      Free (S);
+   end Delete_Segment;
+
+   ----------
+   -- Find --
+   ----------
+
+   function Find (Log : Log_Access; Key : String) return Log_Offset is
+      Result : Log_Offset;
+
+   begin
+      pragma Abort_Defer;
+      Enter (Log.Lock);
+      Result := Offset_HTables.Lookup (Log.Index, Key, No_Offset);
+      Leave (Log.Lock);
+      return Result;
+   end Find;
+
+   -------------------
+   -- Index_Message --
+   -------------------
+
+   procedure Index_Message
+     (Log    : Log_Access;
+      Key    : String;
+      Offset : Log_Offset)
+   is
+      Old : constant Log_Offset :=
+        Offset_HTables.Lookup (Log.Index, Key, No_Offset);
+      S   : constant Segment_Access := Segment_Of (Log, Offset);
+
+   begin
+      if Old /= No_Offset then
+         Release_Message (Log, Old);
+         Offset_HTables.Delete (Log.Index, Key);
+      end if;
+
+      Offset_HTables.Insert (Log.Index, Key, Offset);
+      S.Messages := S.Messages + 1;
+      S.Live := S.Live + 1;
+   end Index_Message;
+
+   ------------
+   -- Key_Of --
+   ------------
+
+   function Key_Of
+     (Header   : Record_Header;
+      Contents : Stream_Element_Array) return String
+   is
+      Result : String (1 .. Header.Key_Length);
+
+   begin
+      for J in Result'Range loop
+         Result (J) := Character'Val
+           (Contents (Contents'First + Stream_Element_Offset (J - 1)));
+      end loop;
+      return Result;
+   end Key_Of;
+
+   ----------
+   -- Open --
+   ----------
+
+   function Open (Name : String) return Log_Access is
+      use Ada.Directories;
+
+      package Offset_Lists is new PolyORB.Utils.Chained_Lists (Log_Offset);
+
+      Dir : constant String :=
+        PolyORB.Parameters.Get_Conf ("moma", "log_directory", ".");
+
+      Log    : constant Log_Access := new Log_Type;
+      Bases  : Offset_Lists.List;
+      Search : Search_Type;
+      Item   : Directory_Entry_Type;
+
+   begin
+      Log.Segment_Size := Log_Offset
+        (PolyORB.Parameters.Get_Conf
+         ("moma", "log_segment_size", 16 * 1024 * 1024));
+      Log.Fsync_Batch :=
+        PolyORB.Parameters.Get_Conf ("moma", "log_fsync_batch", 1);
+      Log.Fsync_Delay :=
+        PolyORB.Parameters.Get_Conf ("moma", "log_fsync_delay", 0.1);
+      Log.Compaction_Ratio :=
+        PolyORB.Parameters.Get_Conf ("moma", "log_compaction_ratio", 25);
+
+      if not Exists (Dir) then
+         Create_Path (Dir);
+      end if;
+      Log.Prefix := new String'(Compose (Dir, Name));
+
+      Create (Log.Lock);
+      Create (Log.Synced_Cond);
+      Offset_HTables.Initialize (Log.Index);
+
+      --  Find the existing segments of the log
+
+      Start_Search (Search, Dir, Name & "-*.log",
+                    (Ordinary_File => True, others => False));
+      while More_Entries (Search) loop
+         Get_Next_Entry (Search, Item);
+
+         declare
+            Simple : constant String := Simple_Name (Item);
+            Image  : String renames
+              Simple (Simple'First + Name'Length + 1 .. Simple'Last - 4);
+            Valid  : Boolean := Image'Length = 20;
+         begin
+            for J in Image'Range loop
+               Valid := Valid and then Image (J) in '0' .. '9';
+            end loop;
+
+            if Valid then
+               Offset_Lists.Append (Bases, Log_Offset'Value (Image));
+            end if;
+         end;
+      end loop;
+      End_Search (Search);
+
+      --  Replay them in order of their base offset
+
+      while not Offset_Lists.Is_Empty (Bases) loop
+         declare
+            use Offset_Lists;
+
+            It  : Iterator := First (Bases);
+            Min : Log_Offset := Value (It).all;
+            S   : Segment_Access;
+         begin
+            while not Last (It) loop
+               Min := Log_Offset'Min (Min, Value (It).all);
+               Next (It);
+            end loop;
+            Remove_Occurrences (Bases, Min);
+
+            S := Create_Segment (Log, Min);
+            Segment_Lists.Append (Log.Segments, S);
+            Log.Current := S;
+            Replay (Log, S);
+         end;
+      end loop;
+
+      if Log.Current = null then
+         Log.Current := Create_Segment (Log, 0);
+         Segment_Lists.Append (Log.Segments, Log.Current);
+      end if;
+
+      pragma Debug (C, O ("Opened log " & Log.Prefix.all & " with"
+        & Natural'Image (Segment_Lists.Length (Log.Segments))
+        & " segment(s)"));
+
+      Compact (Log);
+
+      if Log.Fsync_Batch > 1 and then Log.Fsync_Delay > 0.0 then
+         declare
+            use PolyORB.Tasking.Threads;
+
+            T : constant Thread_Access := Run_In_Task
+              (TF   => Get_Thread_Factory,
+               Name => "moma_log_flusher",
+               R    => new Flusher_Runnable'(Log => Log));
+            pragma Unreferenced (T);
+         begin
+            Log.Flushing := True;
+         end;
+      end if;
+
+      return Log;
+   end Open;
+
+   ----------
+   -- Read --
+   ----------
+
+   function Read
+     (Log : Log_Access;
+      Key : String) return Ada.Streams.Stream_Element_Array
+   is
+      Offset : constant Log_Offset := Find (Log, Key);
+
+   begin
+      if Offset = No_Offset then
+         raise Not_Found;
+      end if;
+
+      --  The message may be acknowledged concurrently, in which case its
+      --  record may be gone as well and Read_At raises Not_Found.
+
+      return Read_At (Log, Offset);
+   end Read;
+
+   -------------
+   -- Read_At --
+   -------------
+
+   function Read_At
+     (Log    : Log_Access;
+      Offset : Log_Offset) return Ada.Streams.Stream_Element_Array
+   is
+      S        : Segment_Access;
+      Header   : Record_Header;
+      Contents : Contents_Access;
+
+   begin
+      pragma Abort_Defer;
+      Enter (Log.Lock);
+
+      S := Segment_Of (Log, Offset);
+      if S /= null then
+         Read_Record (S, Offset - S.Base, Header, Contents);
+      end if;
+
+      Leave (Log.Lock);
+
+      if Contents = null or else Header.Kind /= Message_Record then
+         Free (Contents);
+         raise Not_Found;
+      end if;
+
+      declare
+         Result : constant Stream_Element_Array :=
+           Data_Of (Header, Contents.all);
+      begin
+         Free (Contents);
+         return Result;
+      end;
+   end Read_At;
+
+   -----------------
+   -- Read_Record --
+   -----------------
+
+   procedure Read_Record
+     (S        : Segment_Access;
+      Position : Log_Offset;
+      Header   : out Record_Header;
+      Contents : out Contents_Access)
+   is
+      Raw     : Stream_Element_Array (1 .. Header_Length);
+      Success : Boolean;
+
+      procedure Read_All
+        (Data    : out Stream_Element_Array;
+         Success : out Boolean);
+      --  Read Data'Length octets from the current position of S into Data
+
+      function U32 (Data : Stream_Element_Array) return Unsigned_32;
+      --  Decode a big endian integer
+
+      --------------
+      -- Read_All --
+      --------------
+
+      procedure Read_All
+        (Data    : out Stream_Element_Array;
+         Success : out Boolean)
+      is
+      begin
+         Success := OS.Read (S.FD, Data'Address, Data'Length) = Data'Length;
+      end Read_All;
+
+      ---------
+      -- U32 --
+      ---------
+
+      function U32 (Data : Stream_Element_Array) return Unsigned_32 is
+         Result : Unsigned_32 := 0;
+      begin
+         for J in Data'Range loop
+            Result := Shift_Left (Result, 8) or Unsigned_32 (Data (J));
+         end loop;
+         return Result;
+      end U32;
+
+   begin
+      Contents := null;
+      Header := (Kind => 0, Key_Length => 0, Data_Length => 0, Checksum => 0);
+
+      if S.Size - Position < Header_Length then
+         return;
+      end if;
+
+      OS.Lseek (S.FD, Long_Integer (Position), OS.Seek_Set);
+      Read_All (Raw, Success);
+      if not Success
+        or else (Raw (1) /= Message_Record and then Raw (1) /= Ack_Record)
+        or else U32 (Raw (5 .. 8)) > Unsigned_32 (Natural'Last)
+      then
+         return;
+      end if;
+
+      Header :=
+        (Kind        => Raw (1),
+         Key_Length  => Natural (U32 (Raw (3 .. 4))),
+         Data_Length => Natural (U32 (Raw (5 .. 8))),
+         Checksum    => U32 (Raw (9 .. 12)));
+
+      if S.Size - Position < Record_Length (Header) then
+         return;
+      end if;
+
+      Contents := new Stream_Element_Array
+        (1 .. Stream_Element_Offset (Header.Key_Length + Header.Data_Length));
+
+      Read_All (Contents.all, Success);
+      if not Success
+        or else Checksum
+                  (Header.Kind,
+                   Key_Of (Header, Contents.all),
+                   Data_Of (Header, Contents.all)) /= Header.Checksum
+      then
+         Free (Contents);
+      end if;
+   end Read_Record;
+
+   -------------------
+   -- Record_Length --
+   -------------------
+
+   function Record_Length (Header : Record_Header) return Log_Offset is
+   begin
+      return Header_Length
+        + Log_Offset (Header.Key_Length) + Log_Offset (Header.Data_Length);
+   end Record_Length;
+
+   --------------
+   -- Relocate --
+   --------------
+
+   procedure Relocate (Log : Log_Access; S : Segment_Access) is
+      Position : Log_Offset := 0;
+      Header   : Record_Header;
+      Contents : Contents_Access;
+
+   begin
+      pragma Debug (C, O ("Relocating" & S.Live'Img & " message(s) of"
+        & " segment at" & S.Base'Img));
+
+      while S.Live > 0 and then Position < S.Size loop
+         Read_Record (S, Position, Header, Contents);
+         if Contents = null then
+            raise Log_Error;
+         end if;
+
+         if Header.Kind = Message_Record then
+            declare
+               Key : constant String := Key_Of (Header, Contents.all);
+            begin
+               if Offset_HTables.Lookup (Log.Index, Key, No_Offset)
+                 = S.Base + Position
+               then
+                  Index_Message
+                    (Log, Key, Append_Record
+                       (Log, Message_Record, Key,
+                        Data_Of (Header, Contents.all)));
+               end if;
+            end;
+         end if;
+
+         Free (Contents);
+         Position := Position + Record_Length (Header);
+      end loop;
+
+      --  The copies must be on disk before S is deleted
+
+      if Log.Fsync_Batch > 0 then
+         Sync_Segment (Log.Current);
+      end if;
+   end Relocate;
+
+   ---------------------
+   -- Release_Message --
+   ---------------------
+
+   procedure Release_Message (Log : Log_Access; Offset : Log_Offset) is
+      S : constant Segment_Access := Segment_Of (Log, Offset);
+   begin
+      if S /= null then
+         S.Live := S.Live - 1;
+      end if;
+   end Release_Message;
+
+   ------------
+   -- Replay --
+   ------------
+
+   procedure Replay (Log : Log_Access; S : Segment_Access) is
+      Position : Log_Offset := 0;
+      Header   : Record_Header;
+      Contents : Contents_Access;
+
+   begin
+      while Position < S.Size loop
+         Read_Record (S, Position, Header, Contents);
+         exit when Contents = null;
+
+         declare
+            Key : constant String := Key_Of (Header, Contents.all);
+            Old : Log_Offset;
+         begin
+            if Header.Kind = Message_Record then
+               Index_Message (Log, Key, S.Base + Position);
+            else
+               Old := Offset_HTables.Lookup (Log.Index, Key, No_Offset);
+               if Old /= No_Offset then
+                  Offset_HTables.Delete (Log.Index, Key);
+                  Release_Message (Log, Old);
+               end if;
+            end if;
+         end;
+
+         Free (Contents);
+         Position := Position + Record_Length (Header);
+      end loop;
+
+      if Position < S.Size then
+         O ("Truncating log segment at" & S.Base'Img & " after"
+           & Position'Img & " octets", Warning);
+
+         if C_Truncate (S.FD, Interfaces.C.long_long (Position)) /= 0 then
+            raise Log_Error;
+         end if;
+         S.Size := Position;
+      end if;
+   end Replay;
+
+   ---------
+   -- Run --
+   ---------
+
+   overriding procedure Run (R : not null access Flusher_Runnable) is
+      Log : constant Log_Access := R.Log;
+
+   begin
+      loop
+         PolyORB.Tasking.Threads.Relative_Delay (Log.Fsync_Delay);
+
+         Enter (Log.Lock);
+         exit when Log.Closing;
+
+         if Log.Synced < Log.Appended then
+            begin
+               Wait_For_Sync (Log, Log.Appended);
+            exception
+               when Log_Error =>
+
+                  --  Already reported by Sync_Segment: retry after the
+                  --  next delay.
+
+                  null;
+            end;
+         end if;
+         Leave (Log.Lock);
+      end loop;
+
+      Log.Flushing := False;
+      Broadcast (Log.Synced_Cond);
+      Leave (Log.Lock);
+   end Run;
+
+   ------------------
+   -- Segment_Name --
+   ------------------
+
+   function Segment_Name
+     (Log  : Log_Access;
+      Base : Log_Offset) return String
+   is
+      Image  : constant String := Log_Offset'Image (Base);
+      Padded : String (1 .. 20) := (others => '0');
+
+   begin
+      --  Pad the base offset so that the names of the segments sort in the
+      --  order of the log.
+
+      Padded (Padded'Last - Image'Length + 2 .. Padded'Last) :=
+        Image (Image'First + 1 .. Image'Last);
+      return Log.Prefix.all & "-" & Padded & ".log";
+   end Segment_Name;
+
+   ----------------
+   -- Segment_Of --
+   ----------------
+
+   function Segment_Of
+     (Log    : Log_Access;
+      Offset : Log_Offset) return Segment_Access
+   is
+      use Segment_Lists;
+
+      It : Iterator := First (Log.Segments);
+      S  : Segment_Access;
+
+   begin
+      while not Last (It) loop
+         S := Value (It).all;
+         if Offset >= S.Base and then Offset < S.Base + S.Size then
+            return S;
+         end if;
+         Next (It);
+      end loop;
+      return null;
+   end Segment_Of;
+
+   ----------
+   -- Sync --
+   ----------
+
+   procedure Sync (Log : Log_Access) is
+   begin
+      pragma Abort_Defer;
+      Enter (Log.Lock);
+
+      begin
+         Wait_For_Sync (Log, Log.Appended);
+      exception
+         when others =>
+            Leave (Log.Lock);
+            raise;
+      end;
+
+      Leave (Log.Lock);
+   end Sync;
+
+   ------------------
+   -- Sync_Segment --
+   ------------------
+
+   procedure Sync_Segment (S : Segment_Access) is
+   begin
+      if C_Sync (S.FD) /= 0 then
+         O ("Cannot synchronize log segment at" & S.Base'Img, Error);
+         raise Log_Error;
+      end if;
+   end Sync_Segment;
+
+   -------------------
+   -- Wait_For_Sync --
+   -------------------
+
+   procedure Wait_For_Sync (Log : Log_Access; Count : Unsigned_64) is
+   begin
+      while Log.Synced < Count loop
+         if Log.Syncing then
+
+            --  Another task is synchronizing the current segment: the
+            --  records it covers may include ours.
+
+            Wait (Log.Synced_Cond, Log.Lock);
+
+         else
+            --  Synchronize on behalf of all the tasks that have appended
+            --  records so far. Other tasks may append records while the
+            --  lock is released: they will be covered by the next
+            --  synchronization.
+
+            declare
+               Target : constant Unsigned_64 := Log.Appended;
+               S      : constant Segment_Access := Log.Current;
+            begin
+               Log.Syncing := True;
+               Leave (Log.Lock);
+
+               begin
+                  Sync_Segment (S);
+               exception
+                  when others =>
+                     Enter (Log.Lock);
+                     Log.Syncing := False;
+                     Broadcast (Log.Synced_Cond);
+                     raise;
+               end;
+
+               Enter (Log.Lock);
+               Log.Syncing := False;
+               Log.Synced := Unsigned_64'Max (Log.Synced, Target);
+               Broadcast (Log.Synced_Cond);
+            end;
+         end if;
+      end loop;
+   end Wait_For_Sync;
+
+end PolyORB.MOMA_P.Provider.Message_Log;
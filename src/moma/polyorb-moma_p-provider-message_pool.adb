@@ -257,7 +257,8 @@ package body PolyORB.MOMA_P.Provider.Message_Pool is
       Self.Pool := Info;
       PolyORB.MOMA_P.Provider.Warehouse.Set_Persistence
         (Self.W,
-         MOMA.Types.Get_Persistence (Info));
+         MOMA.Types.Get_Persistence (Info),
+         MOMA.Types.To_Standard_String (MOMA.Types.Get_Name (Info)));
 
    end Initialize;
 
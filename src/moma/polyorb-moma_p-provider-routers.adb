@@ -37,6 +37,7 @@ with MOMA.Messages;
 with PolyORB.Any.NVList;
 with PolyORB.Errors;
 with PolyORB.Log;
+with PolyORB.MOMA_P.Provider.Delivery_Queues;
 with PolyORB.Types;
 
 package body PolyORB.MOMA_P.Provider.Routers is
@@ -391,8 +392,7 @@ package body PolyORB.MOMA_P.Provider.Routers is
       Message          :        PolyORB.Any.Any;
       From_Router_Id   :        MOMA.Types.String := To_MOMA_String (""))
    is
-      Subscribers : Destination_List.List;
-      I           : Destination_List.Iterator;
+      Subscribers : Subscriber_Snapshot;
       Topic_Id    : MOMA.Types.String;
       Destination : MOMA.Destinations.Destination;
       Routers     : Destination_List.List;
@@ -420,15 +420,24 @@ package body PolyORB.MOMA_P.Provider.Routers is
       end loop;
       Destination_List.Deallocate (Routers);
 
-      --  Store Message into known pools subscribed to this topic.
+      --  Queue Message for delivery to the known pools subscribed to this
+      --  topic. Each pool is served by its own task, so this does not wait
+      --  for the pools to store the message.
 
-      Subscribers := Get_Subscribers (Self.Topics, Topic_Id);
-      I := Destination_List.First (Subscribers);
-      while not (Destination_List.Last (I)) loop
-         Store (Get_Ref (Destination_List.Value (I).all), Message);
-         Destination_List.Next (I);
+      Subscribers := Get_Snapshot (Self.Topics, Topic_Id);
+      for K in 1 .. Length (Subscribers) loop
+         declare
+            Queue    : constant Delivery_Queues.Queue_Ref :=
+              Element (Subscribers, K);
+            Accepted : Boolean;
+         begin
+            Delivery_Queues.Enqueue (Queue, Message, Accepted);
+
+            if not Accepted then
+               Remove_Queue (Self.Topics, Topic_Id, Queue);
+            end if;
+         end;
       end loop;
-      Destination_List.Deallocate (Subscribers);
    end Publish;
 
    --------------
@@ -591,7 +600,8 @@ package body PolyORB.MOMA_P.Provider.Routers is
       PolyORB.MOMA_P.Provider.Topic_Datas.Add_Subscriber
         (Self.Topics,
          Get_Name (Topic),
-         Pool);
+         Pool,
+         Store'Access);
    end Subscribe;
 
    -----------------
@@ -33,6 +33,8 @@
 --  A dynamic, protected dictionary of Topics, indexed by Strings.
 --  Such a dictionary is used by a router to retrieve topics informations.
 
+with Ada.Unchecked_Deallocation;
+
 with PolyORB.Log;
 
 package body PolyORB.MOMA_P.Provider.Topic_Datas is
@@ -42,7 +44,8 @@ package body PolyORB.MOMA_P.Provider.Topic_Datas is
    use MOMA.Types;
 
    use PolyORB.Log;
-   use PolyORB.Tasking.Rw_Locks;
+   use PolyORB.MOMA_P.Provider.Delivery_Queues;
+   use PolyORB.Tasking.Mutexes;
 
    package L is new PolyORB.Log.Facility_Log ("moma.provider.topic_datas");
    procedure O (Message : Standard.String; Level : Log_Level := Debug)
@@ -50,6 +53,27 @@ package body PolyORB.MOMA_P.Provider.Topic_Datas is
    function C (Level : Log_Level := Debug) return Boolean
      renames L.Enabled;
 
+   type Snapshot_Access is access all Snapshot_Entity;
+
+   procedure Free is new Ada.Unchecked_Deallocation (Topic, Topic_Access);
+
+   function New_Snapshot (Queues : Queue_Array) return Subscriber_Snapshot;
+   --  Return a new snapshot holding Queues.
+
+   function Snapshot_Of (S : Subscriber_Snapshot) return Snapshot_Access;
+   pragma Inline (Snapshot_Of);
+   --  Return the entity designated by S.
+
+   generic
+      with function Remove (Queue : Queue_Ref) return Boolean;
+   procedure Remove_Queues
+     (Data      : Topic_Data;
+      T         : String;
+      Found     : out Boolean);
+   --  Replace the snapshot of topic T with one that does not contain the
+   --  queues for which Remove returns True, and close these queues. Found
+   --  is set to False if there is no such topic.
+
    --------------------
    -- Add_Subscriber --
    --------------------
@@ -57,26 +81,42 @@ package body PolyORB.MOMA_P.Provider.Topic_Datas is
    procedure Add_Subscriber
      (Data      : Topic_Data;
       Topic_Id  : MOMA.Types.String;
-      Pool      : MOMA.Destinations.Destination)
+      Pool      : MOMA.Destinations.Destination;
+      Deliver   : Delivery_Queues.Deliver_Procedure)
    is
-      V : Topic;
-      T : constant String := To_Standard_String (Topic_Id);
+      V     : Topic_Access;
+      T     : constant String := To_Standard_String (Topic_Id);
+      Queue : constant Queue_Ref := Create (Pool, Deliver);
    begin
       pragma Debug (C, O ("Adding to topic " & T & " the Pool "
                        & MOMA.Destinations.Image (Pool)));
 
-      Lock_W (Data.T_Lock);
-      V := Lookup (Data.T, T, Null_Topic);
+      Enter (Data.T_Lock);
+      V := Lookup (Data.T, T, null);
 
-      if V /= Null_Topic then
-         Destination_List.Append (V.Subscribers, Pool);
+      if V /= null then
+         V.Subscribers :=
+           New_Snapshot (Snapshot_Of (V.Subscribers).Queues & Queue);
       else
-         Insert (Data.T, T, New_Topic (Destination_List."+" (Pool)));
+         Insert (Data.T, T,
+                 new Topic'(New_Topic (New_Snapshot ((1 => Queue)))));
       end if;
 
-      Unlock_W (Data.T_Lock);
+      Leave (Data.T_Lock);
    end Add_Subscriber;
 
+   -------------
+   -- Element --
+   -------------
+
+   function Element
+     (S     : Subscriber_Snapshot;
+      Index : Positive)
+     return Delivery_Queues.Queue_Ref is
+   begin
+      return Snapshot_Of (S).Queues (Index);
+   end Element;
+
    ---------------------------
    -- Ensure_Initialization --
    ---------------------------
@@ -89,11 +129,36 @@ package body PolyORB.MOMA_P.Provider.Topic_Datas is
       end if;
 
       Initialize (W.T);
-      PolyORB.Tasking.Rw_Locks.Create (W.T_Lock);
+      PolyORB.Tasking.Mutexes.Create (W.T_Lock);
       W.T_Initialized := True;
 
    end Ensure_Initialization;
 
+   ------------------
+   -- Get_Snapshot --
+   ------------------
+
+   function Get_Snapshot
+     (Data      : Topic_Data;
+      Topic_Id  : MOMA.Types.String)
+     return Subscriber_Snapshot
+   is
+      V      : Topic_Access;
+      Result : Subscriber_Snapshot;
+      K      : constant String := To_Standard_String (Topic_Id);
+
+   begin
+      Enter (Data.T_Lock);
+
+      V := Lookup (Data.T, K, null);
+      if V /= null then
+         Result := V.Subscribers;
+      end if;
+
+      Leave (Data.T_Lock);
+      return Result;
+   end Get_Snapshot;
+
    ---------------------
    -- Get_Subscribers --
    ---------------------
@@ -103,33 +168,121 @@ package body PolyORB.MOMA_P.Provider.Topic_Datas is
       Topic_Id  : MOMA.Types.String)
      return Destination_List.List
    is
-      V           : Topic;
+      Snapshot    : constant Subscriber_Snapshot :=
+        Get_Snapshot (Data, Topic_Id);
       Subscribers : Destination_List.List;
-      K           : constant String := To_Standard_String (Topic_Id);
 
    begin
-      Lock_R (Data.T_Lock);
+      for J in 1 .. Length (Snapshot) loop
+         Destination_List.Append
+           (Subscribers, Get_Pool (Element (Snapshot, J)));
+      end loop;
+      return Subscribers;
+   end Get_Subscribers;
 
-      V := Lookup (Data.T, K, Null_Topic);
-      if V /= Null_Topic then
-         Subscribers := Destination_List.Duplicate (V.Subscribers);
+   ------------
+   -- Length --
+   ------------
+
+   function Length (S : Subscriber_Snapshot) return Natural is
+   begin
+      if Is_Nil (S) then
+         return 0;
       end if;
+      return Snapshot_Of (S).Length;
+   end Length;
 
-      Unlock_R (Data.T_Lock);
-      return Subscribers;
-   end Get_Subscribers;
+   ------------------
+   -- New_Snapshot --
+   ------------------
+
+   function New_Snapshot (Queues : Queue_Array) return Subscriber_Snapshot is
+      E      : constant Snapshot_Access :=
+        new Snapshot_Entity (Length => Queues'Length);
+      Result : Subscriber_Snapshot;
+   begin
+      E.Queues := Queues;
+      Set (Result, PolyORB.Smart_Pointers.Entity_Ptr (E));
+      return Result;
+   end New_Snapshot;
 
    ---------------
    -- New_Topic --
    ---------------
 
    function New_Topic
-     (S : Destination_List.List)
+     (S : Subscriber_Snapshot)
      return Topic is
    begin
       return Topic'(To_MOMA_String ("Unknown"), S);
    end New_Topic;
 
+   ------------------
+   -- Remove_Queue --
+   ------------------
+
+   procedure Remove_Queue
+     (Data      : Topic_Data;
+      Topic_Id  : MOMA.Types.String;
+      Queue     : Delivery_Queues.Queue_Ref)
+   is
+      function Is_Queue (Q : Queue_Ref) return Boolean;
+
+      function Is_Queue (Q : Queue_Ref) return Boolean is
+      begin
+         return Same_Entity (Q, Queue);
+      end Is_Queue;
+
+      procedure Remove is new Remove_Queues (Is_Queue);
+
+      Found : Boolean;
+      pragma Unreferenced (Found);
+   begin
+      Remove (Data, To_Standard_String (Topic_Id), Found);
+   end Remove_Queue;
+
+   -------------------
+   -- Remove_Queues --
+   -------------------
+
+   procedure Remove_Queues
+     (Data      : Topic_Data;
+      T         : String;
+      Found     : out Boolean)
+   is
+      V : Topic_Access;
+   begin
+      Enter (Data.T_Lock);
+      V := Lookup (Data.T, T, null);
+      Found := V /= null;
+
+      if Found then
+         declare
+            Old   : Queue_Array renames Snapshot_Of (V.Subscribers).Queues;
+            Kept  : Queue_Array (1 .. Old'Length);
+            Count : Natural := 0;
+         begin
+            for J in Old'Range loop
+               if Remove (Old (J)) then
+                  Close (Old (J));
+               else
+                  Count := Count + 1;
+                  Kept (Count) := Old (J);
+               end if;
+            end loop;
+
+            if Count = 0 then
+               Delete (Data.T, T);
+               Free (V);
+            elsif Count < Old'Length then
+               V.Subscribers := New_Snapshot (Kept (1 .. Count));
+            end if;
+         end;
+      end if;
+
+      Leave (Data.T_Lock);
+   end Remove_Queues;
+
    -----------------------
    -- Remove_Subscriber --
    -----------------------
@@ -139,28 +292,36 @@ package body PolyORB.MOMA_P.Provider.Topic_Datas is
       Topic_Id  : MOMA.Types.String;
       Pool      : MOMA.Destinations.Destination)
    is
-      use Destination_List;
+      function For_Pool (Q : Queue_Ref) return Boolean;
+
+      function For_Pool (Q : Queue_Ref) return Boolean is
+      begin
+         return Get_Pool (Q) = Pool;
+      end For_Pool;
+
+      procedure Remove is new Remove_Queues (For_Pool);
 
-      V     : Topic;
       T     : constant String := To_Standard_String (Topic_Id);
+      Found : Boolean;
    begin
       pragma Debug (C, O ("Removing from topic " & T & " the Pool "
                        & MOMA.Destinations.Image (Pool)));
 
-      Lock_W (Data.T_Lock);
-      V := Lookup (Data.T, T, Null_Topic);
+      Remove (Data, T, Found);
 
-      if V = Null_Topic then
+      if not Found then
          raise Key_Not_Found;
          --  XXX do we really need to raise an exception ?
       end if;
+   end Remove_Subscriber;
 
-      Destination_List.Remove_Occurrences (V.Subscribers, Pool);
-      if V.Subscribers = Destination_List.Empty then
-         Delete (Data.T, T);
-      end if;
+   -----------------
+   -- Snapshot_Of --
+   -----------------
 
-      Unlock_W (Data.T_Lock);
-   end Remove_Subscriber;
+   function Snapshot_Of (S : Subscriber_Snapshot) return Snapshot_Access is
+   begin
+      return Snapshot_Access (Entity_Of (S));
+   end Snapshot_Of;
 
 end PolyORB.MOMA_P.Provider.Topic_Datas;
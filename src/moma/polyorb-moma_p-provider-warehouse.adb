@@ -32,18 +32,32 @@
 
 --  A dynamic, protected dictionary of Any, indexed by Strings.
 
-with Ada.Streams.Stream_IO;
+with Ada.Streams;
+
+with MOMA.Messages;
+
+with PolyORB.Buffers;
+with PolyORB.Errors;
+with PolyORB.Representations;
+with PolyORB.Setup;
 
 package body PolyORB.MOMA_P.Provider.Warehouse is
 
    use Ada.Streams;
-   use Ada.Streams.Stream_IO;
 
    use PolyORB.Any;
+   use PolyORB.Buffers;
+   use PolyORB.Errors;
+   use PolyORB.Representations;
    use PolyORB.Tasking.Rw_Locks;
 
    use MOMA.Types;
 
+   use type PolyORB.MOMA_P.Provider.Message_Log.Log_Offset;
+
+   Endianness : constant Endianness_Type := Big_Endian;
+   --  Byte order of the messages stored in the log
+
    ---------------------------
    -- Ensure_Initialization --
    ---------------------------
@@ -72,13 +86,8 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
       K : String)
       return PolyORB.Any.Any
    is
-      Result      : PolyORB.Any.Any;
---        Stream_File : Ada.Streams.Stream_IO.File_Type;
---        Buffer      : constant Buffer_Access := new Buffer_Type;
---        Data        : Opaque_Pointer;
---        Last        : Ada.Streams.Stream_Element_Offset;
---        Received    : Ada.Streams.Stream_Element_Count;
-      Temp        : Warehouse := W;
+      Result : PolyORB.Any.Any;
+      Temp   : Warehouse := W;
 
    begin
       Ensure_Initialization (Temp);
@@ -92,33 +101,38 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
             raise Key_Not_Found;
          end if;
       else
---           Ada.Streams.Stream_IO.Open (Stream_File, In_File, "message_" & K);
---           Allocate_And_Insert_Cooked_Data (Buffer, 1024, Data);
---           declare
---              Z_Addr : constant System.Address := Data;
---              Z : Stream_Element_Array (0 .. 1023);
---              for Z'Address use Z_Addr;
---              pragma Import (Ada, Z);
---           begin
---              Ada.Streams.Stream_IO.Read (Stream_File, Z, Last);
---           end;
-
---           Received := Last + 1;
---           Unuse_Allocation (Buffer, 1024 - Received);
---           Ada.Streams.Stream_IO.Close (Stream_File);
-
---           Set_Type (Result, TC_MOMA_Message);
---           Rewind (Buffer);
---           Unmarshall_To_Any (Buffer, Result);
-
-         raise Program_Error;
-         --  XXX This code is now deactivated (as of 9/17/04): We
-         --  cannot rely on the Rewind primitive which is
-         --  deprecated. Besides, we need to find an efficient way to
-         --  store a buffer into a file.
+         declare
+            Rep : constant Representation_Access :=
+              PolyORB.Setup.Default_Representation;
+
+            Stream : constant Stream_Element_Array :=
+              Message_Log.Read (W.T_Log, K);
+            Buffer : Buffer_Access := new Buffer_Type;
+            Error  : Error_Container;
+         begin
+            Initialize_Buffer
+              (Buffer               => Buffer,
+               Size                 => Stream'Length,
+               Data                 => Stream'Address,
+               Endianness           => Endianness,
+               Initial_CDR_Position => 0);
+
+            Result := Get_Empty_Any (MOMA.Messages.TC_MOMA_Message);
+            Unmarshall_To_Any (Rep, Buffer, Get_Container (Result).all, Error);
+            Release (Buffer);
+
+            if Found (Error) then
+               Catch (Error);
+               raise Program_Error;
+            end if;
+         end;
       end if;
 
       return Result;
+
+   exception
+      when Message_Log.Not_Found =>
+         raise Key_Not_Found;
    end Lookup;
 
    function Lookup
@@ -132,6 +146,19 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
    begin
       Ensure_Initialization (Temp);
 
+      if W.T_Persistence /= None then
+         if Message_Log.Find (W.T_Log, K) = Message_Log.No_Offset then
+            return Default;
+         end if;
+
+         begin
+            return Lookup (W, K);
+         exception
+            when Key_Not_Found =>
+               return Default;
+         end;
+      end if;
+
       Lock_R (W.T_Lock);
       V := Lookup (W.T, K, Default);
       Unlock_R (W.T_Lock);
@@ -148,8 +175,6 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
       K :        String;
       V :        PolyORB.Any.Any)
    is
---        Stream_File : Ada.Streams.Stream_IO.File_Type;
---        Buffer      : constant Buffer_Access := new Buffer_Type;
    begin
       Ensure_Initialization (W);
 
@@ -159,19 +184,27 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
          Unlock_W (W.T_Lock);
 
       else
---       Marshall_From_Any (Buffer, V);
---       Ada.Streams.Stream_IO.Create (Stream_File, Out_File, "message_" & K);
-
---       Ada.Streams.Stream_IO.Write (Stream_File,
---                                    To_Stream_Element_Array (Buffer));
---       Ada.Streams.Stream_IO.Close (Stream_File);
-
-         --  XXX This code is now deactivated (as of 9/17/04): We
-         --  cannot rely on the Rewind primitive which is
-         --  deprecated. Besides, we need to find an efficient way to
-         --  store a buffer into a file.
-
-         raise Program_Error;
+         declare
+            Rep : constant Representation_Access :=
+              PolyORB.Setup.Default_Representation;
+
+            Buffer : Buffer_Access := new Buffer_Type;
+            Error  : Error_Container;
+            Offset : Message_Log.Log_Offset;
+         begin
+            Set_Endianness (Buffer, Endianness);
+            Marshall_From_Any (Rep, Buffer, Get_Container (V).all, Error);
+
+            if Found (Error) then
+               Release (Buffer);
+               Catch (Error);
+               raise Program_Error;
+            end if;
+
+            Message_Log.Append
+              (W.T_Log, K, To_Stream_Element_Array (Buffer.all), Offset);
+            Release (Buffer);
+         end;
       end if;
 
    end Register;
@@ -184,7 +217,6 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
      (W : in out Warehouse;
       K :        String)
    is
-      Stream_File : Ada.Streams.Stream_IO.File_Type;
    begin
       Ensure_Initialization (W);
 
@@ -194,10 +226,12 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
          Unlock_W (W.T_Lock);
 
       else
-         Ada.Streams.Stream_IO.Open (Stream_File, Out_File, "message_" & K);
-         Ada.Streams.Stream_IO.Delete (Stream_File);
+         Message_Log.Acknowledge (W.T_Log, K);
       end if;
 
+   exception
+      when Message_Log.Not_Found =>
+         raise Key_Not_Found;
    end Unregister;
 
    ---------------------
@@ -206,9 +240,18 @@ package body PolyORB.MOMA_P.Provider.Warehouse is
 
    procedure Set_Persistence
      (W           : in out Warehouse;
-      Persistence :        MOMA.Types.Persistence_Mode) is
+      Persistence :        MOMA.Types.Persistence_Mode;
+      Name        :        String := "warehouse") is
    begin
       W.T_Persistence := Persistence;
+
+      if Persistence /= None and then W.T_Log = null then
+         if Name = "" then
+            W.T_Log := Message_Log.Open ("warehouse");
+         else
+            W.T_Log := Message_Log.Open (Name);
+         end if;
+      end if;
    end Set_Persistence;
 
 end PolyORB.MOMA_P.Provider.Warehouse;
@@ -0,0 +1,192 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                P O L Y O R B . A N Y . I N T E R N I N G                 --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with PolyORB.Initialization;
+with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Smart_Pointers;
+with PolyORB.Tasking.Mutexes;
+with PolyORB.Utils.Chained_Lists;
+with PolyORB.Utils.HFunctions.Hyper;
+with PolyORB.Utils.HTables.Perfect;
+with PolyORB.Utils.Strings;
+
+package body PolyORB.Any.Interning is
+
+   use PolyORB.Any.TypeCode;
+   use PolyORB.Log;
+   use PolyORB.Tasking.Mutexes;
+   use PolyORB.Types;
+   use type Interfaces.Unsigned_64;
+
+   package L is new PolyORB.Log.Facility_Log ("polyorb.any.interning");
+   procedure O (Message : String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   package TC_Lists is new PolyORB.Utils.Chained_Lists (Object_Ptr);
+
+   type TC_List_Access is access all TC_Lists.List;
+
+   package TC_HTables is new PolyORB.Utils.HTables.Perfect
+     (TC_List_Access,
+      PolyORB.Utils.HFunctions.Hyper.Hash_Hyper_Parameters,
+      PolyORB.Utils.HFunctions.Hyper.Default_Hash_Parameters,
+      PolyORB.Utils.HFunctions.Hyper.Hash,
+      PolyORB.Utils.HFunctions.Hyper.Next_Hash_Parameters);
+
+   Lock : Mutex_Access;
+   --  Protects all the variables below
+
+   Table : TC_HTables.Table_Instance;
+   --  Interned typecodes, indexed by kind and structural hash. Each entry
+   --  holds one reference to each of its typecodes, which therefore remain
+   --  allocated until the end of the partition.
+
+   Count : Natural := 0;
+   --  Number of interned typecodes
+
+   Limit : Natural;
+   --  Maximum number of interned typecodes
+
+   Stats : Interning_Statistics;
+
+   ------------
+   -- Intern --
+   ------------
+
+   function Intern (TC : TypeCode.Local_Ref) return TypeCode.Local_Ref is
+      use TC_Lists;
+
+      Obj    : constant Object_Ptr := Object_Of (TC);
+      Bucket : TC_List_Access;
+      It     : Iterator;
+      Result : TypeCode.Local_Ref;
+
+   begin
+      if Obj.Interned or else Parameter_Count (Obj) = 0 then
+         return TC;
+      end if;
+
+      declare
+         Key : constant String :=
+           TCKind'Image (Kind (Obj))
+           & Unsigned_Long'Image (Structural_Hash (Obj));
+      begin
+         Enter (Lock);
+         Bucket := TC_HTables.Lookup (Table, Key, null);
+
+         if Bucket /= null then
+            It := First (Bucket.all);
+            while not Last (It) loop
+               if Equal (Value (It).all, Obj) then
+                  Stats.Hits := Stats.Hits + 1;
+                  Result := To_Ref (Value (It).all);
+                  Leave (Lock);
+                  return Result;
+               end if;
+               Next (It);
+            end loop;
+         end if;
+
+         if Count >= Limit then
+            Stats.Rejected := Stats.Rejected + 1;
+            Leave (Lock);
+            pragma Debug (C, O ("Intern: table full, not interning " & Key));
+            return TC;
+         end if;
+
+         if not Obj.Frozen then
+            Freeze (Obj);
+         end if;
+         Obj.Interned := True;
+         Smart_Pointers.Inc_Usage (Smart_Pointers.Entity_Ptr (Obj));
+
+         if Bucket = null then
+            Bucket := new TC_Lists.List;
+            TC_HTables.Insert (Table, Key, Bucket);
+         end if;
+         Append (Bucket.all, Obj);
+
+         Count := Count + 1;
+         Stats.Misses := Stats.Misses + 1;
+         Leave (Lock);
+         pragma Debug (C, O ("Intern: interned " & Key));
+         return TC;
+      end;
+   end Intern;
+
+   ----------------
+   -- Statistics --
+   ----------------
+
+   function Statistics return Interning_Statistics is
+      Result : Interning_Statistics;
+   begin
+      Enter (Lock);
+      Result := Stats;
+      Leave (Lock);
+      return Result;
+   end Statistics;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize;
+
+   procedure Initialize is
+   begin
+      Create (Lock);
+      TC_HTables.Initialize (Table);
+      Limit := PolyORB.Parameters.Get_Conf
+                 ("any", "typecode_intern_limit", 4096);
+   end Initialize;
+
+   use PolyORB.Initialization;
+   use PolyORB.Initialization.String_Lists;
+   use PolyORB.Utils.Strings;
+
+begin
+   Register_Module
+     (Module_Info'
+      (Name      => +"any.interning",
+       Conflicts => Empty,
+       Depends   => +"tasking.mutexes" & "parameters",
+       Provides  => Empty,
+       Implicit  => False,
+       Init      => Initialize'Access,
+       Shutdown  => null));
+end PolyORB.Any.Interning;
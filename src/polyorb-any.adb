@@ -79,6 +79,9 @@ package body PolyORB.Any is
    --  Helper for Any_Container_Eq, handles the case of aggregates
 
    type Aggregate_Content_Ptr is access all Aggregate_Content'Class;
+   for Aggregate_Content_Ptr'Storage_Pool use PolyORB.Arenas.Pool;
+   --  Aggregate contents allocated through this type are deallocated
+   --  through Content_Ptr.
 
    --------------------
    -- Elementary_Any --
@@ -2677,6 +2680,14 @@ package body PolyORB.Any is
             return True;
          end if;
 
+         --  Interned typecodes are unique for a given structure
+
+         if Left.Interned and then Right.Interned then
+            pragma Debug (C,
+              O ("Equal (TypeCode): end: False, distinct interned objects"));
+            return False;
+         end if;
+
          if Kind (Left) /= Kind (Right) then
             pragma Debug (C,
               O ("Equal (TypeCode): end: False, different kinds"));
@@ -2953,6 +2964,10 @@ package body PolyORB.Any is
          U_Left  : Object_Ptr := Left;
          U_Right : Object_Ptr := Right;
       begin
+         if Left = Right then
+            return True;
+         end if;
+
          --  comments are from the spec CORBA v2.3 - 10.7.1
          --  If the result of the kind operation on either TypeCode is
          --  tk_alias, recursively replace the TypeCode with the result of
@@ -3923,6 +3938,94 @@ package body PolyORB.Any is
          return Default_Aggregate_Content_Ptr (TC.Parameters);
       end Parameters;
 
+      ---------------------
+      -- Structural_Hash --
+      ---------------------
+
+      function Structural_Hash (Self : Object_Ptr) return Unsigned_Long is
+
+         Max_Depth : constant := 3;
+         --  Nesting depth beyond which nested typecodes are not hashed
+
+         function Hash (TC : Object_Ptr; Depth : Natural) return Unsigned_Long;
+         --  Hash TC, which is nested at the given Depth within Self
+
+         ----------
+         -- Hash --
+         ----------
+
+         function Hash
+           (TC    : Object_Ptr;
+            Depth : Natural) return Unsigned_Long
+         is
+            H : Unsigned_Long := 2_166_136_261;
+
+            procedure Mix (V : Unsigned_Long);
+            pragma Inline (Mix);
+            --  Fold V into H (FNV-1a step)
+
+            ---------
+            -- Mix --
+            ---------
+
+            procedure Mix (V : Unsigned_Long) is
+            begin
+               H := (H xor V) * 16_777_619;
+            end Mix;
+
+         begin
+            Mix (TCKind'Pos (Kind (TC)));
+
+            if Depth = Max_Depth or else Parameter_Count (TC) = 0 then
+               return H;
+            end if;
+
+            for J in 0 .. Parameter_Count (TC) - 1 loop
+               declare
+                  P : constant Any_Container_Ptr := Get_Parameter (TC, J);
+               begin
+                  case Kind (Get_Type_Obj (P.all)) is
+                     when Tk_String =>
+                        declare
+                           S : constant Standard.String :=
+                             To_Standard_String (From_Any (P.all));
+                        begin
+                           for K in S'Range loop
+                              Mix (Character'Pos (S (K)));
+                           end loop;
+                        end;
+
+                     when Tk_Ulong =>
+                        Mix (From_Any (P.all));
+
+                     when Tk_Long =>
+                        Mix (Unsigned_Long'Mod (Long'(From_Any (P.all))));
+
+                     when Tk_Short =>
+                        Mix (Unsigned_Long'Mod (Short'(From_Any (P.all))));
+
+                     when Tk_Ushort =>
+                        Mix (Unsigned_Long
+                               (Unsigned_Short'(From_Any (P.all))));
+
+                     when Tk_TypeCode =>
+                        Mix (Hash (Get_Parameter (TC, J), Depth + 1));
+
+                     when others =>
+                        --  Union labels are not hashed
+
+                        null;
+                  end case;
+               end;
+            end loop;
+
+            return H;
+         end Hash;
+
+      begin
+         return Hash (Self, 0);
+      end Structural_Hash;
+
       -------------
       -- TC_Null --
       -------------
@@ -0,0 +1,329 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                       P O L Y O R B . A R E N A S                        --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Unchecked_Deallocation;
+with Interfaces.C;
+with System.Address_To_Access_Conversions;
+
+package body PolyORB.Arenas is
+
+   use type System.Address;
+
+   Current : Arena_Access := null;
+   pragma Thread_Local_Storage (Current);
+   --  The current arena of each task
+
+   Pending : Arena_Ref_Access := null;
+   pragma Thread_Local_Storage (Pending);
+   --  For each task, when not null and Current is null, the reference to
+   --  set to the arena to create and make current on the next allocation
+   --  (see Enter_On_Demand).
+
+   Chunk_Size : Storage_Count := 8 * 1024;
+
+   --  Each object allocated through Pool is preceded by a header that
+   --  records where it comes from, so that Deallocate never has to guess
+   --  the owner of an object from its address.
+
+   type Block_Header is record
+      Owner : Arena_Access;
+      --  The arena the object was allocated from, or null for an object
+      --  allocated from the system heap.
+
+      Base  : System.Address;
+      --  For an object allocated from the system heap, the address of the
+      --  underlying system allocation.
+   end record;
+
+   Header_Size : constant Storage_Count :=
+     Block_Header'Max_Size_In_Storage_Elements;
+
+   package Header_Conversions is
+     new System.Address_To_Access_Conversions (Block_Header);
+   use Header_Conversions;
+
+   function System_Alloc (Size : Interfaces.C.size_t) return System.Address;
+   pragma Import (C, System_Alloc, "__gnat_malloc");
+
+   procedure System_Free (Address : System.Address);
+   pragma Import (C, System_Free, "__gnat_free");
+   --  The allocator used by the default storage pool
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Chunk_Type, Chunk_Access);
+
+   function Align_Up
+     (Addr  : System.Address;
+      Align : Storage_Count) return System.Address;
+   --  Return the first address no lower than Addr that is a multiple of
+   --  Align.
+
+   function Arena_Allocate
+     (A     : Arena_Access;
+      Size  : Storage_Count;
+      Align : Storage_Count) return System.Address;
+   --  Allocate Size storage elements aligned on Align from A, preceded by
+   --  room for a block header.
+
+   --------------
+   -- Align_Up --
+   --------------
+
+   function Align_Up
+     (Addr  : System.Address;
+      Align : Storage_Count) return System.Address
+   is
+      Misalignment : constant Storage_Offset := Addr mod Align;
+   begin
+      if Misalignment = 0 then
+         return Addr;
+      else
+         return Addr + (Align - Misalignment);
+      end if;
+   end Align_Up;
+
+   --------------
+   -- Allocate --
+   --------------
+
+   overriding procedure Allocate
+     (Pool                     : in out Arena_Pool;
+      Storage_Address          : out System.Address;
+      Size_In_Storage_Elements : Storage_Count;
+      Alignment                : Storage_Count)
+   is
+      pragma Unreferenced (Pool);
+
+      A     : Arena_Access := Current;
+      Align : constant Storage_Count :=
+        Storage_Count'Max (Alignment, Block_Header'Alignment);
+      Span  : constant Storage_Count :=
+        Header_Size + Size_In_Storage_Elements + Align;
+      --  Storage needed for the object, its header and alignment padding
+
+      Header : Object_Pointer;
+
+   begin
+      if A = null and then Pending /= null and then Span <= Chunk_Size / 4
+      then
+         Create (Pending.all);
+         A := Arena_Access (Entity_Of (Pending.all));
+         Current := A;
+         Pending := null;
+      end if;
+
+      if A /= null and then Span <= Chunk_Size / 4 then
+         Storage_Address :=
+           Arena_Allocate (A, Size_In_Storage_Elements, Align);
+         Header := To_Pointer (Storage_Address - Header_Size);
+         Header.all := (Owner => A, Base => System.Null_Address);
+
+         --  Each object holds a reference to its arena
+
+         Smart_Pointers.Inc_Usage (Smart_Pointers.Entity_Ptr (A));
+
+         if On_Allocation /= null then
+            On_Allocation (Arena_Object, Size_In_Storage_Elements);
+         end if;
+
+      else
+         declare
+            Base : constant System.Address :=
+              System_Alloc (Interfaces.C.size_t (Span));
+         begin
+            Storage_Address := Align_Up (Base + Header_Size, Align);
+            Header := To_Pointer (Storage_Address - Header_Size);
+            Header.all := (Owner => null, Base => Base);
+         end;
+
+         if On_Allocation /= null then
+            On_Allocation (Heap_Object, Size_In_Storage_Elements);
+         end if;
+      end if;
+   end Allocate;
+
+   --------------------
+   -- Arena_Allocate --
+   --------------------
+
+   function Arena_Allocate
+     (A     : Arena_Access;
+      Size  : Storage_Count;
+      Align : Storage_Count) return System.Address
+   is
+      Chunk : Chunk_Access := A.Chunks;
+      Addr  : System.Address;
+
+   begin
+      --  Try the free space at the end of the most recent chunk first
+
+      if Chunk /= null then
+         Addr := Align_Up (Chunk.Data'Address + A.Used + Header_Size, Align);
+         if Addr + Size <= Chunk.Data'Address + Chunk.Size then
+            A.Used := (Addr + Size) - Chunk.Data'Address;
+            return Addr;
+         end if;
+      end if;
+
+      --  Obtain a new chunk. The space left in the previous one, if any, is
+      --  wasted.
+
+      Chunk := new Chunk_Type (Chunk_Size);
+      Chunk.Next := A.Chunks;
+      A.Chunks := Chunk;
+
+      if On_Allocation /= null then
+         On_Allocation (Arena_Chunk, Chunk_Size);
+      end if;
+
+      Addr := Align_Up (Chunk.Data'Address + Header_Size, Align);
+      A.Used := (Addr + Size) - Chunk.Data'Address;
+      return Addr;
+   end Arena_Allocate;
+
+   ------------
+   -- Create --
+   ------------
+
+   procedure Create (A : out Arena_Ref) is
+   begin
+      Set (A, Smart_Pointers.Entity_Ptr'(new Arena));
+   end Create;
+
+   ----------------
+   -- Deallocate --
+   ----------------
+
+   overriding procedure Deallocate
+     (Pool                     : in out Arena_Pool;
+      Storage_Address          : System.Address;
+      Size_In_Storage_Elements : Storage_Count;
+      Alignment                : Storage_Count)
+   is
+      pragma Unreferenced (Pool, Size_In_Storage_Elements, Alignment);
+
+      Header : constant Object_Pointer :=
+        To_Pointer (Storage_Address - Header_Size);
+
+   begin
+      if Header.Owner = null then
+         System_Free (Header.Base);
+
+      else
+         declare
+            Owner : Smart_Pointers.Entity_Ptr :=
+              Smart_Pointers.Entity_Ptr (Header.Owner);
+         begin
+            Smart_Pointers.Dec_Usage (Owner);
+         end;
+      end if;
+   end Deallocate;
+
+   -----------
+   -- Enter --
+   -----------
+
+   procedure Enter (Scope : in out Arena_Scope; A : Arena_Ref) is
+   begin
+      pragma Assert (not Scope.Entered);
+      Scope.Arena            := A;
+      Scope.Previous         := Current;
+      Scope.Previous_Pending := Pending;
+      Scope.Entered          := True;
+      Current := Arena_Access (Entity_Of (A));
+      Pending := null;
+   end Enter;
+
+   ---------------------
+   -- Enter_On_Demand --
+   ---------------------
+
+   procedure Enter_On_Demand
+     (Scope : in out Arena_Scope;
+      A     : not null access Arena_Ref)
+   is
+   begin
+      pragma Assert (not Scope.Entered);
+      Scope.Previous         := Current;
+      Scope.Previous_Pending := Pending;
+      Scope.Entered          := True;
+      Current := null;
+      Pending := A.all'Unchecked_Access;
+   end Enter_On_Demand;
+
+   --------------
+   -- Finalize --
+   --------------
+
+   overriding procedure Finalize (Scope : in out Arena_Scope) is
+   begin
+      if Scope.Entered then
+         Current := Scope.Previous;
+         Pending := Scope.Previous_Pending;
+         Scope.Entered := False;
+      end if;
+   end Finalize;
+
+   overriding procedure Finalize (X : in out Arena) is
+      Chunk : Chunk_Access;
+   begin
+      while X.Chunks /= null loop
+         Chunk := X.Chunks;
+         X.Chunks := Chunk.Next;
+         Free (Chunk);
+      end loop;
+   end Finalize;
+
+   --------------------
+   -- Set_Chunk_Size --
+   --------------------
+
+   procedure Set_Chunk_Size (Size : Storage_Count) is
+   begin
+      Chunk_Size := Size;
+   end Set_Chunk_Size;
+
+   ------------------
+   -- Storage_Size --
+   ------------------
+
+   overriding function Storage_Size
+     (Pool : Arena_Pool) return Storage_Count
+   is
+      pragma Unreferenced (Pool);
+   begin
+      return Storage_Count'Last;
+   end Storage_Size;
+
+end PolyORB.Arenas;
@@ -0,0 +1,408 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--      P O L Y O R B . A S Y N C H _ E V . S O C K E T S . E P O L L       --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with System.Address_To_Access_Conversions;
+
+with PolyORB.Constants;
+with PolyORB.Initialization;
+with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Utils.Strings;
+
+package body PolyORB.Asynch_Ev.Sockets.Epoll is
+
+   use Interfaces.C;
+   use System;
+
+   use PolyORB.Log;
+   use PolyORB.Sockets;
+
+   package L is new PolyORB.Log.Facility_Log
+     ("polyorb.asynch_ev.sockets.epoll");
+   procedure O (Message : String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   package SES_Conversions is
+     new System.Address_To_Access_Conversions (Socket_Event_Source'Class);
+
+   Max_Events : constant := 64;
+   --  Maximum number of events retrieved by one call to epoll_wait. This must
+   --  not exceed the corresponding limit in __PolyORB_epoll_wait.
+
+   type Address_Array is array (1 .. Max_Events) of System.Address;
+   pragma Convention (C, Address_Array);
+
+   --  Imports from csupport.c
+
+   function C_Epoll_Create return int;
+   pragma Import (C, C_Epoll_Create, "__PolyORB_epoll_create");
+
+   function C_Epoll_Arm
+     (Epoll_FD : int;
+      FD       : int;
+      Data     : System.Address) return int;
+   pragma Import (C, C_Epoll_Arm, "__PolyORB_epoll_arm");
+
+   function C_Epoll_Disarm (Epoll_FD : int; FD : int) return int;
+   pragma Import (C, C_Epoll_Disarm, "__PolyORB_epoll_disarm");
+
+   function C_Epoll_Wait
+     (Epoll_FD  : int;
+      Ready     : System.Address;
+      Max_Ready : int;
+      Timeout   : int) return int;
+   pragma Import (C, C_Epoll_Wait, "__PolyORB_epoll_wait");
+
+   function C_Eventfd_Create return int;
+   pragma Import (C, C_Eventfd_Create, "__PolyORB_eventfd_create");
+
+   procedure C_Eventfd_Signal (FD : int);
+   pragma Import (C, C_Eventfd_Signal, "__PolyORB_eventfd_signal");
+
+   procedure C_Eventfd_Clear (FD : int);
+   pragma Import (C, C_Eventfd_Clear, "__PolyORB_eventfd_clear");
+
+   function C_Close (FD : int) return int;
+   pragma Import (C, C_Close, "close");
+
+   function FD_Of (S : Socket_Type) return int;
+   pragma Inline (FD_Of);
+   --  Return the descriptor for S
+
+   -----------
+   -- FD_Of --
+   -----------
+
+   function FD_Of (S : Socket_Type) return int is
+   begin
+      return int (To_C (S));
+   end FD_Of;
+
+   ------------
+   -- Create --
+   ------------
+
+   overriding procedure Create (AEM : out Epoll_Event_Monitor) is
+   begin
+      AEM.Epoll_FD := C_Epoll_Create;
+      if AEM.Epoll_FD < 0 then
+         raise Socket_Error with "epoll_create failed";
+      end if;
+
+      AEM.Abort_FD := C_Eventfd_Create;
+      if AEM.Abort_FD < 0
+        or else C_Epoll_Arm (AEM.Epoll_FD, AEM.Abort_FD, Null_Address) /= 0
+      then
+         raise Socket_Error with "cannot set up epoll abort descriptor";
+      end if;
+   end Create;
+
+   -------------
+   -- Destroy --
+   -------------
+
+   overriding procedure Destroy (AEM : in out Epoll_Event_Monitor) is
+      Dummy : int;
+      pragma Unreferenced (Dummy);
+   begin
+      if AEM.Abort_FD >= 0 then
+         Dummy := C_Close (AEM.Abort_FD);
+         AEM.Abort_FD := -1;
+      end if;
+
+      if AEM.Epoll_FD >= 0 then
+         Dummy := C_Close (AEM.Epoll_FD);
+         AEM.Epoll_FD := -1;
+      end if;
+   end Destroy;
+
+   -----------------
+   -- Has_Sources --
+   -----------------
+
+   overriding function Has_Sources
+     (AEM : Epoll_Event_Monitor) return Boolean
+   is
+   begin
+      return not Source_Lists.Is_Empty (AEM.Sources);
+   end Has_Sources;
+
+   ---------------------
+   -- Register_Source --
+   ---------------------
+
+   overriding function Register_Source
+     (AEM     : access Epoll_Event_Monitor;
+      AES     : Asynch_Ev_Source_Access) return Register_Source_Result
+   is
+   begin
+      pragma Debug (C, O ("Register_Source: enter"));
+
+      --  Only plain socket event sources are handled (derived types such as
+      --  SSL event sources require specific monitors).
+
+      if AES.all not in Socket_Event_Source then
+         pragma Debug (C, O ("Register_Source: leave (Unknown_Source_Type)"));
+         return Unknown_Source_Type;
+      end if;
+
+      declare
+         S_AES : Socket_Event_Source'Class
+           renames Socket_Event_Source'Class (AES.all);
+      begin
+         pragma Debug
+           (C, O ("Register_Source: socket =" & Image (S_AES.Socket)));
+         pragma Assert (not S_AES.Armed);
+
+         if C_Epoll_Arm
+              (AEM.Epoll_FD, FD_Of (S_AES.Socket), S_AES'Address) /= 0
+         then
+            O ("Register_Source: epoll_ctl failed for socket"
+               & Image (S_AES.Socket), Error);
+            pragma Debug (C, O ("Register_Source: leave (Failure)"));
+            return Failure;
+         end if;
+
+         S_AES.Armed := True;
+         Source_Lists.Append (AEM.Sources, S_AES'Access);
+      end;
+
+      AES.Monitor := Asynch_Ev_Monitor_Access (AEM);
+
+      pragma Debug (C, O ("Register_Source: leave (Success)"));
+      return Success;
+   end Register_Source;
+
+   -----------------------
+   -- Unregister_Source --
+   -----------------------
+
+   overriding procedure Unregister_Source
+     (AEM     : in out Epoll_Event_Monitor;
+      AES     : Asynch_Ev_Source_Access;
+      Success : out Boolean)
+   is
+      S_AES : Socket_Event_Source'Class
+        renames Socket_Event_Source'Class (AES.all);
+   begin
+      pragma Debug
+        (C, O ("Unregister_Source: enter, socket =" & Image (S_AES.Socket)));
+      pragma Assert (S_AES.Socket /= No_Socket);
+
+      if not S_AES.Armed then
+         Success := False;
+
+      else
+         --  Failure to remove the descriptor from the epoll set is harmless:
+         --  the kernel drops it when the socket is closed, and a source that
+         --  is not armed is never reported.
+
+         if C_Epoll_Disarm (AEM.Epoll_FD, FD_Of (S_AES.Socket)) /= 0 then
+            pragma Debug (C, O ("Unregister_Source: epoll_ctl failed"));
+            null;
+         end if;
+
+         S_AES.Armed := False;
+         Source_Lists.Remove_Element (AEM.Sources, S_AES'Access);
+         Success := True;
+      end if;
+
+      pragma Debug (C, O ("Unregister_Source: leave, Success: "
+        & Success'Img));
+   end Unregister_Source;
+
+   -------------------
+   -- Check_Sources --
+   -------------------
+
+   overriding function Check_Sources
+     (AEM     : access Epoll_Event_Monitor;
+      Timeout : Duration) return AES_Array
+   is
+      Ready  : Address_Array;
+      Result : AES_Array (1 .. Max_Events);
+      Last   : Integer := 0;
+
+      T      : int;
+      Count  : int;
+
+   begin
+      pragma Debug (C, O ("Check_Sources: enter"));
+
+      --  Convert Timeout to milliseconds, rounding up so that a nonzero
+      --  timeout does not degenerate into a busy poll.
+
+      if Timeout = Constants.Forever then
+         T := -1;
+      elsif Timeout >= Duration (int'Last / 1000) then
+         T := int'Last;
+      else
+         T := int (Timeout * 1000);
+         if Duration (T) < Timeout * 1000 then
+            T := T + 1;
+         end if;
+      end if;
+
+      Count := C_Epoll_Wait (AEM.Epoll_FD, Ready'Address, Max_Events, T);
+
+      if Count < 0 then
+         O ("Check_Sources: epoll_wait failed", Error);
+         raise Socket_Error with "epoll_wait failed";
+      end if;
+
+      pragma Debug (C, O ("Check_Sources: epoll_wait returned" & Count'Img));
+
+      for J in 1 .. Integer (Count) loop
+         if Ready (J) = Null_Address then
+
+            --  Abort request: consume the signal and rearm the abort
+            --  descriptor (it is registered one-shot like other sources).
+
+            pragma Debug (C, O ("Check_Sources: aborted"));
+            C_Eventfd_Clear (AEM.Abort_FD);
+            if C_Epoll_Arm (AEM.Epoll_FD, AEM.Abort_FD, Null_Address) /= 0
+            then
+               O ("Check_Sources: cannot rearm abort descriptor", Error);
+            end if;
+
+         else
+            declare
+               S_AES : constant SES_Access :=
+                 SES_Access (SES_Conversions.To_Pointer (Ready (J)));
+            begin
+               pragma Debug
+                 (C, O ("Got event on socket" & Image (S_AES.Socket)));
+
+               --  The descriptor has been disarmed by the kernel (one-shot
+               --  registration): remove the source from the monitor.
+
+               S_AES.Armed := False;
+               Source_Lists.Remove_Element (AEM.Sources, S_AES);
+
+               Last := Last + 1;
+               Result (Last) := Asynch_Ev_Source_Access (S_AES);
+            end;
+         end if;
+      end loop;
+
+      pragma Debug (C, O ("Check_Sources: end"));
+      return Result (1 .. Last);
+   end Check_Sources;
+
+   -------------------------
+   -- Abort_Check_Sources --
+   -------------------------
+
+   overriding procedure Abort_Check_Sources (AEM : Epoll_Event_Monitor) is
+   begin
+      C_Eventfd_Signal (AEM.Abort_FD);
+   end Abort_Check_Sources;
+
+   ---------------------
+   -- Epoll_Supported --
+   ---------------------
+
+   Supported : Boolean := False;
+   --  Set at initialization time
+
+   function Epoll_Supported return Boolean is
+   begin
+      return Supported;
+   end Epoll_Supported;
+
+   --------------------------------
+   -- Create_Epoll_Event_Monitor --
+   --------------------------------
+
+   function Create_Epoll_Event_Monitor return Asynch_Ev_Monitor_Access;
+
+   function Create_Epoll_Event_Monitor return Asynch_Ev_Monitor_Access is
+   begin
+      return new Epoll_Event_Monitor;
+   end Create_Epoll_Event_Monitor;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize;
+
+   procedure Initialize is
+      Monitor : constant String :=
+        PolyORB.Parameters.Get_Conf
+          ("asynch_ev", "socket_monitor", Default => "select");
+   begin
+      --  Probe for epoll support
+
+      declare
+         FD    : constant int := C_Epoll_Create;
+         Dummy : int;
+         pragma Unreferenced (Dummy);
+      begin
+         Supported := FD >= 0;
+         if Supported then
+            Dummy := C_Close (FD);
+         end if;
+      end;
+
+      if Monitor = "epoll" then
+         if Supported then
+            Socket_AEM_Factory := Create_Epoll_Event_Monitor'Access;
+         else
+            O ("epoll not supported on this platform,"
+               & " using select-based socket monitor", Warning);
+         end if;
+
+      elsif Monitor /= "select" then
+         O ("unknown socket monitor: " & Monitor, Warning);
+      end if;
+   end Initialize;
+
+   use PolyORB.Initialization;
+   use PolyORB.Initialization.String_Lists;
+   use PolyORB.Utils.Strings;
+
+begin
+   Register_Module
+     (Module_Info'
+      (Name      => +"asynch_ev.sockets.epoll",
+       Conflicts => Empty,
+       Depends   => +"parameters",
+       Provides  => Empty,
+       Implicit  => False,
+       Init      => Initialize'Access,
+       Shutdown  => null));
+end PolyORB.Asynch_Ev.Sockets.Epoll;
@@ -312,6 +312,9 @@ package body PolyORB.Asynch_Ev.Sockets is
       pragma Warnings (On);
 
    begin
+      if Socket_AEM_Factory /= null then
+         return Socket_AEM_Factory;
+      end if;
       return Create_Socket_Event_Monitor'Access;
    end AEM_Factory_Of;
 
@@ -112,6 +112,18 @@ package body PolyORB.Binding_Data is
       return False;
    end Is_Multicast_Profile;
 
+   ---------------
+   -- Node_Keys --
+   ---------------
+
+   function Node_Keys
+     (P : Profile_Type) return PolyORB.Utils.Strings.Lists.List
+   is
+      pragma Unreferenced (P);
+   begin
+      return PolyORB.Utils.Strings.Lists.Empty;
+   end Node_Keys;
+
    ----------------
    -- Notepad_Of --
    ----------------
@@ -0,0 +1,350 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--        P O L Y O R B . B I N D I N G _ O B J E C T S . C A C H E         --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Unchecked_Deallocation;
+
+with PolyORB.Log;
+with PolyORB.Utils.Strings.Lists;
+
+package body PolyORB.Binding_Objects.Cache is
+
+   use PolyORB.Log;
+   use PolyORB.Tasking.Mutexes;
+   use type Interfaces.Unsigned_64;
+
+   package L is new PolyORB.Log.Facility_Log ("polyorb.binding_objects.cache");
+   procedure O (Message : String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (BO_Lists.List, BO_List_Access);
+
+   procedure Add_Candidates
+     (BOs        : BO_Lists.List;
+      Candidates : in out BO_Ref_Lists.List);
+   --  Append to Candidates references to the elements of BOs that are not
+   --  already present in Candidates and are not being finalized. Must be
+   --  called with Cache.Lock held.
+
+   procedure Get_Node_Keys
+     (BO   : Binding_Object_Access;
+      Keys : out Utils.Strings.Lists.List;
+      Done : out Boolean);
+   --  Return the node keys of BO's profile in Keys. Set Done to True (and
+   --  Keys to the empty list) if BO has no profile and is therefore never
+   --  recorded.
+
+   --------------------
+   -- Add_Candidates --
+   --------------------
+
+   procedure Add_Candidates
+     (BOs        : BO_Lists.List;
+      Candidates : in out BO_Ref_Lists.List)
+   is
+      use BO_Lists;
+      use BO_Ref_Lists;
+
+      It : BO_Lists.Iterator := First (BOs);
+
+   begin
+      while not Last (It) loop
+         declare
+            BO_Acc : constant Binding_Object_Access := Value (It).all;
+            C_It   : BO_Ref_Lists.Iterator := First (Candidates);
+            Ref    : Smart_Pointers.Ref;
+
+         begin
+            --  Skip binding objects already returned through another key
+
+            while not Last (C_It)
+              and then Smart_Pointers.Entity_Of (Value (C_It).all)
+                         /= Smart_Pointers.Entity_Ptr (BO_Acc)
+            loop
+               Next (C_It);
+            end loop;
+
+            --  Binding objects are removed from the cache before they are
+            --  deallocated (see PolyORB.ORB.Unregister_Binding_Object), so
+            --  BO_Acc is still valid here. If it is being finalized,
+            --  Reuse_Entity leaves Ref unset.
+
+            if Last (C_It) then
+               Smart_Pointers.Reuse_Entity
+                 (Ref, Smart_Pointers.Entity_Ptr (BO_Acc));
+               if not Smart_Pointers.Is_Nil (Ref) then
+                  Append (Candidates, Ref);
+               end if;
+            end if;
+         end;
+         Next (It);
+      end loop;
+   end Add_Candidates;
+
+   --------------------
+   -- Get_Candidates --
+   --------------------
+
+   procedure Get_Candidates
+     (Cache      : in out Cache_Type;
+      Pro        : Binding_Data.Profile_Type'Class;
+      Candidates : out BO_Ref_Lists.List;
+      Indexed    : out Boolean)
+   is
+      use Utils.Strings.Lists;
+
+      Keys : Utils.Strings.Lists.List := Binding_Data.Node_Keys (Pro);
+      It   : Utils.Strings.Lists.Iterator;
+
+   begin
+      pragma Abort_Defer;
+
+      Candidates := BO_Ref_Lists.Empty;
+      Indexed := not Is_Empty (Keys);
+      if not Indexed then
+         return;
+      end if;
+
+      Enter (Cache.Lock);
+
+      It := First (Keys);
+      while not Last (It) loop
+         declare
+            BOs : constant BO_List_Access :=
+              BO_HTables.Lookup (Cache.Keyed, Value (It).all, null);
+         begin
+            if BOs /= null then
+               Add_Candidates (BOs.all, Candidates);
+            end if;
+         end;
+         Next (It);
+      end loop;
+
+      Add_Candidates (Cache.Unkeyed, Candidates);
+
+      Leave (Cache.Lock);
+      Deallocate (Keys);
+
+      pragma Debug (C, O ("Get_Candidates: found"
+        & Natural'Image (BO_Ref_Lists.Length (Candidates))
+        & " candidate(s) for " & Binding_Data.Image (Pro)));
+   end Get_Candidates;
+
+   -------------------
+   -- Get_Node_Keys --
+   -------------------
+
+   procedure Get_Node_Keys
+     (BO   : Binding_Object_Access;
+      Keys : out Utils.Strings.Lists.List;
+      Done : out Boolean)
+   is
+   begin
+      --  Server side binding objects have no profile and are never reused
+
+      Done := BO.Profile = null;
+      if not Done then
+         Keys := Binding_Data.Node_Keys (BO.Profile.all);
+      end if;
+   end Get_Node_Keys;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize (Cache : in out Cache_Type) is
+   begin
+      Create (Cache.Lock);
+      BO_HTables.Initialize (Cache.Keyed);
+   end Initialize;
+
+   ------------
+   -- Insert --
+   ------------
+
+   procedure Insert (Cache : in out Cache_Type; BO : Binding_Object_Access) is
+      use Utils.Strings.Lists;
+
+      Keys : Utils.Strings.Lists.List;
+      Done : Boolean;
+      It   : Utils.Strings.Lists.Iterator;
+
+   begin
+      pragma Abort_Defer;
+
+      Get_Node_Keys (BO, Keys, Done);
+      if Done then
+         return;
+      end if;
+
+      Enter (Cache.Lock);
+
+      if Is_Empty (Keys) then
+         BO_Lists.Append (Cache.Unkeyed, BO);
+      end if;
+
+      It := First (Keys);
+      while not Last (It) loop
+         declare
+            Key : String renames Value (It).all;
+            BOs : BO_List_Access :=
+              BO_HTables.Lookup (Cache.Keyed, Key, null);
+         begin
+            if BOs = null then
+               BOs := new BO_Lists.List;
+               BO_HTables.Insert (Cache.Keyed, Key, BOs);
+            end if;
+            BO_Lists.Prepend (BOs.all, BO);
+         end;
+         Next (It);
+      end loop;
+
+      Leave (Cache.Lock);
+      Deallocate (Keys);
+   end Insert;
+
+   -------------------
+   -- Record_Lookup --
+   -------------------
+
+   procedure Record_Lookup
+     (Cache   : in out Cache_Type;
+      Outcome : Lookup_Outcome)
+   is
+   begin
+      pragma Abort_Defer;
+      Enter (Cache.Lock);
+      case Outcome is
+         when Hit =>
+            Cache.Stats.Hits := Cache.Stats.Hits + 1;
+         when Miss =>
+            Cache.Stats.Misses := Cache.Stats.Misses + 1;
+      end case;
+      Leave (Cache.Lock);
+   end Record_Lookup;
+
+   ------------
+   -- Remove --
+   ------------
+
+   procedure Remove (Cache : in out Cache_Type; BO : Binding_Object_Access) is
+      use Utils.Strings.Lists;
+
+      Keys    : Utils.Strings.Lists.List;
+      Done    : Boolean;
+      It      : Utils.Strings.Lists.Iterator;
+      Removed : Boolean := False;
+
+   begin
+      pragma Abort_Defer;
+
+      Get_Node_Keys (BO, Keys, Done);
+      if Done then
+         return;
+      end if;
+
+      Enter (Cache.Lock);
+
+      if Is_Empty (Keys) then
+         declare
+            Count : constant Natural := BO_Lists.Length (Cache.Unkeyed);
+         begin
+            BO_Lists.Remove_Occurrences (Cache.Unkeyed, BO);
+            Removed := BO_Lists.Length (Cache.Unkeyed) < Count;
+         end;
+      end if;
+
+      It := First (Keys);
+      while not Last (It) loop
+         declare
+            Key   : String renames Value (It).all;
+            BOs   : BO_List_Access :=
+              BO_HTables.Lookup (Cache.Keyed, Key, null);
+            Count : Natural;
+         begin
+            if BOs /= null then
+               Count := BO_Lists.Length (BOs.all);
+               BO_Lists.Remove_Occurrences (BOs.all, BO);
+               Removed := Removed or else BO_Lists.Length (BOs.all) < Count;
+
+               if BO_Lists.Is_Empty (BOs.all) then
+                  BO_HTables.Delete (Cache.Keyed, Key);
+                  Free (BOs);
+               end if;
+            end if;
+         end;
+         Next (It);
+      end loop;
+
+      if Removed then
+         Cache.Stats.Evictions := Cache.Stats.Evictions + 1;
+      end if;
+
+      Leave (Cache.Lock);
+      Deallocate (Keys);
+   end Remove;
+
+   -----------
+   -- Reuse --
+   -----------
+
+   procedure Reuse
+     (Cache : in out Cache_Type;
+      Ref   : in out Smart_Pointers.Ref;
+      BO    : Smart_Pointers.Entity_Ptr)
+   is
+   begin
+      pragma Abort_Defer;
+      Enter (Cache.Lock);
+      Smart_Pointers.Reuse_Entity (Ref, BO);
+      Leave (Cache.Lock);
+   end Reuse;
+
+   ----------------
+   -- Statistics --
+   ----------------
+
+   function Statistics (Cache : Cache_Type) return Cache_Statistics is
+      Result : Cache_Statistics;
+   begin
+      pragma Abort_Defer;
+      Enter (Cache.Lock);
+      Result := Cache.Stats;
+      Leave (Cache.Lock);
+      return Result;
+   end Statistics;
+
+end PolyORB.Binding_Objects.Cache;
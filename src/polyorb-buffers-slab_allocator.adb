@@ -0,0 +1,116 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--       P O L Y O R B . B U F F E R S . S L A B _ A L L O C A T O R        --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with PolyORB.Initialization;
+with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Utils.Strings;
+
+package body PolyORB.Buffers.Slab_Allocator is
+
+   use PolyORB.Log;
+
+   package L is new PolyORB.Log.Facility_Log
+     ("polyorb.buffers.slab_allocator");
+   procedure O (Message : String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   procedure Initialize;
+
+   --------------------
+   -- Get_Statistics --
+   --------------------
+
+   function Get_Statistics return PolyORB.Opaque.Slab_Statistics is
+   begin
+      return Buffer_Chunk_Pools.Get_Slab_Statistics;
+   end Get_Statistics;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize is
+      use PolyORB.Parameters;
+
+      Min_Size    : constant Natural :=
+        Get_Conf ("buffers", "slab_min_size", 1024);
+      Max_Size    : constant Natural :=
+        Get_Conf ("buffers", "slab_max_size", 64 * 1024);
+      Stripes     : constant Natural :=
+        Get_Conf ("buffers", "slab_stripes", 8);
+      Cache_Limit : constant Natural :=
+        Get_Conf ("buffers", "slab_cache_limit", 16);
+      Chunk_Size  : constant Natural :=
+        Get_Conf ("buffers", "chunk_size",
+                  Natural (Buffer_Chunk_Pools.Prealloc_Size));
+   begin
+      Buffer_Chunk_Pools.Set_Default_Chunk_Size
+        (Stream_Element_Count (Natural'Max (Chunk_Size, 1)));
+
+      if not Get_Conf ("buffers", "slab_allocator", True) then
+         pragma Debug (C, O ("Slab allocator disabled"));
+         return;
+      end if;
+
+      pragma Debug (C, O ("Size classes from" & Min_Size'Img
+                          & " to" & Max_Size'Img & " bytes,"
+                          & Stripes'Img & " stripes"));
+
+      Buffer_Chunk_Pools.Enable_Slabs
+        (Min_Class_Size => Stream_Element_Count (Min_Size),
+         Max_Class_Size => Stream_Element_Count (Max_Size),
+         Stripes        => Positive'Max (Stripes, 1),
+         Cache_Limit    => Cache_Limit);
+   end Initialize;
+
+   use PolyORB.Initialization;
+   use PolyORB.Initialization.String_Lists;
+   use PolyORB.Utils.Strings;
+
+begin
+   Register_Module
+     (Module_Info'
+      (Name      => +"buffers.slab_allocator",
+       Conflicts => Empty,
+       Depends   => +"parameters"
+         & "tasking.mutexes"
+         & "tasking.threads",
+       Provides  => Empty,
+       Implicit  => False,
+       Init      => Initialize'Access,
+       Shutdown  => null));
+end PolyORB.Buffers.Slab_Allocator;
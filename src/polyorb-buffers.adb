@@ -286,6 +286,15 @@ package body PolyORB.Buffers is
       Buffer.Length       := Buffer.Length + Size;
    end Insert_Raw_Data;
 
+   -----------------
+   -- Iovec_Count --
+   -----------------
+
+   function Iovec_Count (Buffer : access Buffer_Type) return Natural is
+   begin
+      return Iovec_Pools.Iovec_Count (Buffer.Contents);
+   end Iovec_Count;
+
    ---------------
    -- Pad_Align --
    ---------------
@@ -533,6 +542,60 @@ package body PolyORB.Buffers is
       Send_Iovec_Pool (Buffer.Contents'Access, Buffer.Length);
    end Send_Buffer;
 
+   ------------------
+   -- Send_Buffers --
+   ------------------
+
+   procedure Send_Buffers (Buffers : Buffer_Array) is
+      type Gathered_Iovecs is array (Positive range <>) of aliased Iovec;
+
+      Total_Iovecs : Natural := 0;
+      Remainder    : Storage_Offset := 0;
+      --  Number of Stream_Elements yet to be written
+   begin
+      for J in Buffers'Range loop
+         Total_Iovecs := Total_Iovecs + Iovec_Count (Buffers (J));
+         Remainder := Remainder + Storage_Offset (Buffers (J).Length);
+      end loop;
+
+      declare
+         Vecs  : Gathered_Iovecs (1 .. Total_Iovecs);
+         Index : Natural := 0;
+         Count : Storage_Offset;
+      begin
+         for J in Buffers'Range loop
+            if Iovec_Count (Buffers (J)) > 0 then
+               Iovec_Pools.Gather_Iovecs
+                 (Buffers (J).Contents, Vecs (Index + 1)'Access);
+               Index := Index + Iovec_Count (Buffers (J));
+            end if;
+         end loop;
+
+         Index := Vecs'First;
+         while Remainder > 0 loop
+            Lowlevel_Send (Vecs (Index)'Access, Vecs'Last - Index + 1, Count);
+
+            while Index <= Vecs'Last
+              and then Count >= Vecs (Index).Iov_Len
+            loop
+               Remainder := Remainder - Vecs (Index).Iov_Len;
+               Count := Count - Vecs (Index).Iov_Len;
+               Index := Index + 1;
+            end loop;
+
+            if Count > 0 then
+               Vecs (Index).Iov_Base := Vecs (Index).Iov_Base + Count;
+               Vecs (Index).Iov_Len  := Vecs (Index).Iov_Len  - Count;
+               Remainder := Remainder - Count;
+            end if;
+
+            --  Abort completion point, see Send_Iovec_Pool
+
+            delay 0.0;
+         end loop;
+      end;
+   end Send_Buffers;
+
    ----------------------
    -- Set_CDR_Position --
    ----------------------
@@ -904,6 +967,25 @@ package body PolyORB.Buffers is
          end if;
       end Extract_Data;
 
+      -------------------
+      -- Gather_Iovecs --
+      -------------------
+
+      procedure Gather_Iovecs
+        (Iovec_Pool : Iovec_Pool_Type;
+         Into       : access Iovec)
+      is
+         Pool_Vecs : Iovec_Array (1 .. Iovec_Pool.Last);
+         for Pool_Vecs'Address use Iovecs_Address (Iovec_Pool);
+         pragma Import (Ada, Pool_Vecs);
+
+         Into_Vecs : Iovec_Array (1 .. Iovec_Pool.Last);
+         for Into_Vecs'Address use Into.all'Address;
+         pragma Import (Ada, Into_Vecs);
+      begin
+         Into_Vecs := Pool_Vecs;
+      end Gather_Iovecs;
+
       -----------------
       -- Grow_Shrink --
       -----------------
@@ -996,6 +1078,15 @@ package body PolyORB.Buffers is
          end if;
       end Grow_Shrink;
 
+      -----------------
+      -- Iovec_Count --
+      -----------------
+
+      function Iovec_Count (Iovec_Pool : Iovec_Pool_Type) return Natural is
+      begin
+         return Iovec_Pool.Last;
+      end Iovec_Count;
+
       --------------------
       -- Iovecs_Address --
       --------------------
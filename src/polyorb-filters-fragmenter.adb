@@ -38,8 +38,7 @@ pragma Ada_2012;
 
 with PolyORB.Filters.Iface;
 with PolyORB.Log;
-with PolyORB.Types;
-with PolyORB.Representations.CDR.Common;
+with PolyORB.Opaque;
 
 package body PolyORB.Filters.Fragmenter is
 
@@ -93,13 +92,31 @@ package body PolyORB.Filters.Fragmenter is
       To   : access Buffer_Type;
       Len  :        Ada.Streams.Stream_Element_Count)
    is
-      use PolyORB.Representations.CDR.Common;
-      K : constant Stream_Element_Offset := CDR_Position (To);
-      Temp : Types.Octet;
+      K         : constant Stream_Element_Offset := CDR_Position (To);
+      Left      : Stream_Element_Count := Len;
+      Chunk     : Stream_Element_Count;
+      Src, Dst  : Opaque.Opaque_Pointer;
    begin
-      for J in 1 .. Integer (Len) loop
-         Temp := Unmarshall (From);
-         Marshall (To, Temp);
+      --  Copy whole contiguous chunks of From (normally a single one, since
+      --  a datagram is received in one piece) rather than single octets.
+
+      while Left > 0 loop
+         Chunk := Left;
+         Partial_Extract_Data (From, Src, Chunk);
+         pragma Assert (Chunk > 0);
+         Allocate_And_Insert_Cooked_Data (To, Chunk, Dst);
+         declare
+            Src_Data : Stream_Element_Array (1 .. Chunk);
+            for Src_Data'Address use Src;
+            pragma Import (Ada, Src_Data);
+
+            Dst_Data : Stream_Element_Array (1 .. Chunk);
+            for Dst_Data'Address use Dst;
+            pragma Import (Ada, Dst_Data);
+         begin
+            Dst_Data := Src_Data;
+         end;
+         Left := Left - Chunk;
       end loop;
       Set_CDR_Position (To, K);
    end Copy;
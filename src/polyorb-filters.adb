@@ -148,6 +148,7 @@ package body PolyORB.Filters is
         or else Msg in Data_Out'Class
         or else Msg in Disconnect_Request'Class
         or else Msg in Check_Validity'Class
+        or else Msg in Get_Peer_Name'Class
       then
          return Emit (F.Lower, Msg);
 
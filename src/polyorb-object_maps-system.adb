@@ -56,6 +56,7 @@ package body PolyORB.Object_Maps.System is
    overriding procedure Initialize (O_Map : in out System_Object_Map) is
    begin
       Initialize (O_Map.System_Map);
+      Free_Index_Tables.Initialize (O_Map.Free_Indices);
    end Initialize;
 
    --------------
@@ -65,6 +66,8 @@ package body PolyORB.Object_Maps.System is
    overriding procedure Finalize (O_Map : in out System_Object_Map) is
    begin
       Deallocate (O_Map.System_Map);
+      Free_Index_Tables.Deallocate (O_Map.Free_Indices);
+      Servant_Maps.Deallocate (O_Map.Servants);
    end Finalize;
 
    ---------
@@ -84,21 +87,32 @@ package body PolyORB.Object_Maps.System is
 
       --  First try to reuse one slice in object map
 
-      for J in First (O_Map.System_Map) .. Last (O_Map.System_Map) loop
-         if Is_Null (O_Map.System_Map.Table (J)) then
-            pragma Debug (C, O ("Replacing element" & Integer'Image (J)));
-            O_Map.System_Map.Table (1 + J - First (O_Map.System_Map)) := Obj;
+      declare
+         use Free_Index_Tables;
 
-            pragma Debug (C, O ("Add: leave"));
-            return J;
-         end if;
-      end loop;
+         J : Natural;
+      begin
+         while Last (O_Map.Free_Indices) >= First (O_Map.Free_Indices) loop
+            J := O_Map.Free_Indices.Table (Last (O_Map.Free_Indices));
+            Decrement_Last (O_Map.Free_Indices);
+
+            if Is_Null (O_Map.System_Map.Table (J)) then
+               pragma Debug (C, O ("Replacing element" & Integer'Image (J)));
+               O_Map.System_Map.Table (J) := Obj;
+               Add_Servant_Entry (O_Map.all, Obj);
+
+               pragma Debug (C, O ("Add: leave"));
+               return J;
+            end if;
+         end loop;
+      end;
 
       --  else, allocate one new element in table
 
       pragma Debug (C, O ("Appending element"));
       Increment_Last (O_Map.System_Map);
       O_Map.System_Map.Table (Last (O_Map.System_Map)) := Obj;
+      Add_Servant_Entry (O_Map.all, Obj);
 
       pragma Debug (C, O ("Add: leave"));
       return Last (O_Map.System_Map);
@@ -137,6 +151,7 @@ package body PolyORB.Object_Maps.System is
       --  Add new object map entry.
 
       O_Map.System_Map.Table (1 + Index - First (O_Map.System_Map)) := Obj;
+      Add_Servant_Entry (O_Map.all, Obj);
 
       pragma Debug (C, O ("Add: leave"));
    end Add;
@@ -162,37 +177,30 @@ package body PolyORB.Object_Maps.System is
         (Integer'Value (To_Standard_String (Item.Id)));
    end Get_By_Id;
 
-   --------------------
-   -- Get_By_Servant --
-   --------------------
+   ------------------------
+   -- Find_Servant_Entry --
+   ------------------------
 
-   overriding function Get_By_Servant
+   overriding function Find_Servant_Entry
      (O_Map  : System_Object_Map;
-      Item   : PolyORB.Servants.Servant_Access)
+      Item   : PolyORB.Servants.Servant_Access;
+      Except : Object_Map_Entry_Access)
      return Object_Map_Entry_Access
    is
       use type PolyORB.Servants.Servant_Access;
 
    begin
-      pragma Debug (C, O ("Get_By_Servant: enter"));
-
       for J in First (O_Map.System_Map) .. Last (O_Map.System_Map) loop
-         if not Is_Null (O_Map.System_Map.Table (J)) then
-            pragma Debug (C, O ("Examinating elt: "
-                             & To_Standard_String
-                             (O_Map.System_Map.Table (J).Oid.Id)));
-
-            if O_Map.System_Map.Table (J).Servant = Item then
-               pragma Debug (C, O ("Found !"));
-               return O_Map.System_Map.Table (J);
-            end if;
+         if not Is_Null (O_Map.System_Map.Table (J))
+           and then O_Map.System_Map.Table (J) /= Except
+           and then O_Map.System_Map.Table (J).Servant = Item
+         then
+            return O_Map.System_Map.Table (J);
          end if;
       end loop;
 
-      pragma Debug (C, O ("Not Found !"));
       return null;
-
-   end Get_By_Servant;
+   end Find_Servant_Entry;
 
    ------------------
    -- Remove_By_Id --
@@ -221,7 +229,16 @@ package body PolyORB.Object_Maps.System is
 
       begin
          Old_Entry := O_Map.System_Map.Table (Index);
-         O_Map.System_Map.Table (Index) := null;
+
+         if not Is_Null (Old_Entry) then
+            Remove_Servant_Entry (O_Map.all, Old_Entry);
+            O_Map.System_Map.Table (Index) := null;
+
+            Free_Index_Tables.Increment_Last (O_Map.Free_Indices);
+            O_Map.Free_Indices.Table
+              (Free_Index_Tables.Last (O_Map.Free_Indices)) := Index;
+         end if;
+
          return Old_Entry;
       end;
 
@@ -64,6 +64,7 @@ package body PolyORB.Object_Maps.User is
    overriding procedure Finalize (O_Map : in out User_Object_Map) is
    begin
       Finalize (O_Map.User_Map);
+      Servant_Maps.Deallocate (O_Map.Servants);
    end Finalize;
 
    ---------
@@ -75,6 +76,7 @@ package body PolyORB.Object_Maps.User is
       Obj   : Object_Map_Entry_Access) is
    begin
       Insert (O_Map.User_Map, To_Standard_String (Obj.Oid.Id), Obj);
+      Add_Servant_Entry (O_Map.all, Obj);
    end Add;
 
    ---------------
@@ -91,13 +93,14 @@ package body PolyORB.Object_Maps.User is
       return Lookup (O_Map.User_Map, To_Standard_String (Item.Id), null);
    end Get_By_Id;
 
-   --------------------
-   -- Get_By_Servant --
-   --------------------
+   ------------------------
+   -- Find_Servant_Entry --
+   ------------------------
 
-   overriding function Get_By_Servant
+   overriding function Find_Servant_Entry
      (O_Map  : User_Object_Map;
-      Item   : PolyORB.Servants.Servant_Access)
+      Item   : PolyORB.Servants.Servant_Access;
+      Except : Object_Map_Entry_Access)
      return Object_Map_Entry_Access
    is
       use type PolyORB.Servants.Servant_Access;
@@ -105,22 +108,18 @@ package body PolyORB.Object_Maps.User is
       It : Iterator := First (O_Map.User_Map);
    begin
       while not Last (It) loop
-         if not Is_Null (Value (It)) then
-            pragma Debug (C, O ("Examinating elt: "
-                             & To_Standard_String (Value (It).Oid.Id)));
-
-            if Value (It).Servant = Item then
-               pragma Debug (C, O ("Found !"));
-               return Value (It);
-            end if;
+         if not Is_Null (Value (It))
+           and then Value (It) /= Except
+           and then Value (It).Servant = Item
+         then
+            return Value (It);
          end if;
 
          Next (It);
       end loop;
 
-      pragma Debug (C, O ("Not Found !"));
       return null;
-   end Get_By_Servant;
+   end Find_Servant_Entry;
 
    ------------------
    -- Remove_By_Id --
@@ -136,7 +135,12 @@ package body PolyORB.Object_Maps.User is
       Name : constant String := To_Standard_String (Item.Id);
    begin
       Old_Entry := Lookup (O_Map.User_Map, Name, null);
-      Delete (O_Map.User_Map, Name);
+
+      if not Is_Null (Old_Entry) then
+         Remove_Servant_Entry (O_Map.all, Old_Entry);
+         Delete (O_Map.User_Map, Name);
+      end if;
+
       return Old_Entry;
    end Remove_By_Id;
 
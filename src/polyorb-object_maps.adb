@@ -32,6 +32,70 @@
 
 package body PolyORB.Object_Maps is
 
+   use Servant_Maps;
+
+   use type PolyORB.Servants.Servant_Access;
+
+   function Servant_Id
+     (Item : PolyORB.Servants.Servant_Access)
+     return System.Storage_Elements.Integer_Address;
+   pragma Inline (Servant_Id);
+   --  Key of Item in the reverse index
+
+   -----------------------
+   -- Add_Servant_Entry --
+   -----------------------
+
+   procedure Add_Servant_Entry
+     (O_Map : in out Object_Map'Class;
+      Obj   : Object_Map_Entry_Access)
+   is
+      SE : Servant_Entry;
+   begin
+      if Obj.Servant = null then
+         return;
+      end if;
+
+      SE := Lookup (O_Map.Servants, Servant_Id (Obj.Servant));
+      if SE.The_Entry = null then
+         SE.The_Entry := Obj;
+      end if;
+      SE.Count := SE.Count + 1;
+      Replace (O_Map.Servants, Servant_Id (Obj.Servant), SE);
+   end Add_Servant_Entry;
+
+   ------------------------
+   -- Find_Servant_Entry --
+   ------------------------
+
+   function Find_Servant_Entry
+     (O_Map  : Object_Map;
+      Item   : PolyORB.Servants.Servant_Access;
+      Except : Object_Map_Entry_Access)
+     return Object_Map_Entry_Access
+   is
+      pragma Unreferenced (O_Map, Item, Except);
+   begin
+      return null;
+   end Find_Servant_Entry;
+
+   --------------------
+   -- Get_By_Servant --
+   --------------------
+
+   function Get_By_Servant
+     (O_Map  : Object_Map;
+      Item   : PolyORB.Servants.Servant_Access)
+     return Object_Map_Entry_Access
+   is
+   begin
+      if Item = null then
+         return null;
+      end if;
+
+      return Lookup (O_Map.Servants, Servant_Id (Item)).The_Entry;
+   end Get_By_Servant;
+
    -------------
    -- Is_Null --
    -------------
@@ -67,4 +131,58 @@ package body PolyORB.Object_Maps is
       return not Is_Null (Get_By_Id (Object_Map'Class (O_Map), Item));
    end Is_Object_Id_In;
 
+   --------------------------
+   -- Remove_Servant_Entry --
+   --------------------------
+
+   procedure Remove_Servant_Entry
+     (O_Map : in out Object_Map'Class;
+      Obj   : Object_Map_Entry_Access)
+   is
+      SE : Servant_Entry;
+   begin
+      if Obj.Servant = null then
+         return;
+      end if;
+
+      SE := Lookup (O_Map.Servants, Servant_Id (Obj.Servant));
+      if SE.Count <= 1 then
+         Remove (O_Map.Servants, Servant_Id (Obj.Servant), SE);
+         return;
+      end if;
+
+      SE.Count := SE.Count - 1;
+      if SE.The_Entry = Obj then
+         SE.The_Entry := Find_Servant_Entry (O_Map, Obj.Servant, Obj);
+      end if;
+      Replace (O_Map.Servants, Servant_Id (Obj.Servant), SE);
+   end Remove_Servant_Entry;
+
+   ----------------
+   -- Servant_Id --
+   ----------------
+
+   function Servant_Id
+     (Item : PolyORB.Servants.Servant_Access)
+     return System.Storage_Elements.Integer_Address
+   is
+   begin
+      return System.Storage_Elements.To_Integer (Item.all'Address);
+   end Servant_Id;
+
+   -----------------
+   -- Set_Servant --
+   -----------------
+
+   procedure Set_Servant
+     (O_Map   : access Object_Map'Class;
+      Obj     : Object_Map_Entry_Access;
+      Servant : PolyORB.Servants.Servant_Access)
+   is
+   begin
+      Remove_Servant_Entry (O_Map.all, Obj);
+      Obj.Servant := Servant;
+      Add_Servant_Entry (O_Map.all, Obj);
+   end Set_Servant;
+
 end PolyORB.Object_Maps;
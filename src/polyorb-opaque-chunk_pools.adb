@@ -33,11 +33,72 @@
 --  Pools of memory chunks, with associated client metadata.
 
 with Ada.Unchecked_Deallocation;
+with Interfaces;
+with System.Storage_Elements;
+
+with PolyORB.Tasking.Mutexes;
+with PolyORB.Tasking.Threads;
 
 package body PolyORB.Opaque.Chunk_Pools is
 
    use Ada.Streams;
    use Chunk_Lists;
+   use Interfaces;
+   use PolyORB.Tasking.Mutexes;
+
+   procedure Free is new Ada.Unchecked_Deallocation (Chunk, Chunk_Access);
+
+   Min_Chunk_Size : Stream_Element_Count := Prealloc_Size;
+   --  See Default_Chunk_Size
+
+   --------------------------
+   -- Slab allocator state --
+   --------------------------
+
+   type Chunk_Array is array (1 .. Max_Size_Classes) of Chunk_Access;
+   type Count_Array is array (1 .. Max_Size_Classes) of Natural;
+
+   type Slab_Stripe is record
+      Lock       : Mutex_Access;
+
+      Free_Lists : Chunk_Array := (others => null);
+      --  Free chunks of each size class, linked through their Next
+      --  component.
+
+      Free_Count : Count_Array := (others => 0);
+
+      Stats      : Slab_Statistics;
+      --  Counters for operations performed on this stripe
+   end record;
+
+   type Stripe_Array is array (1 .. Max_Stripes) of Slab_Stripe;
+
+   Slabs_Enabled : Boolean := False;
+   --  Set once by Enable_Slabs, before chunk pools are used concurrently
+
+   Class_Count   : Natural := 0;
+   Class_Sizes   : array (1 .. Max_Size_Classes) of Stream_Element_Count :=
+                     (others => 0);
+   Stripe_Count  : Positive := 1;
+   Free_Limit    : Natural := 0;
+   Stripes       : Stripe_Array;
+
+   function Size_Class (Size : Stream_Element_Count) return Natural;
+   pragma Inline (Size_Class);
+   --  Return the smallest size class that can hold Size elements, or 0 if
+   --  Size exceeds the largest class.
+
+   function Home_Stripe return Positive;
+   pragma Inline (Home_Stripe);
+   --  Return the stripe (magazine) associated with the current task
+
+   function Slab_Allocate (Class : Positive) return Chunk_Access;
+   --  Return a chunk of the given size class, taken from a free list if
+   --  possible, else allocated from the system.
+
+   procedure Slab_Release (A_Chunk : in out Chunk_Access);
+   --  Put A_Chunk, allocated from a slab, on the free list of the current
+   --  task's stripe, or return it to the system if that list is full.
 
    --------------
    -- Allocate --
@@ -58,13 +119,18 @@ package body PolyORB.Opaque.Chunk_Pools is
          Allocation_Size := Size;
       end if;
 
-      if Allocation_Size = Default_Chunk_Size
+      if Size <= Prealloc_Size
         and then not Pool.Prealloc_Used
       then
          New_Chunk := Pool.Prealloc'Unchecked_Access;
          Pool.Prealloc_Used := True;
+
       else
-         New_Chunk := new Chunk (Size => Allocation_Size);
+         if Slabs_Enabled and then Size_Class (Allocation_Size) /= 0 then
+            New_Chunk := Slab_Allocate (Size_Class (Allocation_Size));
+         else
+            New_Chunk := new Chunk (Size => Allocation_Size);
+         end if;
          Append (Pool.Dynamic_Chunks, New_Chunk);
       end if;
 
@@ -81,6 +147,15 @@ package body PolyORB.Opaque.Chunk_Pools is
       return A_Chunk.Data (A_Chunk.Data'First)'Address;
    end Chunk_Storage;
 
+   ------------------------
+   -- Default_Chunk_Size --
+   ------------------------
+
+   function Default_Chunk_Size return Stream_Element_Count is
+   begin
+      return Min_Chunk_Size;
+   end Default_Chunk_Size;
+
    ----------
    -- Link --
    ----------
@@ -110,7 +185,6 @@ package body PolyORB.Opaque.Chunk_Pools is
    -------------
 
    procedure Release (Pool : access Pool_Type) is
-      procedure Free is new Ada.Unchecked_Deallocation (Chunk, Chunk_Access);
       It : Chunk_Lists.Iterator := First (Pool.Dynamic_Chunks);
    begin
       while not Last (It) loop
@@ -118,10 +192,208 @@ package body PolyORB.Opaque.Chunk_Pools is
             This : Chunk_Access := Value (It);
          begin
             Remove (Pool.Dynamic_Chunks, It);
-            Free (This);
+            if This.Class /= 0 then
+               Slab_Release (This);
+            else
+               Free (This);
+            end if;
          end;
       end loop;
       Pool.Prealloc_Used := False;
    end Release;
 
+   ----------------------------
+   -- Set_Default_Chunk_Size --
+   ----------------------------
+
+   procedure Set_Default_Chunk_Size (Size : Stream_Element_Count) is
+   begin
+      Min_Chunk_Size := Size;
+   end Set_Default_Chunk_Size;
+
+   -------------------
+   -- Slab_Allocate --
+   -------------------
+
+   function Slab_Allocate (Class : Positive) return Chunk_Access is
+      Home   : constant Positive := Home_Stripe;
+      Result : Chunk_Access;
+   begin
+      --  Look at the free list of the current task's stripe first, then at
+      --  the other stripes, in case chunks are typically allocated by one
+      --  task and released by another.
+
+      for J in 0 .. Stripe_Count - 1 loop
+         declare
+            S : Slab_Stripe renames
+                  Stripes ((Home - 1 + J) mod Stripe_Count + 1);
+         begin
+            Enter (S.Lock);
+            if J = 0 then
+               S.Stats.Allocations := S.Stats.Allocations + 1;
+            end if;
+
+            Result := S.Free_Lists (Class);
+            if Result /= null then
+               S.Free_Lists (Class) := Result.Next;
+               S.Free_Count (Class) := S.Free_Count (Class) - 1;
+               S.Stats.Cache_Hits := S.Stats.Cache_Hits + 1;
+               S.Stats.Cached_Bytes :=
+                 S.Stats.Cached_Bytes - Long_Long_Integer (Result.Size);
+               Leave (S.Lock);
+
+               Result.Next := null;
+               return Result;
+            end if;
+            Leave (S.Lock);
+         end;
+      end loop;
+
+      Result := new Chunk (Size => Class_Sizes (Class));
+      Result.Class := Class;
+
+      declare
+         S : Slab_Stripe renames Stripes (Home);
+      begin
+         Enter (S.Lock);
+         S.Stats.Heap_Allocations := S.Stats.Heap_Allocations + 1;
+         S.Stats.Resident_Bytes :=
+           S.Stats.Resident_Bytes + Long_Long_Integer (Result.Size);
+         Leave (S.Lock);
+      end;
+
+      return Result;
+   end Slab_Allocate;
+
+   ------------------
+   -- Slab_Release --
+   ------------------
+
+   procedure Slab_Release (A_Chunk : in out Chunk_Access) is
+      Class : constant Positive := A_Chunk.Class;
+      S     : Slab_Stripe renames Stripes (Home_Stripe);
+   begin
+      Enter (S.Lock);
+      if S.Free_Count (Class) < Free_Limit then
+         A_Chunk.Next := S.Free_Lists (Class);
+         S.Free_Lists (Class) := A_Chunk;
+         S.Free_Count (Class) := S.Free_Count (Class) + 1;
+         S.Stats.Cached_Bytes :=
+           S.Stats.Cached_Bytes + Long_Long_Integer (A_Chunk.Size);
+         Leave (S.Lock);
+         A_Chunk := null;
+
+      else
+         S.Stats.Heap_Deallocations := S.Stats.Heap_Deallocations + 1;
+         S.Stats.Resident_Bytes :=
+           S.Stats.Resident_Bytes - Long_Long_Integer (A_Chunk.Size);
+         Leave (S.Lock);
+         Free (A_Chunk);
+      end if;
+   end Slab_Release;
+
+   ----------------
+   -- Size_Class --
+   ----------------
+
+   function Size_Class (Size : Stream_Element_Count) return Natural is
+   begin
+      for J in 1 .. Class_Count loop
+         if Class_Sizes (J) >= Size then
+            return J;
+         end if;
+      end loop;
+      return 0;
+   end Size_Class;
+
+   -----------------
+   -- Home_Stripe --
+   -----------------
+
+   function Home_Stripe return Positive is
+      use System.Storage_Elements;
+      use PolyORB.Tasking.Threads;
+
+      Key : constant Integer_Address :=
+              To_Integer (To_Address (Current_Task));
+   begin
+      --  Task identifiers are addresses of task control blocks: drop the
+      --  low-order bits, which are mostly identical from one task to the
+      --  next, and fold some higher-order ones in.
+
+      return Positive
+        ((Key / 2 ** 6 + Key / 2 ** 14) mod Integer_Address (Stripe_Count)
+         + 1);
+   end Home_Stripe;
+
+   ------------------
+   -- Enable_Slabs --
+   ------------------
+
+   procedure Enable_Slabs
+     (Min_Class_Size : Stream_Element_Count;
+      Max_Class_Size : Stream_Element_Count;
+      Stripes        : Positive;
+      Cache_Limit    : Natural)
+   is
+      Class_Size : Stream_Element_Count := 1;
+   begin
+      pragma Assert (not Slabs_Enabled);
+
+      while Class_Size < Min_Class_Size loop
+         Class_Size := 2 * Class_Size;
+      end loop;
+
+      Class_Count := 0;
+      while Class_Size <= Max_Class_Size
+        and then Class_Count < Max_Size_Classes
+      loop
+         Class_Count := Class_Count + 1;
+         Class_Sizes (Class_Count) := Class_Size;
+         Class_Size := 2 * Class_Size;
+      end loop;
+
+      Stripe_Count := Positive'Min (Stripes, Max_Stripes);
+      Free_Limit   := Cache_Limit;
+
+      for J in 1 .. Stripe_Count loop
+         Create (Chunk_Pools.Stripes (J).Lock);
+      end loop;
+
+      Slabs_Enabled := Class_Count > 0;
+   end Enable_Slabs;
+
+   -------------------------
+   -- Get_Slab_Statistics --
+   -------------------------
+
+   function Get_Slab_Statistics return Slab_Statistics is
+      Result : Slab_Statistics;
+   begin
+      if not Slabs_Enabled then
+         return Result;
+      end if;
+
+      for J in 1 .. Stripe_Count loop
+         declare
+            S : Slab_Stripe renames Stripes (J);
+         begin
+            Enter (S.Lock);
+            Result.Allocations := Result.Allocations + S.Stats.Allocations;
+            Result.Cache_Hits  := Result.Cache_Hits + S.Stats.Cache_Hits;
+            Result.Heap_Allocations :=
+              Result.Heap_Allocations + S.Stats.Heap_Allocations;
+            Result.Heap_Deallocations :=
+              Result.Heap_Deallocations + S.Stats.Heap_Deallocations;
+            Result.Resident_Bytes :=
+              Result.Resident_Bytes + S.Stats.Resident_Bytes;
+            Result.Cached_Bytes :=
+              Result.Cached_Bytes + S.Stats.Cached_Bytes;
+            Leave (S.Lock);
+         end;
+      end loop;
+
+      return Result;
+   end Get_Slab_Statistics;
+
 end PolyORB.Opaque.Chunk_Pools;
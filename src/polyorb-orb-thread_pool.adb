@@ -228,7 +228,16 @@ package body PolyORB.ORB.Thread_Pool is
    is
       pragma Unreferenced (P);
    begin
-      --  Queue Request_Job to general ORB controller job queue
+      --  Let the ORB controller dispatch the job to a private queue, if it
+      --  has one, without entering the ORB critical section.
+
+      if Try_Dispatch_Request_Job
+        (ORB.ORB_Controller, Job_Access (RJ), RJ.Request.Target)
+      then
+         return;
+      end if;
+
+      --  Otherwise queue Request_Job to general ORB controller job queue
 
       Enter_ORB_Critical_Section (ORB.ORB_Controller);
       Notify_Event (ORB.ORB_Controller,
@@ -38,7 +38,10 @@ with Ada.Exceptions;
 with Ada.Finalization;
 with Ada.Tags;
 
+with System.Storage_Elements;
+
 with PolyORB.Any.Initialization;
+with PolyORB.Arenas;
 with PolyORB.Binding_Data.Local;
 with PolyORB.Binding_Object_QoS;
 with PolyORB.Errors;
@@ -46,6 +49,7 @@ with PolyORB.Filters.Iface;
 with PolyORB.Initialization;
 with PolyORB.Log;
 with PolyORB.ORB.Iface;
+with PolyORB.Parameters;
 with PolyORB.Parameters.Initialization;
 with PolyORB.References.Binding;
 with PolyORB.Request_QoS;
@@ -87,6 +91,10 @@ package body PolyORB.ORB is
    function C (Level : Log_Level := Debug) return Boolean
      renames L.Enabled;
 
+   Request_Arenas : Boolean := True;
+   --  True if the values built while executing a request are allocated from
+   --  an arena associated with the request (see Run_Request).
+
    ----------------------------------------------
    -- Management of asynchronous event sources --
    ----------------------------------------------
@@ -137,7 +145,7 @@ package body PolyORB.ORB is
    procedure Add_Binding_Object
      (ORB : access ORB_Type;
       BO  : Binding_Object_Access);
-   --  Add BO to ORB's Binding_Objects list
+   --  Add BO to ORB's Binding_Objects list and binding object cache
 
    ------------------------
    -- Add_Binding_Object --
@@ -152,21 +160,31 @@ package body PolyORB.ORB is
       Enter_ORB_Critical_Section (ORB.ORB_Controller);
       PBOL.Prepend (ORB.Binding_Objects, BO);
       Set_Referenced (BO, Referenced => True);
+      PBOC.Insert (ORB.Binding_Object_Cache, BO);
       Leave_ORB_Critical_Section (ORB.ORB_Controller);
    end Add_Binding_Object;
 
+   -------------------------------------
+   -- Binding_Object_Cache_Statistics --
+   -------------------------------------
+
+   function Binding_Object_Cache_Statistics
+     (ORB : access ORB_Type) return PBOC.Cache_Statistics
+   is
+   begin
+      return PBOC.Statistics (ORB.Binding_Object_Cache);
+   end Binding_Object_Cache_Statistics;
+
    ------------
    -- Create --
    ------------
 
    procedure Create (ORB : in out ORB_Type) is
-      pragma Unreferenced (ORB);
-
    begin
       --  Note: this function will be completed when implementing support for
       --  multiple ORB instances, as mandated by the CORBA personality.
 
-      null;
+      PBOC.Initialize (ORB.Binding_Object_Cache);
    end Create;
 
    ----------------------------------
@@ -207,6 +225,8 @@ package body PolyORB.ORB is
 
       use BO_Ref_Lists;
 
+      Candidates   : PBOC.BO_Ref_Lists.List;
+      Indexed      : Boolean;
       Reusable_BOs : BO_Ref_List;
       Result : Smart_Pointers.Ref;
 
@@ -214,18 +234,61 @@ package body PolyORB.ORB is
 
    begin
       pragma Debug (C, O ("Find_Reusable_Binding_Object: enter"));
-      pragma Debug (C, O ("#BO registered = "
-        & Natural'Image (Length (ORB.Binding_Objects))));
 
-      Reusable_BOs := Get_Binding_Objects (ORB, Is_Reusable'Access);
+      --  Look up the binding object cache first: only the binding objects
+      --  that may designate the same node as Pro are examined, and the ORB
+      --  critical section is not entered.
+
+      PBOC.Get_Candidates
+        (ORB.Binding_Object_Cache, Pro.all, Candidates, Indexed);
+
+      if Indexed then
+         while Smart_Pointers.Is_Nil (Result)
+           and then not PBOC.BO_Ref_Lists.Is_Empty (Candidates)
+         loop
+            declare
+               Ref    : Smart_Pointers.Ref;
+               BO_Acc : Binding_Object_Access;
+            begin
+               PBOC.BO_Ref_Lists.Extract_First (Candidates, Ref);
+               BO_Acc :=
+                 Binding_Object_Access (Smart_Pointers.Entity_Of (Ref));
+
+               --  Purge stale binding objects, as Get_Binding_Objects does
+
+               if not Valid (BO_Acc) then
+                  Unregister_Binding_Object (ORB, BO_Acc);
+
+               elsif Is_Reusable (BO_Acc) then
+                  Result := Ref;
+               end if;
+            end;
+         end loop;
+         PBOC.BO_Ref_Lists.Deallocate (Candidates);
+
+         if Smart_Pointers.Is_Nil (Result) then
+            PBOC.Record_Lookup (ORB.Binding_Object_Cache, PBOC.Miss);
+         else
+            PBOC.Record_Lookup (ORB.Binding_Object_Cache, PBOC.Hit);
+         end if;
+
+      else
+         --  Pro cannot be looked up in the cache: examine all binding
+         --  objects.
+
+         pragma Debug (C, O ("#BO registered = "
+           & Natural'Image (Length (ORB.Binding_Objects))));
+
+         Reusable_BOs := Get_Binding_Objects (ORB, Is_Reusable'Access);
 
-      if not Is_Empty (Reusable_BOs) then
-         Extract_First (Reusable_BOs, Result);
+         if not Is_Empty (Reusable_BOs) then
+            Extract_First (Reusable_BOs, Result);
 
-         --  Get_Binding_Objects with a non-null predicate is expected to
-         --  return at most one object.
+            --  Get_Binding_Objects with a non-null predicate is expected to
+            --  return at most one object.
 
-         pragma Assert (Is_Empty (Reusable_BOs));
+            pragma Assert (Is_Empty (Reusable_BOs));
+         end if;
       end if;
 
       pragma Debug (C, O ("Find_Reusable_Binding_Object: leave"));
@@ -822,9 +885,28 @@ package body PolyORB.ORB is
       end if;
 
       Leave_ORB_Critical_Section (ORB_Acc.ORB_Controller);
+
+      --  BO may already have been removed from the Binding_Objects list by
+      --  Get_Binding_Objects, but it must be removed from the cache in any
+      --  case before it is deallocated.
+
+      PBOC.Remove (ORB_Acc.Binding_Object_Cache, BO);
       pragma Debug (C, O ("Unregister_Binding_Object: leave"));
    end Unregister_Binding_Object;
 
+   --------------------------
+   -- Reuse_Binding_Object --
+   --------------------------
+
+   procedure Reuse_Binding_Object
+     (ORB : access ORB_Type;
+      Ref : in out Smart_Pointers.Ref;
+      BO  : Smart_Pointers.Entity_Ptr)
+   is
+   begin
+      PBOC.Reuse (ORB.Binding_Object_Cache, Ref, BO);
+   end Reuse_Binding_Object;
+
    ------------------------
    -- Set_Object_Adapter --
    ------------------------
@@ -877,7 +959,7 @@ package body PolyORB.ORB is
 
       declare
          Monitors : constant Monitor_Array :=
-           Get_Monitors (ORB.ORB_Controller);
+           Monitors_For_Source (ORB.ORB_Controller, AES);
          AEM      : Asynch_Ev_Monitor_Access;
          RSR      : Register_Source_Result := Unknown_Source_Type;
       begin
@@ -920,7 +1002,8 @@ package body PolyORB.ORB is
          if RSR = Success then
             Notify_Event (ORB.ORB_Controller,
                           Event'(Kind           => Event_Sources_Added,
-                                 Add_In_Monitor => AEM));
+                                 Add_In_Monitor => AEM,
+                                 Added_Source   => AES));
 
          else
             pragma Debug (C, O ("Insert_Source: failed to register source"));
@@ -1114,41 +1197,57 @@ package body PolyORB.ORB is
          --  to the oid of the current called instance, in the context
          --  of a servant handling multiple oids.)
 
+         --  Allocate the values built while executing the request (e.g.
+         --  the arguments and result of a dynamic skeleton) from an arena
+         --  that is released in bulk once the request has been destroyed.
+         --  The arena is created on the first such allocation, so that
+         --  requests that build no values do not pay for one.
+
          declare
-            Result : constant Components.Message'Class :=
-              Emit (Req.Surrogate,
-                    Servants.Iface.Execute_Request'
-                      (Req => Req, Pro => Req.Profile));
+            Scope : Arenas.Arena_Scope;
          begin
-            --  Unsetup_Environment ();
-            --  Unbind (J.Req.Target, J.ORB, Servant);
-            --  XXX Unbind must Release_Servant.
-
-            --  XXX Actually cannot unbind here: if the binding object is
-            --    destroyed that early, we won't have the opportunity to
-            --    receive a reply...
-            pragma Debug (C, O ("Run_Request: got "
-              & Ada.Tags.External_Tag (Result'Tag)));
-
-            if Result in Null_Message then
-               pragma Debug (C, O ("Run_Request: task " & Image (Current_Task)
-                                 & " queued request for later processing"));
-               null;
-
-            else
-               pragma Debug (C, O ("Run_Request: task " & Image (Current_Task)
-                                 & " processed request"));
-               Emit_No_Reply (Req.Requesting_Component, Result);
-
-               --  Note: On the server side, the transport layer might detect
-               --  a disconnect while we are processing a request. However,
-               --  the request contains a reference to the session (as part
-               --  of its Dependent_Binding_Object), so here we know that
-               --  the Requesting_Component is still valid (has not been
-               --  destroyed yet). We used to have an exception handler here
-               --  because requestes formely lacked this reference to the
-               --  binding object.
+            if Request_Arenas then
+               Arenas.Enter_On_Demand (Scope, Req.Arena'Access);
             end if;
+
+            declare
+               Result : constant Components.Message'Class :=
+                 Emit (Req.Surrogate,
+                       Servants.Iface.Execute_Request'
+                         (Req => Req, Pro => Req.Profile));
+            begin
+               --  Unsetup_Environment ();
+               --  Unbind (J.Req.Target, J.ORB, Servant);
+               --  XXX Unbind must Release_Servant.
+
+               --  XXX Actually cannot unbind here: if the binding object is
+               --    destroyed that early, we won't have the opportunity to
+               --    receive a reply...
+               pragma Debug (C, O ("Run_Request: got "
+                 & Ada.Tags.External_Tag (Result'Tag)));
+
+               if Result in Null_Message then
+                  pragma Debug (C, O ("Run_Request: task "
+                                   & Image (Current_Task)
+                                   & " queued request for later processing"));
+                  null;
+
+               else
+                  pragma Debug (C, O ("Run_Request: task "
+                                   & Image (Current_Task)
+                                   & " processed request"));
+                  Emit_No_Reply (Req.Requesting_Component, Result);
+
+                  --  Note: On the server side, the transport layer might
+                  --  detect a disconnect while we are processing a request.
+                  --  However, the request contains a reference to the session
+                  --  (as part of its Dependent_Binding_Object), so here we
+                  --  know that the Requesting_Component is still valid (has
+                  --  not been destroyed yet). We used to have an exception
+                  --  handler here because requestes formely lacked this
+                  --  reference to the binding object.
+               end if;
+            end;
          end;
       end;
    end Run_Request;
@@ -1400,11 +1499,13 @@ package body PolyORB.ORB is
                --  automatically.
 
                Set_Referenced (BO_Acc, Referenced => False);
+               PBOC.Remove (ORB.Binding_Object_Cache, BO_Acc);
                Remove (ORB.Binding_Objects, It);
 
             else
                if Predicate = null or else Predicate (BO_Acc) then
-                  Smart_Pointers.Reuse_Entity (Ref, Entity_Ptr (Value (It)));
+                  PBOC.Reuse
+                    (ORB.Binding_Object_Cache, Ref, Entity_Ptr (Value (It)));
 
                   --  If binding object is being finalized, Reuse_Entity leaves
                   --  Ref unset.
@@ -1445,8 +1546,15 @@ package body PolyORB.ORB is
    procedure Initialize;
 
    procedure Initialize is
+      use PolyORB.Parameters;
+
       The_Controller : POC.ORB_Controller_Access;
    begin
+      Request_Arenas := Get_Conf ("requests", "arena", True);
+      Arenas.Set_Chunk_Size
+        (System.Storage_Elements.Storage_Count
+           (Get_Conf ("requests", "arena_chunk_size", 8 * 1024)));
+
       Create (The_Controller);
       Setup.The_ORB := new ORB_Type (Setup.The_Tasking_Policy, The_Controller);
       Create (Setup.The_ORB.all);
@@ -1490,6 +1598,7 @@ begin
                    & "binding_data.srp?"
                    & "binding_data.iiop?"
                    & "orb_controller"
+                   & "parameters"
                    --  ??? should not have hard-coded dependencies
                    --  on specific protocols!
                    & "protocols.srp?"
@@ -179,6 +179,8 @@ package body PolyORB.ORB_Controller.Half_Sync_Half_Async is
                   for J in O.AEM_Infos'Range loop
                      if O.AEM_Infos (J).Monitor = null then
                         O.AEM_Infos (J).Monitor := E.Add_In_Monitor;
+                        O.AEM_Infos (J).Factory :=
+                          AEM_Factory_Of (E.Added_Source.all);
                         AEM_Index := J;
                         exit;
                      end if;
@@ -118,6 +118,8 @@ package body PolyORB.ORB_Controller.No_Tasking is
                   for J in O.AEM_Infos'Range loop
                      if O.AEM_Infos (J).Monitor = null then
                         O.AEM_Infos (J).Monitor := E.Add_In_Monitor;
+                        O.AEM_Infos (J).Factory :=
+                          AEM_Factory_Of (E.Added_Source.all);
                         AEM_Index := J;
                         exit;
                      end if;
@@ -35,6 +35,10 @@ pragma Ada_2012;
 with Ada.Tags;
 with PolyORB.Asynch_Ev;
 with PolyORB.Initialization;
+with PolyORB.Parameters;
+with PolyORB.Tasking.Priorities;
+with PolyORB.Tasking.Threads;
+with PolyORB.Types;
 with PolyORB.Utils.Strings;
 
 package body PolyORB.ORB_Controller.Workers is
@@ -146,6 +150,8 @@ package body PolyORB.ORB_Controller.Workers is
                   for J in O.AEM_Infos'Range loop
                      if O.AEM_Infos (J).Monitor = null then
                         O.AEM_Infos (J).Monitor := E.Add_In_Monitor;
+                        O.AEM_Infos (J).Factory :=
+                          AEM_Factory_Of (E.Added_Source.all);
                         AEM_Index := J;
                         exit;
                      end if;
@@ -197,6 +203,14 @@ package body PolyORB.ORB_Controller.Workers is
                end if;
             end loop;
 
+            --  Stop reactor lanes once they have processed their queued jobs
+
+            if O.Reactor_Lanes /= null then
+               for J in O.Reactor_Lanes'Range loop
+                  PolyORB.Lanes.Destroy (O.Reactor_Lanes (J));
+               end loop;
+            end if;
+
          when Queue_Event_Job =>
 
             --  Queue event to main job queue
@@ -361,6 +375,33 @@ package body PolyORB.ORB_Controller.Workers is
       pragma Debug (C2, O2 (Status (O.all)));
    end Schedule_Task;
 
+   ------------------------------
+   -- Try_Dispatch_Request_Job --
+   ------------------------------
+
+   overriding function Try_Dispatch_Request_Job
+     (O      : access ORB_Controller_Workers;
+      J      : PJ.Job_Access;
+      Target : PR.Ref) return Boolean
+   is
+      pragma Unreferenced (Target);
+
+      Lane_Index : Positive;
+
+   begin
+      if O.Reactor_Lanes = null or else Shutting_Down (O.all) then
+         return False;
+      end if;
+
+      Lane_Index := O.Next_Lane mod O.Reactor_Lanes'Length + 1;
+      O.Next_Lane := Lane_Index;
+
+      pragma Debug (C1, O1 ("Queue Request_Job to reactor lane"
+                        & Positive'Image (Lane_Index)));
+      PolyORB.Lanes.Queue_Job (O.Reactor_Lanes (Lane_Index), J);
+      return True;
+   end Try_Dispatch_Request_Job;
+
    ------------
    -- Create --
    ------------
@@ -369,12 +410,44 @@ package body PolyORB.ORB_Controller.Workers is
      (OCF : ORB_Controller_Workers_Factory) return ORB_Controller_Access
    is
       pragma Unreferenced (OCF);
-      OC : ORB_Controller_Workers_Access;
-      RS : PRS.Request_Scheduler_Access;
+      use type PRS.Request_Scheduler_Access;
+
+      OC       : ORB_Controller_Workers_Access;
+      RS       : PRS.Request_Scheduler_Access;
+      Reactors : constant Positive := Configured_Reactors;
+
    begin
       PRS.Create (RS);
       OC := new ORB_Controller_Workers (RS);
-      Initialize (ORB_Controller (OC.all));
+      Initialize (ORB_Controller (OC.all), Reactors => Reactors);
+
+      if Reactors > 1 and then RS = null then
+         declare
+            use PolyORB.Parameters;
+
+            Tasks : constant Positive := Integer'Max
+              (1, Get_Conf ("orb_controller",
+                            "polyorb.orb_controller.reactor_tasks", 2));
+         begin
+            OC.Reactor_Lanes := new Lane_Array (1 .. Reactors);
+            for J in OC.Reactor_Lanes'Range loop
+               OC.Reactor_Lanes (J) := PolyORB.Lanes.Create
+                 (ORB_Priority              =>
+                    PolyORB.Tasking.Priorities.Default_Component_Priority,
+                  Ext_Priority              =>
+                    PolyORB.Tasking.Priorities.Invalid_Priority,
+                  Base_Number_Of_Threads    => Tasks,
+                  Dynamic_Number_Of_Threads => 0,
+                  Stack_Size                =>
+                    PolyORB.Tasking.Threads.Default_Storage_Size,
+                  Buffer_Request            => True,
+                  Max_Buffered_Requests     =>
+                    PolyORB.Types.Unsigned_Long (Natural'Last),
+                  Max_Buffer_Size           => 0);
+            end loop;
+         end;
+      end if;
+
       return ORB_Controller_Access (OC);
    end Create;
 
@@ -400,6 +473,7 @@ begin
        Conflicts => Empty,
        Depends   => +"tasking.condition_variables"
          & "tasking.mutexes"
+         & "tasking.threads"
          & "request_scheduler?",
        Provides  => +"orb_controller!",
        Implicit  => False,
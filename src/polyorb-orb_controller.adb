@@ -30,6 +30,8 @@
 --                                                                          --
 ------------------------------------------------------------------------------
 
+with System.Multiprocessors;
+
 with PolyORB.Constants;
 with PolyORB.ORB;
 with PolyORB.Parameters;
@@ -143,6 +145,23 @@ package body PolyORB.ORB_Controller is
       O.ORB_Lock.Enter;
    end Enter_ORB_Critical_Section;
 
+   -------------------------
+   -- Configured_Reactors --
+   -------------------------
+
+   function Configured_Reactors return Positive is
+      use PolyORB.Parameters;
+
+      Reactors : constant Integer :=
+        Get_Conf ("orb_controller", "polyorb.orb_controller.reactors", 1);
+   begin
+      if Reactors > 0 then
+         return Reactors;
+      else
+         return Positive (System.Multiprocessors.Number_Of_CPUs);
+      end if;
+   end Configured_Reactors;
+
    ------------------
    -- Get_Monitors --
    ------------------
@@ -222,7 +241,10 @@ package body PolyORB.ORB_Controller is
    -- Initialize --
    ----------------
 
-   procedure Initialize (OC : in out ORB_Controller) is
+   procedure Initialize
+     (OC       : in out ORB_Controller;
+      Reactors : Positive := 1)
+   is
       use PolyORB.Parameters;
 
       Polling_Interval : constant Duration
@@ -239,6 +261,11 @@ package body PolyORB.ORB_Controller is
       OC.ORB_Lock := new Reentrant_Mutex;
       PTM.Create (Reentrant_Mutex (OC.ORB_Lock.all).Mutex);
 
+      OC.Reactors := Reactors;
+      OC.AEM_Infos :=
+        new AEM_Infos_Array (1 .. Reactors * Maximum_Number_Of_Monitors);
+      OC.Last_Monitored_AEM := OC.AEM_Infos'Last;
+
       for J in OC.AEM_Infos'Range loop
          PTCV.Create (OC.AEM_Infos (J).Polling_Completed);
       end loop;
@@ -309,6 +336,83 @@ package body PolyORB.ORB_Controller is
       O.ORB_Lock.Leave;
    end Leave_ORB_Critical_Section;
 
+   -------------------------
+   -- Monitors_For_Source --
+   -------------------------
+
+   function Monitors_For_Source
+     (O   : access ORB_Controller;
+      AES : PAE.Asynch_Ev_Source_Access) return Monitor_Array
+   is
+      use type PAE.AEM_Factory;
+      use type PAE.Asynch_Ev_Monitor_Access;
+
+      Current : constant PAE.Asynch_Ev_Monitor_Access := PAE.AEM_Of (AES.all);
+      Factory : PAE.AEM_Factory;
+
+      Candidates : Monitor_Array (1 .. O.AEM_Infos'Length);
+      Last       : Natural := 0;
+      Free_Slot  : Boolean := False;
+
+   begin
+      if O.Reactors = 1 then
+         return Get_Monitors (O);
+      end if;
+
+      --  A source that has already been monitored stays with its monitor
+
+      if Current /= null and then Index (O.all, Current) /= 0 then
+         return Monitor_Array'(1 => Current);
+      end if;
+
+      --  Collect the monitors that handle sources of the same kind
+
+      Factory := PAE.AEM_Factory_Of (AES.all);
+
+      for J in O.AEM_Infos'Range loop
+         if O.AEM_Infos (J).Monitor = null then
+            Free_Slot := True;
+
+         elsif O.AEM_Infos (J).Factory = Factory then
+            Last := Last + 1;
+            Candidates (Last) := O.AEM_Infos (J).Monitor;
+         end if;
+      end loop;
+
+      if Last < O.Reactors and then Free_Slot then
+
+         --  Returning no candidate causes a new monitor to be created
+
+         pragma Debug (C1, O1 ("Monitors_For_Source: new reactor"));
+         return Candidates (1 .. 0);
+
+      elsif Last = 0 then
+
+         --  No slot left for a new kind of source: fall back to trying all
+         --  existing monitors.
+
+         return Get_Monitors (O);
+      end if;
+
+      --  Assign AES to the next monitor in turn. The other monitors for the
+      --  same kind of source come next, in case registration fails.
+
+      declare
+         First  : constant Natural := O.Next_Reactor mod Last;
+         Result : Monitor_Array (1 .. Last);
+      begin
+         O.Next_Reactor := (O.Next_Reactor + 1) mod O.Reactors;
+
+         for J in Result'Range loop
+            Result (J) := Candidates (1 + (First + J - 1) mod Last);
+         end loop;
+
+         pragma Debug (C1, O1 ("Monitors_For_Source: assigned to reactor"
+                               & Natural'Image (First + 1)));
+         return Result;
+      end;
+   end Monitors_For_Source;
+
    -----------------------
    -- Need_Polling_Task --
    -----------------------
@@ -518,6 +622,20 @@ package body PolyORB.ORB_Controller is
       return O.Shutdown;
    end Shutting_Down;
 
+   ------------------------------
+   -- Try_Dispatch_Request_Job --
+   ------------------------------
+
+   function Try_Dispatch_Request_Job
+     (O      : access ORB_Controller;
+      J      : PJ.Job_Access;
+      Target : PR.Ref) return Boolean
+   is
+      pragma Unreferenced (O, J, Target);
+   begin
+      return False;
+   end Try_Dispatch_Request_Job;
+
    ---------------------
    -- Unregister_Task --
    ---------------------
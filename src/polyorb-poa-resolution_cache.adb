@@ -0,0 +1,217 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--         P O L Y O R B . P O A . R E S O L U T I O N _ C A C H E          --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Interfaces;
+
+with PolyORB.Tasking.Mutexes;
+
+package body PolyORB.POA.Resolution_Cache is
+
+   use Interfaces;
+   use PolyORB.Tasking.Mutexes;
+
+   Cache_Size : constant := 256;
+   --  Number of slots
+
+   Max_Name_Length : constant := 128;
+   --  Names longer than this are not cached
+
+   type Sequence_Type is mod 2 ** 32;
+   pragma Atomic (Sequence_Type);
+
+   type Slot_Type is record
+      Sequence : Sequence_Type := 0;
+      --  Odd while the slot is being updated
+
+      Generation : Generation_Type := 0;
+      --  Generation of the cache when the entry was recorded
+
+      Root   : Obj_Adapter_Access;
+      POA    : Obj_Adapter_Access;
+      Length : Natural := 0;
+      Name   : String (1 .. Max_Name_Length);
+   end record;
+   pragma Volatile (Slot_Type);
+
+   type Slot_Index is range 0 .. Cache_Size - 1;
+
+   Slots : array (Slot_Index) of Slot_Type;
+
+   Current : Generation_Type := 0;
+   pragma Atomic (Current);
+   --  Entries recorded under an older generation are ignored
+
+   Lock : Mutex_Access;
+   --  Serializes writers, and protects Stats
+
+   Stats : Cache_Statistics;
+
+   function Slot_Of (Name : String) return Slot_Index;
+   --  Return the slot where Name may be recorded
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize is
+   begin
+      Create (Lock);
+   end Initialize;
+
+   ------------
+   -- Insert --
+   ------------
+
+   procedure Insert
+     (Root       : Obj_Adapter_Access;
+      Name       : String;
+      POA        : Obj_Adapter_Access;
+      Generation : Generation_Type)
+   is
+   begin
+      pragma Abort_Defer;
+
+      if Name'Length > Max_Name_Length then
+         return;
+      end if;
+
+      Enter (Lock);
+
+      --  The cache may have been invalidated while the caller resolved
+      --  Name, in which case POA may be about to be destroyed.
+
+      if Generation = Current then
+         declare
+            S : Slot_Type renames Slots (Slot_Of (Name));
+         begin
+            S.Sequence := S.Sequence + 1;
+            S.Generation := Generation;
+            S.Root := Root;
+            S.POA := POA;
+            S.Length := Name'Length;
+            S.Name (1 .. Name'Length) := Name;
+            S.Sequence := S.Sequence + 1;
+         end;
+         Stats.Fills := Stats.Fills + 1;
+      end if;
+
+      Leave (Lock);
+   end Insert;
+
+   ----------------
+   -- Invalidate --
+   ----------------
+
+   procedure Invalidate is
+   begin
+      pragma Abort_Defer;
+      Enter (Lock);
+      Current := Current + 1;
+      Stats.Invalidations := Stats.Invalidations + 1;
+      Leave (Lock);
+   end Invalidate;
+
+   ------------
+   -- Lookup --
+   ------------
+
+   procedure Lookup
+     (Root       : Obj_Adapter_Access;
+      Name       : String;
+      POA        : out Obj_Adapter_Access;
+      Generation : out Generation_Type)
+   is
+   begin
+      Generation := Current;
+      POA := null;
+
+      if Name'Length > Max_Name_Length then
+         return;
+      end if;
+
+      declare
+         S        : Slot_Type renames Slots (Slot_Of (Name));
+         Sequence : constant Sequence_Type := S.Sequence;
+         Result   : Obj_Adapter_Access;
+      begin
+         if Sequence mod 2 = 1 then
+            return;
+         end if;
+
+         if S.Generation = Generation
+           and then S.Root = Root
+           and then S.Length = Name'Length
+           and then S.Name (1 .. Name'Length) = Name
+         then
+            Result := S.POA;
+         end if;
+
+         --  Discard what was read if a writer updated the slot meanwhile
+
+         if S.Sequence = Sequence then
+            POA := Result;
+         end if;
+      end;
+   end Lookup;
+
+   -------------
+   -- Slot_Of --
+   -------------
+
+   function Slot_Of (Name : String) return Slot_Index is
+      H : Unsigned_32 := 2_166_136_261;
+   begin
+      --  FNV-1a hash of Name
+
+      for J in Name'Range loop
+         H := (H xor Unsigned_32 (Character'Pos (Name (J)))) * 16_777_619;
+      end loop;
+      return Slot_Index (H mod Cache_Size);
+   end Slot_Of;
+
+   ----------------
+   -- Statistics --
+   ----------------
+
+   function Statistics return Cache_Statistics is
+      Result : Cache_Statistics;
+   begin
+      pragma Abort_Defer;
+      Enter (Lock);
+      Result := Stats;
+      Leave (Lock);
+      return Result;
+   end Statistics;
+
+end PolyORB.POA.Resolution_Cache;
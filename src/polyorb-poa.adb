@@ -40,6 +40,7 @@ with Ada.Unchecked_Deallocation;
 with PolyORB.Log;
 with PolyORB.Obj_Adapters;
 with PolyORB.Obj_Adapter_QoS;
+with PolyORB.POA.Resolution_Cache;
 with PolyORB.POA_Config;
 with PolyORB.POA_Manager.Basic_Manager;
 with PolyORB.Smart_Pointers;
@@ -495,9 +496,10 @@ package body PolyORB.POA is
 
       Init_With_Default_Policies (New_Obj_Adapter);
 
-      --  Initialize Global POA Table
+      --  Initialize Global POA Table and POA resolution cache
 
       Initialize (Global_POATable);
+      Resolution_Cache.Initialize;
    end Create_Root_POA;
 
    ---------------------------------------------
@@ -678,6 +680,12 @@ package body PolyORB.POA is
 
       pragma Debug (C, O ("Start destroying POA: " & Self.Name.all));
 
+      --  Make sure no request gets resolved to Self or its children through
+      --  the resolution cache from now on (see below for look ups already
+      --  in progress).
+
+      Resolution_Cache.Invalidate;
+
       --  Remove Self from Global POA Table
 
       pragma Debug (C, O ("Removing POA from Global POA Table"));
@@ -728,6 +736,14 @@ package body PolyORB.POA is
             Self.Name.all);
       end if;
 
+      --  A concurrent Find_POA may have found Self in Global_POATable or
+      --  among the children of its father after the above invalidation, and
+      --  be about to record it in the resolution cache under the current
+      --  generation. Now that Self is unreachable, invalidate again so that
+      --  such entries are discarded before Self is freed.
+
+      Resolution_Cache.Invalidate;
+
       --  Destroy self (also unregister from the POAManager)
 
       pragma Debug (C, O ("About to destroy POA: " & Self.Name.all));
@@ -1116,6 +1132,9 @@ package body PolyORB.POA is
          end if;
       end Find_POA_Recursively;
 
+      Use_Cache  : constant Boolean := Self.Father = null;
+      Generation : Resolution_Cache.Generation_Type;
+
    begin
 
       --  Name is null => return self
@@ -1125,6 +1144,19 @@ package body PolyORB.POA is
          return;
       end if;
 
+      --  Names relative to a root POA (which is how object ids designate
+      --  their POA) are first looked up in the resolution cache.
+
+      if Use_Cache then
+         Resolution_Cache.Lookup
+           (Obj_Adapter_Access (Self), Name, POA, Generation);
+
+         if POA /= null then
+            pragma Debug (C, O ("Found POA " & Name & " in resolution cache"));
+            return;
+         end if;
+      end if;
+
       --  Then look up name in Global POA Table
 
       declare
@@ -1145,20 +1177,26 @@ package body PolyORB.POA is
 
          if POA /= null then
             pragma Debug (C, O ("Found POA in Global_POATable"));
-            return;
          end if;
       end;
 
       --  Then make a recursive look up, activating POA if necessary
 
-      pragma Debug (C, O ("Looking for " & Name & " recursively"));
+      if POA = null then
+         pragma Debug (C, O ("Looking for " & Name & " recursively"));
 
-      Find_POA_Recursively
-        (Self,
-         Name,
-         Activate_It,
-         POA,
-         Error);
+         Find_POA_Recursively
+           (Self,
+            Name,
+            Activate_It,
+            POA,
+            Error);
+      end if;
+
+      if Use_Cache and then POA /= null and then not Found (Error) then
+         Resolution_Cache.Insert
+           (Obj_Adapter_Access (Self), Name, POA, Generation);
+      end if;
 
       pragma Debug (C, O ("Find_POA: leave"));
    end Find_POA;
@@ -205,7 +205,8 @@ package body PolyORB.POA_Policies.Servant_Retention_Policy.Retain is
                return;
             end if;
 
-            The_Entry.Servant := P_Servant;
+            Object_Maps.Set_Servant
+              (POA.Active_Object_Map, The_Entry, P_Servant);
          end if;
       end;
 
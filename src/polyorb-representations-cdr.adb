@@ -36,11 +36,14 @@ with Ada.Streams;
 
 with System.Address_Image;
 
+with PolyORB.Any.Interning;
 with PolyORB.Any.ObjRef;
+with PolyORB.Arenas;
 with PolyORB.Initialization;
 with PolyORB.Log;
 with PolyORB.Parameters;
 with PolyORB.Representations.CDR.Common;
+with PolyORB.Smart_Pointers;
 with PolyORB.Utils.Buffers;
 with PolyORB.Utils.Chained_Lists;
 with PolyORB.Utils.Strings;
@@ -79,6 +82,14 @@ package body PolyORB.Representations.CDR is
    --  data (instead of element per element), if they have a suitable memory
    --  representation.
 
+   Intern_TypeCodes : Boolean;
+   --  If True, non-recursive complex typecodes received at the outermost
+   --  level are interned (see PolyORB.Any.Interning).
+
+   TC_Cache_Size : Natural;
+   --  Maximum number of entries in the typecode cache of a CDR
+   --  representation (0 disables the cache).
+
    function Fast_Path_Element_Size
      (El_TCK : TCKind) return Types.Unsigned_Long;
    --  For a type that is a suitable element type for fast path marshalling
@@ -90,12 +101,14 @@ package body PolyORB.Representations.CDR is
       Buffer              : access Buffer_Type;
       Aggregate_Data      : out System.Address;
       Aggregate_Size      : out Stream_Element_Count;
-      Aggregate_Alignment : out Alignment_Type);
+      Aggregate_Alignment : out Alignment_Type;
+      Swap_Size           : out Stream_Element_Count);
    --  Obtain the data address, data length and CDR alignment to be used
    --  for fast path (un)marshalling of ACC, an aggregate of type TC, from/to
-   --  Buffer.
-   --  Note that Aggregate_Size and Aggregate_Alignment are set only when
-   --  Aggregate_Data is not null.
+   --  Buffer. If Swap_Size is not 0, the endianness of Buffer is not the host
+   --  order, and the data must be byte-swapped by elements of that size.
+   --  Note that Aggregate_Size, Aggregate_Alignment and Swap_Size are set
+   --  only when Aggregate_Data is not null.
 
    ------------------
    -- TypeCode Ids --
@@ -202,6 +215,23 @@ package body PolyORB.Representations.CDR is
    function Image (E : TC_Map_Entry) return String;
    --  Return string representation of E, for debugging purposes
 
+   function Has_Encapsulation (TypeCode_Id : Types.Unsigned_Long)
+     return Boolean;
+   --  True if the parameters of typecodes with the given CDR id are
+   --  marshalled as an encapsulation.
+
+   procedure Unmarshall_TypeCode
+     (Buffer      : access Buffer_Type;
+      R           : access CDR_Representation'Class;
+      TypeCode_Id : Types.Unsigned_Long;
+      Offset      : Types.Long;
+      Encap       : access Encapsulation;
+      Data        : out TypeCode.Local_Ref;
+      Error       : in out Errors.Error_Container);
+   --  Unmarshall a typecode whose CDR id, found at Offset, has already been
+   --  read from Buffer. If Encap is not null, it is the encapsulation of
+   --  the typecode parameters, which has also been read already.
+
    ---------------------------
    -- Create_Representation --
    ---------------------------
@@ -276,9 +306,16 @@ package body PolyORB.Representations.CDR is
 
          when
            Tk_Long   |
-           Tk_Ulong  =>
+           Tk_Ulong  |
+           Tk_Float  =>
             return 4;
 
+         when
+           Tk_Longlong  |
+           Tk_Ulonglong |
+           Tk_Double    =>
+            return 8;
+
          when others =>
             return 0;
       end case;
@@ -294,7 +331,8 @@ package body PolyORB.Representations.CDR is
       Buffer              : access Buffer_Type;
       Aggregate_Data      : out System.Address;
       Aggregate_Size      : out Stream_Element_Count;
-      Aggregate_Alignment : out Alignment_Type)
+      Aggregate_Alignment : out Alignment_Type;
+      Swap_Size           : out Stream_Element_Count)
    is
       TCK : TCKind;
 
@@ -345,12 +383,15 @@ package body PolyORB.Representations.CDR is
 
       if El_Size = 0 then
          return;
+      end if;
 
       --  Case of multi-byte elements, where the expected buffer endianness
       --  is not the host endianness: need to byte swap each element.
 
-      elsif El_Size > 1 and then Endianness (Buffer) /= Host_Order then
-         return;
+      if El_Size > 1 and then Endianness (Buffer) /= Host_Order then
+         Swap_Size := Stream_Element_Count (El_Size);
+      else
+         Swap_Size := 0;
       end if;
 
       Aggregate_Data      := Unchecked_Get_V (ACC);
@@ -361,7 +402,8 @@ package body PolyORB.Representations.CDR is
         & Aggregate_Size'Img & " bytes ("
         & El_Count'Img & " elements) at "
         & System.Address_Image (Aggregate_Data)
-        & ", align on " & Aggregate_Alignment'Img));
+        & ", align on " & Aggregate_Alignment'Img
+        & ", swap size" & Swap_Size'Img));
    end Fast_Path_Get_Info;
 
    -------------
@@ -401,6 +443,25 @@ package body PolyORB.Representations.CDR is
       raise Constraint_Error;
    end Find_TC;
 
+   -----------------------
+   -- Has_Encapsulation --
+   -----------------------
+
+   function Has_Encapsulation (TypeCode_Id : Types.Unsigned_Long)
+     return Boolean
+   is
+   begin
+      case TypeCode_Id is
+         when TC_Object_Id .. TC_Enum_Id
+           | TC_Sequence_Id .. TC_Except_Id
+           | TC_Value_Id .. TC_Event_Id =>
+            return True;
+
+         when others =>
+            return False;
+      end case;
+   end Has_Encapsulation;
+
    -----------
    -- Image --
    -----------
@@ -422,6 +483,10 @@ package body PolyORB.Representations.CDR is
    begin
       Enable_Fast_Path :=
         Get_Conf ("cdr", "enable_fast_path", Default => True);
+      Intern_TypeCodes :=
+        Get_Conf ("cdr", "intern_typecodes", Default => True);
+      TC_Cache_Size :=
+        Get_Conf ("cdr", "typecode_cache_size", Default => 64);
    end Initialize;
 
    --------------
@@ -1090,6 +1155,7 @@ package body PolyORB.Representations.CDR is
                   Aggregate_Data      : System.Address;
                   Aggregate_Size      : Stream_Element_Count;
                   Aggregate_Alignment : Alignment_Type;
+                  Swap_Size           : Stream_Element_Count;
                begin
                   Fast_Path_Get_Info
                     (ACC                 => ACC'Access,
@@ -1097,7 +1163,8 @@ package body PolyORB.Representations.CDR is
                      Buffer              => Buffer,
                      Aggregate_Data      => Aggregate_Data,
                      Aggregate_Size      => Aggregate_Size,
-                     Aggregate_Alignment => Aggregate_Alignment);
+                     Aggregate_Alignment => Aggregate_Alignment,
+                     Swap_Size           => Swap_Size);
 
                   if Aggregate_Data /= System.Null_Address then
 
@@ -1113,13 +1180,25 @@ package body PolyORB.Representations.CDR is
                         Marshall (Buffer, Nb - 1);
                      end if;
 
-                     --  Now insert reference to data
+                     --  Now insert reference to data, or a byte-swapped
+                     --  copy of it if the buffer is not in host order.
 
-                     Pad_Align (Buffer, Aggregate_Alignment);
-                     Insert_Raw_Data
-                       (Buffer,
-                        Size => Aggregate_Size,
-                        Data => Aggregate_Data);
+                     if Swap_Size = 0 then
+                        Pad_Align (Buffer, Aggregate_Alignment);
+                        Insert_Raw_Data
+                          (Buffer,
+                           Size => Aggregate_Size,
+                           Data => Aggregate_Data);
+                     else
+                        declare
+                           Data : Stream_Element_Array (1 .. Aggregate_Size);
+                           for Data'Address use Aggregate_Data;
+                           pragma Import (Ada, Data);
+                        begin
+                           Utils.Buffers.Align_Marshall_Swapped_Copy
+                             (Buffer, Data, Swap_Size);
+                        end;
+                     end if;
                      return;
                   end if;
 
@@ -1340,6 +1419,23 @@ package body PolyORB.Representations.CDR is
       use TC_Maps;
    begin
       Deallocate (Representation.TC_Map);
+
+      if Representation.TC_Cache_Count > 0 then
+         declare
+            use TC_Caches;
+
+            It  : Iterator := First (Representation.TC_Cache);
+            Obj : Smart_Pointers.Entity_Ptr;
+         begin
+            while not Last (It) loop
+               Obj := Smart_Pointers.Entity_Ptr (Value (It));
+               Smart_Pointers.Dec_Usage (Obj);
+               Next (It);
+            end loop;
+         end;
+         TC_Caches.Finalize (Representation.TC_Cache);
+         Representation.TC_Cache_Count := 0;
+      end if;
    end Release;
 
    --------------
@@ -1444,6 +1540,101 @@ package body PolyORB.Representations.CDR is
       R      : access CDR_Representation'Class;
       Data   : out TypeCode.Local_Ref;
       Error  : in out Errors.Error_Container)
+   is
+      TypeCode_Id : constant Types.Unsigned_Long := Unmarshall (Buffer);
+      Offset      : constant Types.Long :=
+        Types.Long (CDR_Position (Buffer)) - (TypeCode_Id'Size / 8);
+      --  Offset is the start position of TypeCode_Id in the buffer. Note that
+      --  we cannot take the position before the call to Unmarshall, because
+      --  we might need to skip some alignment padding first.
+
+   begin
+      --  Nested typecodes, and typecodes without an encapsulation, are
+      --  always unmarshalled.
+
+      if R.Current_Complex /= -1
+        or else not Has_Encapsulation (TypeCode_Id)
+        or else (TC_Cache_Size = 0 and then not Intern_TypeCodes)
+      then
+         Unmarshall_TypeCode
+           (Buffer, R, TypeCode_Id, Offset, null, Data, Error);
+         return;
+      end if;
+
+      --  An outermost complex typecode is entirely determined by its id and
+      --  encapsulation, which are used to look it up in the typecode cache
+      --  of R.
+
+      declare
+         Encap : aliased Encapsulation := Unmarshall (Buffer);
+         Key   : String (1 .. Integer (Encap'Length) + 1);
+         Obj   : TypeCode.Object_Ptr;
+
+      begin
+         Key (1) := Character'Val (TypeCode_Id);
+         for J in Encap'Range loop
+            Key (Integer (J - Encap'First) + 2) :=
+              Character'Val (Encap (J));
+         end loop;
+
+         if R.TC_Cache_Count > 0 then
+            Obj := TC_Caches.Lookup (R.TC_Cache, Key, null);
+            if Obj /= null then
+               pragma Debug (C, O ("Unmarshall (TypeCode): cache hit"));
+               Data := To_Ref (Obj);
+               return;
+            end if;
+         end if;
+
+         --  The typecode may be retained well beyond the current request,
+         --  so it must not be allocated from the request arena.
+
+         declare
+            Scope    : Arenas.Arena_Scope;
+            No_Arena : Arenas.Arena_Ref;
+         begin
+            Arenas.Enter (Scope, No_Arena);
+            R.Indirection_Seen := False;
+            Unmarshall_TypeCode
+              (Buffer, R, TypeCode_Id, Offset, Encap'Access, Data, Error);
+         end;
+
+         if Found (Error) then
+            return;
+         end if;
+
+         --  Recursive typecodes are not interned, as structural comparison
+         --  would not terminate for them.
+
+         if Intern_TypeCodes and then not R.Indirection_Seen then
+            Data := Any.Interning.Intern (Data);
+         end if;
+
+         if R.TC_Cache_Count < TC_Cache_Size then
+            if R.TC_Cache_Count = 0 then
+               TC_Caches.Initialize (R.TC_Cache);
+            end if;
+
+            Obj := Object_Of (Data);
+            Smart_Pointers.Inc_Usage (Smart_Pointers.Entity_Ptr (Obj));
+            TC_Caches.Insert (R.TC_Cache, Key, Obj);
+            R.TC_Cache_Count := R.TC_Cache_Count + 1;
+         end if;
+      end;
+   end Unmarshall;
+
+   -------------------------
+   -- Unmarshall_TypeCode --
+   -------------------------
+
+   procedure Unmarshall_TypeCode
+     (Buffer      : access Buffer_Type;
+      R           : access CDR_Representation'Class;
+      TypeCode_Id : Types.Unsigned_Long;
+      Offset      : Types.Long;
+      Encap       : access Encapsulation;
+      Data        : out TypeCode.Local_Ref;
+      Error       : in out Errors.Error_Container)
    is
       Complex : Boolean := False;
       --  Set true in the case of a complex typecode that may contain nested
@@ -1452,12 +1643,22 @@ package body PolyORB.Representations.CDR is
 
       Complex_Buffer : aliased Buffer_Type;
 
-      TypeCode_Id : constant Types.Unsigned_Long := Unmarshall (Buffer);
-      Offset      : constant Types.Long :=
-        Types.Long (CDR_Position (Buffer)) - (TypeCode_Id'Size / 8);
-      --  Offset is the start position of TypeCode_Id in the buffer. Note that
-      --  we cannot take the position before the call to Unmarshall, because
-      --  we might need to skip some alignment padding first.
+      function Next_Encapsulation return Encapsulation;
+      --  Return Encap if not null, else unmarshall an encapsulation from
+      --  Buffer.
+
+      ------------------------
+      -- Next_Encapsulation --
+      ------------------------
+
+      function Next_Encapsulation return Encapsulation is
+      begin
+         if Encap /= null then
+            return Encap.all;
+         else
+            return Unmarshall (Buffer);
+         end if;
+      end Next_Encapsulation;
 
    begin
       pragma Debug (C, O ("Unmarshall (TypeCode): enter"));
@@ -1509,7 +1710,7 @@ package body PolyORB.Representations.CDR is
             Data := TypeCode.TCF_Object;
 
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name      : Types.String;
             begin
                Decapsulate (Complex_Encap'Access, Complex_Buffer'Access);
@@ -1527,7 +1728,7 @@ package body PolyORB.Representations.CDR is
          when TC_Struct_Id =>
             Data := TypeCode.TCF_Struct;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name      : Types.String;
 
                Nb          : Types.Unsigned_Long;
@@ -1570,7 +1771,7 @@ package body PolyORB.Representations.CDR is
          when TC_Union_Id =>
             Data := TypeCode.TCF_Union;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
 
                Id, Name, Member_Name : PolyORB.Types.String;
                Nb : PolyORB.Types.Unsigned_Long;
@@ -1642,7 +1843,7 @@ package body PolyORB.Representations.CDR is
          when TC_Enum_Id =>
             Data := TypeCode.TCF_Enum;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name, Member_Name : PolyORB.Types.String;
                Nb : PolyORB.Types.Unsigned_Long;
             begin
@@ -1688,7 +1889,7 @@ package body PolyORB.Representations.CDR is
          when TC_Sequence_Id =>
             Data := TypeCode.TCF_Sequence;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Length : PolyORB.Types.Unsigned_Long;
                Content_Type : TypeCode.Local_Ref;
             begin
@@ -1712,7 +1913,7 @@ package body PolyORB.Representations.CDR is
          when TC_Array_Id =>
             Data := TypeCode.TCF_Array;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Length : PolyORB.Types.Unsigned_Long;
                Content_Type : TypeCode.Local_Ref;
             begin
@@ -1735,7 +1936,7 @@ package body PolyORB.Representations.CDR is
          when TC_Alias_Id =>
             Data := TypeCode.TCF_Alias;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name : PolyORB.Types.String;
                Content_Type : TypeCode.Local_Ref;
             begin
@@ -1764,7 +1965,7 @@ package body PolyORB.Representations.CDR is
          when TC_Except_Id =>
             Data := TypeCode.TCF_Except;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name, Member_Name : PolyORB.Types.String;
                Nb : PolyORB.Types.Unsigned_Long;
                Member_Type : TypeCode.Local_Ref;
@@ -1839,7 +2040,7 @@ package body PolyORB.Representations.CDR is
          when TC_Value_Id =>
             Data := TypeCode.TCF_Value;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name, Member_Name : PolyORB.Types.String;
                Type_Modifier, Visibility : PolyORB.Types.Short;
                Nb : PolyORB.Types.Unsigned_Long;
@@ -1898,7 +2099,7 @@ package body PolyORB.Representations.CDR is
          when TC_Valuebox_Id =>
             Data := TypeCode.TCF_Valuebox;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name : PolyORB.Types.String;
                Content_Type : TypeCode.Local_Ref;
             begin
@@ -1928,7 +2129,7 @@ package body PolyORB.Representations.CDR is
          when TC_Native_Id =>
             Data := TypeCode.TCF_Native;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name : PolyORB.Types.String;
             begin
                Decapsulate (Complex_Encap'Access, Complex_Buffer'Access);
@@ -1945,7 +2146,7 @@ package body PolyORB.Representations.CDR is
          when TC_Abstract_Interface_Id =>
             Data := TypeCode.TCF_Abstract_Interface;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name : PolyORB.Types.String;
             begin
                Decapsulate (Complex_Encap'Access, Complex_Buffer'Access);
@@ -1962,7 +2163,7 @@ package body PolyORB.Representations.CDR is
          when TC_Local_Interface_Id =>
             Data := TypeCode.TCF_Local_Interface;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name : PolyORB.Types.String;
             begin
                Decapsulate (Complex_Encap'Access, Complex_Buffer'Access);
@@ -1979,7 +2180,7 @@ package body PolyORB.Representations.CDR is
          when TC_Component_Id =>
             Data := TypeCode.TCF_Component;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name : PolyORB.Types.String;
             begin
                Decapsulate (Complex_Encap'Access, Complex_Buffer'Access);
@@ -1996,7 +2197,7 @@ package body PolyORB.Representations.CDR is
          when TC_Home_Id =>
             Data := TypeCode.TCF_Home;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name      : PolyORB.Types.String;
             begin
                Decapsulate (Complex_Encap'Access, Complex_Buffer'Access);
@@ -2013,7 +2214,7 @@ package body PolyORB.Representations.CDR is
          when TC_Event_Id =>
             Data := TypeCode.TCF_Event;
             declare
-               Complex_Encap : aliased Encapsulation := Unmarshall (Buffer);
+               Complex_Encap : aliased Encapsulation := Next_Encapsulation;
                Id, Name, Member_Name : PolyORB.Types.String;
                Type_Modifier, Visibility : PolyORB.Types.Short;
                Nb : PolyORB.Types.Unsigned_Long;
@@ -2071,6 +2272,8 @@ package body PolyORB.Representations.CDR is
                   raise Constraint_Error;
                end if;
 
+               R.Indirection_Seen := True;
+
                pragma Debug (C, O ("Unmarshall (TypeCode): @" & Current'Img
                  & ": found indirect reference with relative offset "
                  & Offset'Img));
@@ -2092,7 +2295,7 @@ package body PolyORB.Representations.CDR is
       end if;
 
       pragma Debug (C, O ("Unmarshall (TypeCode): end"));
-   end Unmarshall;
+   end Unmarshall_TypeCode;
 
    -----------------------
    -- Unmarshall_To_Any --
@@ -2294,6 +2497,7 @@ package body PolyORB.Representations.CDR is
                   Aggregate_Data      : System.Address;
                   Aggregate_Size      : Stream_Element_Count;
                   Aggregate_Alignment : Alignment_Type;
+                  Swap_Size           : Stream_Element_Count;
                   --  Information used for fast path unmarshalling
 
                begin
@@ -2310,14 +2514,16 @@ package body PolyORB.Representations.CDR is
                      Buffer              => Buffer,
                      Aggregate_Data      => Aggregate_Data,
                      Aggregate_Size      => Aggregate_Size,
-                     Aggregate_Alignment => Aggregate_Alignment);
+                     Aggregate_Alignment => Aggregate_Alignment,
+                     Swap_Size           => Swap_Size);
 
                   if Aggregate_Data /= System.Null_Address then
 
                      --  Here we can do fast path unmarshalling, and we have
                      --  the underlying data address. Note that in the case of
                      --  fast path unmarshalling, data may be fragmented in the
-                     --  buffer, so do reassembly now.
+                     --  buffer, so do reassembly now, then swap elements in
+                     --  place if the buffer is not in host order.
 
                      declare
                         Data : Stream_Element_Array (1 .. Aggregate_Size);
@@ -2328,6 +2534,9 @@ package body PolyORB.Representations.CDR is
                           (Buffer,
                            Aggregate_Alignment,
                            Data);
+                        if Swap_Size /= 0 then
+                           Utils.Buffers.Swap_Elements (Data, Swap_Size);
+                        end if;
                      end;
                      return;
                   end if;
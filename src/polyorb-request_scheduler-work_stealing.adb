@@ -0,0 +1,405 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                 POLYORB.REQUEST_SCHEDULER.WORK_STEALING                  --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Exceptions;
+with Ada.Unchecked_Deallocation;
+with System.Multiprocessors;
+
+with PolyORB.Initialization;
+with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Utils.Chained_Lists;
+with PolyORB.Utils.Strings;
+
+package body PolyORB.Request_Scheduler.Work_Stealing is
+
+   use PolyORB.Jobs;
+   use PolyORB.Log;
+   use PolyORB.Tasking.Condition_Variables;
+   use PolyORB.Tasking.Mutexes;
+   use PolyORB.Tasking.Threads;
+
+   package L is new PolyORB.Log.Facility_Log
+     ("polyorb.request_scheduler.work_stealing");
+   procedure O (Message : String; Level : Log_Level := Debug)
+     renames L.Output;
+   function C (Level : Log_Level := Debug) return Boolean
+     renames L.Enabled;
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Job_Array, Job_Array_Access);
+
+   type Worker_Runnable is new Runnable with record
+      RS    : Request_Scheduler_Work_Stealing_Access;
+      Index : Positive;
+   end record;
+
+   type Worker_Runnable_Access is access all Worker_Runnable;
+
+   overriding procedure Run (R : not null access Worker_Runnable);
+   --  Main loop of worker R.Index
+
+   procedure Push_Bottom (D : in out Job_Deque; J : Job_Access);
+   --  Add J at the bottom of D, growing D if it is full
+
+   procedure Pop_Bottom (D : in out Job_Deque; J : out Job_Access);
+   --  Remove the most recently pushed job from D, null if D is empty
+
+   procedure Steal_Top (D : in out Job_Deque; J : out Job_Access);
+   --  Remove the oldest job from D, null if D is empty
+
+   function Find_Job
+     (RS    : access Request_Scheduler_Work_Stealing;
+      Index : Positive) return Job_Access;
+   --  Return a job from worker Index's own deque, or else stolen from
+   --  another deque (scanning from Index + 1 onwards), or null if all deques
+   --  are empty.
+
+   procedure Signal_Idle_Worker (RS : access Request_Scheduler_Work_Stealing);
+   --  Wake one idle worker, if any, after a job has been pushed
+
+   package Scheduler_Lists is
+     new PolyORB.Utils.Chained_Lists (Request_Scheduler_Work_Stealing_Access);
+
+   All_Schedulers : Scheduler_Lists.List;
+   --  Schedulers created so far, whose workers are stopped on shutdown.
+   --  Schedulers are created during ORB initialization, which is not
+   --  concurrent.
+
+   procedure Shutdown (Wait_For_Completion : Boolean);
+   --  Module shutdown: make the workers of all schedulers exit
+
+   ----------------
+   -- Pop_Bottom --
+   ----------------
+
+   procedure Pop_Bottom (D : in out Job_Deque; J : out Job_Access) is
+   begin
+      Enter (D.Lock);
+      if D.Count = 0 then
+         J := null;
+      else
+         D.Count := D.Count - 1;
+         J := D.Jobs ((D.Top + D.Count) mod D.Jobs'Length);
+         D.Jobs ((D.Top + D.Count) mod D.Jobs'Length) := null;
+      end if;
+      Leave (D.Lock);
+   end Pop_Bottom;
+
+   -----------------
+   -- Push_Bottom --
+   -----------------
+
+   procedure Push_Bottom (D : in out Job_Deque; J : Job_Access) is
+   begin
+      Enter (D.Lock);
+      if D.Count = D.Jobs'Length then
+         declare
+            New_Jobs : constant Job_Array_Access :=
+              new Job_Array (0 .. 2 * D.Jobs'Length - 1);
+         begin
+            for K in 0 .. D.Count - 1 loop
+               New_Jobs (K) := D.Jobs ((D.Top + K) mod D.Jobs'Length);
+            end loop;
+            Free (D.Jobs);
+            D.Jobs := New_Jobs;
+            D.Top  := 0;
+         end;
+      end if;
+
+      D.Jobs ((D.Top + D.Count) mod D.Jobs'Length) := J;
+      D.Count := D.Count + 1;
+      Leave (D.Lock);
+   end Push_Bottom;
+
+   ---------------
+   -- Steal_Top --
+   ---------------
+
+   procedure Steal_Top (D : in out Job_Deque; J : out Job_Access) is
+   begin
+      Enter (D.Lock);
+      if D.Count = 0 then
+         J := null;
+      else
+         J := D.Jobs (D.Top);
+         D.Jobs (D.Top) := null;
+         D.Top   := (D.Top + 1) mod D.Jobs'Length;
+         D.Count := D.Count - 1;
+      end if;
+      Leave (D.Lock);
+   end Steal_Top;
+
+   --------------
+   -- Find_Job --
+   --------------
+
+   function Find_Job
+     (RS    : access Request_Scheduler_Work_Stealing;
+      Index : Positive) return Job_Access
+   is
+      Job    : Job_Access;
+      Victim : Positive;
+   begin
+      Pop_Bottom (RS.Deques (Index), Job);
+      if Job /= null then
+         return Job;
+      end if;
+
+      for K in 1 .. RS.Workers - 1 loop
+         Victim := (Index - 1 + K) mod RS.Workers + 1;
+         Steal_Top (RS.Deques (Victim), Job);
+         if Job /= null then
+            pragma Debug (C, O ("Worker" & Index'Img
+                                & " stole a job from worker" & Victim'Img));
+            return Job;
+         end if;
+      end loop;
+
+      return null;
+   end Find_Job;
+
+   ---------
+   -- Run --
+   ---------
+
+   overriding procedure Run (R : not null access Worker_Runnable) is
+      RS  : Request_Scheduler_Work_Stealing_Access renames R.RS;
+      Job : Job_Access;
+   begin
+      pragma Debug (C, O ("Worker" & R.Index'Img & ": enter"));
+
+      loop
+         Job := Find_Job (RS, R.Index);
+
+         exit when Job = null and then RS.Shutting_Down;
+
+         if Job = null then
+
+            --  Announce that we are about to go idle, then scan all deques
+            --  one last time: a job pushed before Idle_Workers was
+            --  incremented is found here, and a job pushed afterwards comes
+            --  with a signal on Wake_Up, which cannot be lost since we hold
+            --  Sleep_Lock until Wait releases it.
+
+            Enter (RS.Sleep_Lock);
+            RS.Idle_Workers := RS.Idle_Workers + 1;
+            Job := Find_Job (RS, R.Index);
+            if Job = null and then not RS.Shutting_Down then
+               pragma Debug (C, O ("Worker" & R.Index'Img & " going idle"));
+               Wait (RS.Wake_Up, RS.Sleep_Lock);
+            end if;
+            RS.Idle_Workers := RS.Idle_Workers - 1;
+            Leave (RS.Sleep_Lock);
+         end if;
+
+         if Job /= null then
+            begin
+               PolyORB.Jobs.Run (Job);
+            exception
+               when E : others =>
+                  O ("Worker" & R.Index'Img & ": job raised "
+                     & Ada.Exceptions.Exception_Information (E), Error);
+            end;
+         end if;
+      end loop;
+
+      pragma Debug (C, O ("Worker" & R.Index'Img & ": leave"));
+   end Run;
+
+   ------------------------
+   -- Signal_Idle_Worker --
+   ------------------------
+
+   procedure Signal_Idle_Worker
+     (RS : access Request_Scheduler_Work_Stealing)
+   is
+   begin
+      if RS.Idle_Workers > 0 then
+         Enter (RS.Sleep_Lock);
+         Signal (RS.Wake_Up);
+         Leave (RS.Sleep_Lock);
+      end if;
+   end Signal_Idle_Worker;
+
+   --------------
+   -- Shutdown --
+   --------------
+
+   procedure Shutdown (Wait_For_Completion : Boolean) is
+      pragma Unreferenced (Wait_For_Completion);
+
+      use Scheduler_Lists;
+
+      It : Iterator := First (All_Schedulers);
+   begin
+      while not Last (It) loop
+         declare
+            RS : constant Request_Scheduler_Work_Stealing_Access :=
+              Value (It).all;
+         begin
+            --  Set the flag under Sleep_Lock, so that a worker that is
+            --  about to wait sees it or gets the broadcast.
+
+            Enter (RS.Sleep_Lock);
+            RS.Shutting_Down := True;
+            Broadcast (RS.Wake_Up);
+            Leave (RS.Sleep_Lock);
+         end;
+         Next (It);
+      end loop;
+   end Shutdown;
+
+   ---------------------------
+   -- Try_Queue_Request_Job --
+   ---------------------------
+
+   overriding function Try_Queue_Request_Job
+     (Self   : access Request_Scheduler_Work_Stealing;
+      Job    : PolyORB.Jobs.Job_Access;
+      Target : PolyORB.References.Ref) return Boolean
+   is
+      pragma Unreferenced (Target);
+
+      Self_Id : constant Thread_Id := Current_Task;
+      Index   : Natural;
+
+   begin
+      if Self.Shutting_Down then
+         return False;
+      end if;
+
+      for J in Self.Worker_Ids'Range loop
+         if Self.Worker_Ids (J) = Self_Id then
+            pragma Debug (C, O ("Job submitted by worker" & J'Img
+                                & " left to the ORB job queue"));
+            return False;
+         end if;
+      end loop;
+
+      Index := Self.Next_Deque mod Self.Workers + 1;
+      Self.Next_Deque := Index;
+
+      pragma Debug (C, O ("Queue job on worker" & Index'Img));
+
+      Push_Bottom (Self.Deques (Index), Job);
+      Signal_Idle_Worker (Self);
+      return True;
+   end Try_Queue_Request_Job;
+
+   ------------
+   -- Create --
+   ------------
+
+   overriding function Create
+     (RCF : access Request_Scheduler_Work_Stealing_Factory)
+     return Request_Scheduler_Access
+   is
+      pragma Unreferenced (RCF);
+
+      use PolyORB.Parameters;
+
+      Workers : Natural :=
+        Get_Conf ("tasking", "work_stealing_workers", 0);
+      Result  : Request_Scheduler_Work_Stealing_Access;
+
+   begin
+      if Workers = 0 then
+         Workers := Natural (System.Multiprocessors.Number_Of_CPUs);
+      end if;
+
+      pragma Debug (C, O ("Creating scheduler with" & Workers'Img
+                          & " workers"));
+
+      Result := new Request_Scheduler_Work_Stealing (Workers);
+      Create (Result.Sleep_Lock);
+      Create (Result.Wake_Up);
+
+      for J in Result.Deques'Range loop
+         Create (Result.Deques (J).Lock);
+         Result.Deques (J).Jobs :=
+           new Job_Array (0 .. Initial_Deque_Capacity - 1);
+      end loop;
+
+      --  Worker_Ids must be complete before the first request is queued.
+      --  This holds since requests can only arrive once the ORB, which
+      --  owns this scheduler through its controller, has been created.
+
+      for J in 1 .. Workers loop
+         declare
+            New_Runnable : constant Worker_Runnable_Access :=
+              new Worker_Runnable'(RS => Result, Index => J);
+            T : constant Thread_Access :=
+              Run_In_Task
+                (TF   => Get_Thread_Factory,
+                 Name => "Work_Stealing",
+                 R    => Runnable_Access (New_Runnable));
+         begin
+            Result.Worker_Ids (J) := Get_Thread_Id (T);
+         end;
+      end loop;
+
+      Scheduler_Lists.Append (All_Schedulers, Result);
+      return Request_Scheduler_Access (Result);
+   end Create;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize;
+
+   procedure Initialize is
+   begin
+      Register_Request_Scheduler_Factory (RCF);
+   end Initialize;
+
+   use PolyORB.Initialization;
+   use PolyORB.Initialization.String_Lists;
+   use PolyORB.Utils.Strings;
+
+begin
+   Register_Module
+     (Module_Info'
+      (Name      => +"request_scheduler.work_stealing",
+       Conflicts => +"request_scheduler.servant_lane",
+       Depends   => +"tasking.threads"
+         & "tasking.mutexes"
+         & "tasking.condition_variables"
+         & "parameters",
+       Provides  => +"request_scheduler",
+       Implicit  => False,
+       Init      => Initialize'Access,
+       Shutdown  => Shutdown'Access));
+end PolyORB.Request_Scheduler.Work_Stealing;
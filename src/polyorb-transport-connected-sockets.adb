@@ -43,6 +43,7 @@ with PolyORB.Asynch_Ev.Sockets;
 with PolyORB.Initialization;
 with PolyORB.Log;
 with PolyORB.Parameters;
+with PolyORB.Tasking.Threads;
 with PolyORB.Utils.Socket_Access_Points;
 with PolyORB.Utils.Strings;
 
@@ -54,6 +55,7 @@ package body PolyORB.Transport.Connected.Sockets is
    use PolyORB.Asynch_Ev.Sockets;
    use PolyORB.Log;
    use PolyORB.Parameters;
+   use PolyORB.Tasking.Condition_Variables;
    use PolyORB.Tasking.Mutexes;
    use PolyORB.Utils.Socket_Access_Points;
 
@@ -73,6 +75,10 @@ package body PolyORB.Transport.Connected.Sockets is
    --  WAG:6.3
    --  Such a dummy selector should be provided by GNAT.Sockets directly.
 
+   Max_Write_Iovecs : constant := 1024;
+   --  Maximum number of Iovecs gathered in one batch of coalesced writes
+   --  (the usual value of IOV_MAX).
+
    -----------------------
    -- Accept_Connection --
    -----------------------
@@ -145,6 +151,15 @@ package body PolyORB.Transport.Connected.Sockets is
       end if;
 
       Create (TE.Mutex);
+
+      TE.Coalesce_Writes :=
+        Get_Conf ("transport", "tcp.write_coalescing", False);
+      if TE.Coalesce_Writes then
+         TE.Coalescing_Delay :=
+           Get_Conf ("transport", "tcp.write_coalescing_delay", 0.0);
+         Create (TE.Queue_Mutex);
+         Create (TE.Queue_Flushed);
+      end if;
    end Create;
 
    -------------------------
@@ -199,6 +214,7 @@ package body PolyORB.Transport.Connected.Sockets is
       use PolyORB.Errors;
 
       Data_Received : Stream_Element_Count;
+      Count         : Stream_Element_Count;
 
       procedure Receive_Socket (V : access Iovec);
       --  Lowlevel socket receive
@@ -225,6 +241,20 @@ package body PolyORB.Transport.Connected.Sockets is
    begin
       begin
          Receive_Buffer (Buffer, Size, Data_Received);
+
+         --  For a large read (typically a big GIOP message body), keep
+         --  receiving into the same region as long as the socket has data
+         --  immediately available, rather than going back to the ORB for
+         --  another monitoring round for each segment.
+
+         while Size >= PolyORB.Buffers.Large_Receive_Size
+           and then Data_Received < Size
+           and then Is_Data_Available (TE, 1)
+         loop
+            Receive_Buffer (Buffer, Size - Data_Received, Count);
+            exit when Count = 0;
+            Data_Received := Data_Received + Count;
+         end loop;
       exception
          when E : PolyORB.Sockets.Socket_Error =>
             O ("receive failed: " & Ada.Exceptions.Exception_Message (E),
@@ -286,6 +316,133 @@ package body PolyORB.Transport.Connected.Sockets is
       end Socket_Send;
 
       procedure Send_Buffer is new Buffers.Send_Buffer (Socket_Send);
+      procedure Send_Buffers is new Buffers.Send_Buffers (Socket_Send);
+
+      procedure Coalesced_Write;
+      --  Queue Buffer for sending. If another task is already flushing the
+      --  queue, wait until it has sent Buffer. Else, become the flusher, and
+      --  send queued messages in batches of at most Max_Write_Iovecs Iovecs
+      --  until the queue is empty.
+
+      ---------------------
+      -- Coalesced_Write --
+      ---------------------
+
+      procedure Coalesced_Write is
+         This : aliased Pending_Write;
+
+         First, Last, Next : Pending_Write_Access;
+         Count   : Positive;
+         Iovecs  : Natural;
+         Failure : Error_Id;
+      begin
+         This.Buffer := Buffer;
+
+         Enter (TE.Queue_Mutex);
+         if TE.Last_Pending = null then
+            TE.First_Pending := This'Unchecked_Access;
+         else
+            TE.Last_Pending.Next := This'Unchecked_Access;
+         end if;
+         TE.Last_Pending := This'Unchecked_Access;
+
+         if TE.Flushing then
+            pragma Debug (C, O ("Write: queued behind current flusher"));
+            while not This.Done loop
+               Wait (TE.Queue_Flushed, TE.Queue_Mutex);
+            end loop;
+            Leave (TE.Queue_Mutex);
+            Error := This.Error;
+            return;
+         end if;
+
+         TE.Flushing := True;
+
+         if TE.Coalescing_Delay > 0.0 then
+
+            --  Give concurrent writers a chance to join the first batch
+
+            Leave (TE.Queue_Mutex);
+            PolyORB.Tasking.Threads.Relative_Delay (TE.Coalescing_Delay);
+            Enter (TE.Queue_Mutex);
+         end if;
+
+         while TE.First_Pending /= null loop
+
+            --  Detach the longest prefix of the queue that fits in one
+            --  gathered write. The first message is always taken, even if
+            --  it exceeds Max_Write_Iovecs on its own.
+
+            First  := TE.First_Pending;
+            Last   := First;
+            Count  := 1;
+            Iovecs := Iovec_Count (First.Buffer);
+            while Last.Next /= null
+              and then Iovecs + Iovec_Count (Last.Next.Buffer)
+                         <= Max_Write_Iovecs
+            loop
+               Last   := Last.Next;
+               Count  := Count + 1;
+               Iovecs := Iovecs + Iovec_Count (Last.Buffer);
+            end loop;
+
+            TE.First_Pending := Last.Next;
+            if TE.First_Pending = null then
+               TE.Last_Pending := null;
+            end if;
+            Leave (TE.Queue_Mutex);
+
+            pragma Debug (C, O ("Write: flushing" & Count'Img
+                             & " message(s)," & Iovecs'Img & " iovec(s)"));
+
+            declare
+               Batch : Buffer_Array (1 .. Count);
+            begin
+               Next := First;
+               for J in Batch'Range loop
+                  Batch (J) := Next.Buffer;
+                  Next := Next.Next;
+               end loop;
+
+               Failure := No_Error;
+               Enter (TE.Mutex);
+               begin
+                  Send_Buffers (Batch);
+               exception
+                  when E : PolyORB.Sockets.Socket_Error =>
+                     O ("send failed: "
+                        & Ada.Exceptions.Exception_Message (E), Notice);
+                     Failure := Comm_Failure_E;
+
+                  when others =>
+                     Failure := Unknown_E;
+               end;
+               Leave (TE.Mutex);
+            end;
+
+            --  Complete all writes of the batch. Each writer owns its
+            --  Pending_Write, which may go away as soon as it is marked
+            --  Done and the queue mutex is released.
+
+            Enter (TE.Queue_Mutex);
+            Next := First;
+            for J in 1 .. Count loop
+               First := Next;
+               Next  := First.Next;
+               if Failure /= No_Error then
+                  Throw
+                    (First.Error, Failure, System_Exception_Members'
+                      (Minor => 0, Completed => Completed_Maybe));
+               end if;
+               First.Done := True;
+            end loop;
+            Broadcast (TE.Queue_Flushed);
+         end loop;
+
+         TE.Flushing := False;
+         Leave (TE.Queue_Mutex);
+         Error := This.Error;
+      end Coalesced_Write;
 
    --  Start of processing for Write
 
@@ -294,6 +451,12 @@ package body PolyORB.Transport.Connected.Sockets is
 
       pragma Debug (C, O ("Write: enter"));
 
+      if TE.Coalesce_Writes then
+         Coalesced_Write;
+         pragma Debug (C, O ("Write: leave"));
+         return;
+      end if;
+
       --  Send_Buffer is not atomic, needs to be protected.
 
       Enter (TE.Mutex);
@@ -410,6 +573,10 @@ package body PolyORB.Transport.Connected.Sockets is
    overriding procedure Destroy (TE : in out Socket_Endpoint) is
    begin
       Destroy (TE.Mutex);
+      if TE.Coalesce_Writes then
+         Destroy (TE.Queue_Mutex);
+         Destroy (TE.Queue_Flushed);
+      end if;
       Connected.Destroy (Connected_Transport_Endpoint (TE));
    end Destroy;
 
@@ -35,12 +35,18 @@ pragma Ada_2012;
 --  Datagram Socket Access Point and End Point to receive data from network
 
 with Ada.Exceptions;
+with Ada.Unchecked_Deallocation;
+with Interfaces.C;
+
+with GNAT.OS_Lib;
 
 with System.Storage_Elements;
 
 with PolyORB.Asynch_Ev;
 with PolyORB.Asynch_Ev.Sockets;
 with PolyORB.Log;
+with PolyORB.Parameters;
+with PolyORB.Tasking.Threads;
 with PolyORB.Utils.Socket_Access_Points;
 
 package body PolyORB.Transport.Datagram.Sockets is
@@ -50,6 +56,8 @@ package body PolyORB.Transport.Datagram.Sockets is
    use PolyORB.Asynch_Ev;
    use PolyORB.Asynch_Ev.Sockets;
    use PolyORB.Log;
+   use PolyORB.Tasking.Condition_Variables;
+   use PolyORB.Tasking.Mutexes;
    use PolyORB.Utils.Socket_Access_Points;
 
    package L is new PolyORB.Log.Facility_Log
@@ -59,6 +67,148 @@ package body PolyORB.Transport.Datagram.Sockets is
    function C (Level : Log_Level := Debug) return Boolean
      renames L.Enabled;
 
+   ---------------------
+   -- Burst reception --
+   ---------------------
+
+   --  When the socket of an endpoint is found readable, all the datagrams
+   --  that are queued on it (up to a configurable limit) are received by a
+   --  single system call into the slots of a buffer owned by the endpoint.
+   --  The first one is delivered at once, and the following ones by the
+   --  next calls to Read, without going through the event monitor.
+
+   Max_Burst_Size : constant := 64;
+   --  Maximum number of datagrams received at once. This must not exceed
+   --  the corresponding limit in __PolyORB_recv_burst.
+
+   type Int_Array is array (Positive range <>) of Interfaces.C.int;
+   pragma Convention (C, Int_Array);
+
+   subtype Inet_Bytes is Stream_Element_Array (1 .. 4);
+   type Inet_Bytes_Array is array (Positive range <>) of Inet_Bytes;
+   pragma Convention (C, Inet_Bytes_Array);
+
+   type Burst_Buffer (Slots : Natural; Size : Stream_Element_Count) is
+   record
+      Data : Stream_Element_Array (1 .. Size);
+      --  Storage for Slots datagrams of Size / Slots bytes each
+
+      Lengths : Int_Array (1 .. Slots);
+      Addrs   : Inet_Bytes_Array (1 .. Slots);
+      Ports   : Int_Array (1 .. Slots);
+      --  Length and sender of each datagram, see __PolyORB_recv_burst
+
+      Count : Natural := 0;
+      --  Number of datagrams received by the last burst
+
+      Next : Positive := 1;
+      --  Index of the next datagram to be delivered
+   end record;
+   --  A burst buffer with no slots denotes an endpoint for which burst
+   --  reception is disabled.
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Burst_Buffer, Burst_Buffer_Access);
+
+   function C_Recv_Burst
+     (FD        : Interfaces.C.int;
+      Buf       : System.Address;
+      Slot_Size : Interfaces.C.int;
+      Count     : Interfaces.C.int;
+      Lengths   : System.Address;
+      Addrs     : System.Address;
+      Ports     : System.Address) return Interfaces.C.int;
+   pragma Import (C, C_Recv_Burst, "__PolyORB_recv_burst");
+
+   function Image (Addr : Inet_Bytes) return String;
+   --  Return the dotted image of the IPv4 address Addr
+
+   procedure Receive_Burst
+     (TE    : in out Socket_Endpoint;
+      Error : in out Errors.Error_Container);
+   --  Receive into TE.Burst the datagrams that are pending on the socket of
+   --  TE, allocating TE.Burst on first call. Burst reception is disabled if
+   --  the system does not support it.
+
+   procedure Skip_Truncated (B : in out Burst_Buffer);
+   --  Advance B.Next past the datagrams that did not fit in their slot
+
+   --------------------
+   -- Burst emission --
+   --------------------
+
+   --  On an endpoint with send coalescing, the datagrams written
+   --  concurrently by several tasks are queued, and the task that finds
+   --  the queue idle sends those that have the same destination with a
+   --  single system call, as is done for write coalescing on connected
+   --  sockets.
+
+   Max_Write_Iovecs : constant := 1024;
+   --  Maximum number of Iovecs gathered in one batch of coalesced writes
+   --  (the usual value of IOV_MAX).
+
+   function C_Send_Burst
+     (FD         : Interfaces.C.int;
+      Iovecs     : System.Address;
+      Iov_Counts : System.Address;
+      Count      : Interfaces.C.int;
+      Host       : Interfaces.C.char_array;
+      Port       : Interfaces.C.int) return Interfaces.C.long_long;
+   pragma Import (C, C_Send_Burst, "__PolyORB_send_burst");
+
+   procedure Initialize_Coalescing (TE : in out Socket_Endpoint);
+   --  Set up send coalescing on TE if enabled in the configuration
+
+   procedure Send_Datagram
+     (TE     : Socket_Endpoint;
+      Buffer : Buffers.Buffer_Access;
+      Target : Sock_Addr_Type);
+   --  Send the contents of Buffer to Target as one datagram
+
+   procedure Send_Batch
+     (TE     : in out Socket_Endpoint;
+      Batch  : Buffers.Buffer_Array;
+      Target : Sock_Addr_Type);
+   --  Send the contents of each element of Batch to Target as one datagram,
+   --  by a single system call where supported. Socket_Error is raised if
+   --  sending fails.
+
+   -----------
+   -- Image --
+   -----------
+
+   function Image (Addr : Inet_Bytes) return String is
+      function Img (B : Stream_Element) return String;
+      --  Image of B without leading space
+
+      function Img (B : Stream_Element) return String is
+         S : constant String := Stream_Element'Image (B);
+      begin
+         return S (S'First + 1 .. S'Last);
+      end Img;
+
+   begin
+      return Img (Addr (1)) & "." & Img (Addr (2)) & "."
+        & Img (Addr (3)) & "." & Img (Addr (4));
+   end Image;
+
+   ---------------------------
+   -- Initialize_Coalescing --
+   ---------------------------
+
+   procedure Initialize_Coalescing (TE : in out Socket_Endpoint) is
+      use PolyORB.Parameters;
+   begin
+      TE.Coalesce_Writes :=
+        Get_Conf ("transport", "datagram.send_coalescing", False);
+      if TE.Coalesce_Writes then
+         TE.Coalescing_Delay :=
+           Get_Conf ("transport", "datagram.send_coalescing_delay", 0.0);
+         Create (TE.Queue_Mutex);
+         Create (TE.Queue_Flushed);
+      end if;
+   end Initialize_Coalescing;
+
    -----------------
    -- Init_Socket --
    -----------------
@@ -131,6 +281,7 @@ package body PolyORB.Transport.Datagram.Sockets is
    begin
       TE.Socket := S;
       TE.Remote_Address := Addr;
+      Initialize_Coalescing (TE);
    end Create;
 
    -------------------------
@@ -166,6 +317,29 @@ package body PolyORB.Transport.Datagram.Sockets is
       procedure Lowlevel_Receive_Datagram (V : access Iovec);
       --  Receive datagram from TE into V
 
+      procedure Lowlevel_Copy_Buffered (V : access Iovec);
+      --  Copy the next datagram of TE.Burst into V
+
+      ----------------------------
+      -- Lowlevel_Copy_Buffered --
+      ----------------------------
+
+      procedure Lowlevel_Copy_Buffered (V : access Iovec) is
+         B     : Burst_Buffer renames TE.Burst.all;
+         First : constant Stream_Element_Offset :=
+           Stream_Element_Offset (B.Next - 1) * (B.Size / B.Slots) + 1;
+         Count : constant Stream_Element_Count :=
+           Stream_Element_Count'Min
+             (Stream_Element_Count (B.Lengths (B.Next)),
+              Stream_Element_Count (V.Iov_Len));
+         Item  : Stream_Element_Array (1 .. Count);
+         for Item'Address use V.Iov_Base;
+         pragma Import (Ada, Item);
+      begin
+         Item := B.Data (First .. First + Count - 1);
+         V.Iov_Len := System.Storage_Elements.Storage_Offset (Count);
+      end Lowlevel_Copy_Buffered;
+
       -------------------------------
       -- Lowlevel_Receive_Datagram --
       -------------------------------
@@ -184,9 +358,46 @@ package body PolyORB.Transport.Datagram.Sockets is
       procedure Receive_Datagram is
         new Buffers.Receive_Buffer (Lowlevel_Receive_Datagram);
 
+      procedure Copy_Buffered is
+        new Buffers.Receive_Buffer (Lowlevel_Copy_Buffered);
+
    --  Start of processing for Read
 
    begin
+      --  Unless datagrams are left over from the previous burst, receive
+      --  all those that are pending on the socket by a single system call.
+
+      if not Has_Buffered_Data (TE) then
+         Receive_Burst (TE, Error);
+         if Is_Error (Error) then
+            Size := 0;
+            return;
+         end if;
+      end if;
+
+      if Has_Buffered_Data (TE) then
+         declare
+            B : Burst_Buffer renames TE.Burst.all;
+         begin
+            if B.Ports (B.Next) >= 0 then
+               TE.Remote_Address :=
+                 (Family => Family_Inet,
+                  Addr   => Inet_Addr (Image (B.Addrs (B.Next))),
+                  Port   => Port_Type (B.Ports (B.Next)));
+            end if;
+
+            Size := Stream_Element_Count (B.Lengths (B.Next));
+            Copy_Buffered (Buffer, Size, Data_Received);
+            B.Next := B.Next + 1;
+            Skip_Truncated (B);
+            Size := Data_Received;
+            return;
+         end;
+      end if;
+
+      --  Burst reception is disabled, or found nothing: receive one
+      --  datagram.
+
       begin
          Control_Socket (TE.Socket, Request);
          Size := Stream_Element_Offset (Request.Size);
@@ -207,6 +418,192 @@ package body PolyORB.Transport.Datagram.Sockets is
       Size := Data_Received;
    end Read;
 
+   -------------------
+   -- Receive_Burst --
+   -------------------
+
+   procedure Receive_Burst
+     (TE    : in out Socket_Endpoint;
+      Error : in out Errors.Error_Container)
+   is
+      use PolyORB.Errors;
+      use type Interfaces.C.int;
+
+      N : Interfaces.C.int;
+
+   begin
+      if TE.Burst = null then
+         declare
+            use PolyORB.Parameters;
+
+            Slots : constant Integer := Integer'Min
+              (Get_Conf ("transport", "datagram.burst_size", 16),
+               Max_Burst_Size);
+            Slot_Size : constant Integer :=
+              Get_Conf ("transport", "datagram.burst_slot_size", 65_536);
+         begin
+            --  A burst of one datagram is no better than a plain receive
+
+            if Slots <= 1 or else Slot_Size <= 0 then
+               TE.Burst := new Burst_Buffer (Slots => 0, Size => 0);
+            else
+               TE.Burst := new Burst_Buffer
+                 (Slots => Slots,
+                  Size  => Stream_Element_Count (Slots * Slot_Size));
+            end if;
+         end;
+      end if;
+
+      TE.Burst.Count := 0;
+      TE.Burst.Next  := 1;
+      if TE.Burst.Slots = 0 then
+         return;
+      end if;
+
+      N := C_Recv_Burst
+        (FD        => Interfaces.C.int (To_C (TE.Socket)),
+         Buf       => TE.Burst.Data'Address,
+         Slot_Size => Interfaces.C.int (TE.Burst.Size / TE.Burst.Slots),
+         Count     => Interfaces.C.int (TE.Burst.Slots),
+         Lengths   => TE.Burst.Lengths'Address,
+         Addrs     => TE.Burst.Addrs'Address,
+         Ports     => TE.Burst.Ports'Address);
+
+      if N = -2 then
+         --  The system call is not supported: revert to receiving one
+         --  datagram at a time.
+
+         O ("burst reception disabled", Notice);
+         Free (TE.Burst);
+         TE.Burst := new Burst_Buffer (Slots => 0, Size => 0);
+
+      elsif N < 0 then
+         O ("receive failed: errno" & Integer'Image (GNAT.OS_Lib.Errno),
+            Notice);
+         Throw (Error, Comm_Failure_E,
+                System_Exception_Members'
+                  (Minor => 0, Completed => Completed_Maybe));
+
+      else
+         pragma Debug (C, O ("Received a burst of" & N'Img & " datagram(s)"));
+         TE.Burst.Count := Natural (N);
+         Skip_Truncated (TE.Burst.all);
+      end if;
+   end Receive_Burst;
+
+   ----------------
+   -- Send_Batch --
+   ----------------
+
+   procedure Send_Batch
+     (TE     : in out Socket_Endpoint;
+      Batch  : Buffers.Buffer_Array;
+      Target : Sock_Addr_Type)
+   is
+      use PolyORB.Buffers;
+
+      Burst_Unsupported : exception;
+
+      Counts : Int_Array (Batch'Range);
+      --  Number of Iovecs of each datagram
+
+      procedure Lowlevel_Send_Burst
+        (V     : access Iovec;
+         N     : Integer;
+         Count : out System.Storage_Elements.Storage_Offset);
+      --  Send all datagrams of Batch, whose Iovecs are gathered starting
+      --  at V.
+
+      -------------------------
+      -- Lowlevel_Send_Burst --
+      -------------------------
+
+      procedure Lowlevel_Send_Burst
+        (V     : access Iovec;
+         N     : Integer;
+         Count : out System.Storage_Elements.Storage_Offset)
+      is
+         pragma Unreferenced (N);
+         use type Interfaces.C.long_long;
+
+         Sent : constant Interfaces.C.long_long :=
+           C_Send_Burst
+             (FD         => Interfaces.C.int (To_C (TE.Socket)),
+              Iovecs     => V.all'Address,
+              Iov_Counts => Counts'Address,
+              Count      => Interfaces.C.int (Counts'Length),
+              Host       => Interfaces.C.To_C (Image (Target.Addr)),
+              Port       => Interfaces.C.int (Target.Port));
+      begin
+         if Sent = -2 then
+            raise Burst_Unsupported;
+         elsif Sent < 0 then
+            raise Socket_Error with "sending a burst of datagrams failed";
+         end if;
+
+         --  Either all datagrams have been sent, or an error was reported
+
+         Count := System.Storage_Elements.Storage_Offset (Sent);
+      end Lowlevel_Send_Burst;
+
+      procedure Send_Burst is new Buffers.Send_Buffers (Lowlevel_Send_Burst);
+
+   --  Start of processing for Send_Batch
+
+   begin
+      if Batch'Length > 1
+        and then TE.Send_Burst_Supported
+        and then Target.Family = Family_Inet
+      then
+         for J in Batch'Range loop
+            Counts (J) := Interfaces.C.int (Iovec_Count (Batch (J)));
+         end loop;
+
+         begin
+            Send_Burst (Batch);
+            return;
+         exception
+            when Burst_Unsupported =>
+               O ("burst emission disabled", Notice);
+               TE.Send_Burst_Supported := False;
+         end;
+      end if;
+
+      for J in Batch'Range loop
+         Send_Datagram (TE, Batch (J), Target);
+      end loop;
+   end Send_Batch;
+
+   -------------------
+   -- Send_Datagram --
+   -------------------
+
+   procedure Send_Datagram
+     (TE     : Socket_Endpoint;
+      Buffer : Buffers.Buffer_Access;
+      Target : Sock_Addr_Type)
+   is
+      Data : constant Stream_Element_Array :=
+        Buffers.To_Stream_Element_Array (Buffer.all);
+      Last : Stream_Element_Offset;
+   begin
+      pragma Debug (C, O ("Send to : " & Image (Target)));
+      pragma Debug (C, O ("Buffer Size : " & Data'Length'Img));
+      PolyORB.Sockets.Send_Socket (TE.Socket, Data, Last, Target);
+   end Send_Datagram;
+
+   --------------------
+   -- Skip_Truncated --
+   --------------------
+
+   procedure Skip_Truncated (B : in out Burst_Buffer) is
+   begin
+      while B.Next <= B.Count and then B.Lengths (B.Next) < 0 loop
+         O ("discarding datagram larger than burst slot", Notice);
+         B.Next := B.Next + 1;
+      end loop;
+   end Skip_Truncated;
+
    -----------
    -- Write --
    -----------
@@ -219,17 +616,146 @@ package body PolyORB.Transport.Datagram.Sockets is
       use PolyORB.Buffers;
       use PolyORB.Errors;
 
-      Data : constant Stream_Element_Array :=
-        To_Stream_Element_Array (Buffer.all);
-      Last : Stream_Element_Offset;
+      procedure Coalesced_Write;
+      --  Queue Buffer for sending. If another task is already flushing the
+      --  queue, wait until it has sent Buffer. Else, become the flusher, and
+      --  send queued datagrams in batches of at most Max_Write_Iovecs Iovecs
+      --  with the same destination until the queue is empty.
+
+      ---------------------
+      -- Coalesced_Write --
+      ---------------------
+
+      procedure Coalesced_Write is
+         This : aliased Pending_Write;
+
+         First, Last, Next : Pending_Write_Access;
+         Count   : Positive;
+         Iovecs  : Natural;
+         Failure : Error_Id;
+      begin
+         This.Buffer := Buffer;
+         This.Target := TE.Remote_Address;
+
+         Enter (TE.Queue_Mutex);
+         if TE.Last_Pending = null then
+            TE.First_Pending := This'Unchecked_Access;
+         else
+            TE.Last_Pending.Next := This'Unchecked_Access;
+         end if;
+         TE.Last_Pending := This'Unchecked_Access;
+
+         if TE.Flushing then
+            pragma Debug (C, O ("Write: queued behind current flusher"));
+            while not This.Done loop
+               Wait (TE.Queue_Flushed, TE.Queue_Mutex);
+            end loop;
+            Leave (TE.Queue_Mutex);
+            Error := This.Error;
+            return;
+         end if;
+
+         TE.Flushing := True;
+
+         if TE.Coalescing_Delay > 0.0 then
+
+            --  Give concurrent writers a chance to join the first batch
+
+            Leave (TE.Queue_Mutex);
+            PolyORB.Tasking.Threads.Relative_Delay (TE.Coalescing_Delay);
+            Enter (TE.Queue_Mutex);
+         end if;
+
+         while TE.First_Pending /= null loop
+
+            --  Detach the longest prefix of the queue whose datagrams have
+            --  the same destination and fit in one batch. The first datagram
+            --  is always taken, even if it exceeds Max_Write_Iovecs on its
+            --  own.
+
+            First  := TE.First_Pending;
+            Last   := First;
+            Count  := 1;
+            Iovecs := Iovec_Count (First.Buffer);
+            while Last.Next /= null
+              and then Last.Next.Target = First.Target
+              and then Iovecs + Iovec_Count (Last.Next.Buffer)
+                         <= Max_Write_Iovecs
+            loop
+               Last   := Last.Next;
+               Count  := Count + 1;
+               Iovecs := Iovecs + Iovec_Count (Last.Buffer);
+            end loop;
+
+            TE.First_Pending := Last.Next;
+            if TE.First_Pending = null then
+               TE.Last_Pending := null;
+            end if;
+            Leave (TE.Queue_Mutex);
+
+            pragma Debug (C, O ("Write: flushing" & Count'Img
+                             & " datagram(s) to " & Image (First.Target)));
+
+            declare
+               Batch : Buffer_Array (1 .. Count);
+            begin
+               Next := First;
+               for J in Batch'Range loop
+                  Batch (J) := Next.Buffer;
+                  Next := Next.Next;
+               end loop;
+
+               Failure := No_Error;
+               begin
+                  Send_Batch (TE, Batch, First.Target);
+               exception
+                  when E : Socket_Error =>
+                     O ("send failed: "
+                        & Ada.Exceptions.Exception_Message (E), Notice);
+                     Failure := Comm_Failure_E;
+
+                  when others =>
+                     Failure := Unknown_E;
+               end;
+            end;
+
+            --  Complete all writes of the batch. Each writer owns its
+            --  Pending_Write, which may go away as soon as it is marked
+            --  Done and the queue mutex is released.
+
+            Enter (TE.Queue_Mutex);
+            Next := First;
+            for J in 1 .. Count loop
+               First := Next;
+               Next  := First.Next;
+               if Failure /= No_Error then
+                  Throw
+                    (First.Error, Failure, System_Exception_Members'
+                      (Minor => 0, Completed => Completed_Maybe));
+               end if;
+               First.Done := True;
+            end loop;
+            Broadcast (TE.Queue_Flushed);
+         end loop;
+
+         TE.Flushing := False;
+         Leave (TE.Queue_Mutex);
+         Error := This.Error;
+      end Coalesced_Write;
+
+   --  Start of processing for Write
 
    begin
       pragma Debug (C, O ("Write: enter"));
-      pragma Debug (C, O ("Send to : " & Image (TE.Remote_Address)));
-      pragma Debug (C, O ("Buffer Size : " & Data'Length'Img));
+
+      if TE.Coalesce_Writes then
+         Coalesced_Write;
+         pragma Debug (C, O ("Write: leave"));
+         return;
+      end if;
+
       begin
-         PolyORB.Sockets.Send_Socket
-           (TE.Socket, Data, Last, TE.Remote_Address);
+         Send_Datagram (TE, Buffer, TE.Remote_Address);
       exception
          when E : Socket_Error =>
             O ("send failed: " & Ada.Exceptions.Exception_Information (E),
@@ -260,8 +786,22 @@ package body PolyORB.Transport.Datagram.Sockets is
       PolyORB.Transport.Datagram.Close
         (Datagram_Transport_Endpoint (TE.all)'Access);
       TE.Socket := No_Socket;
+      Free (TE.Burst);
    end Close;
 
+   -------------
+   -- Destroy --
+   -------------
+
+   overriding procedure Destroy (TE : in out Socket_Endpoint) is
+   begin
+      if TE.Coalesce_Writes then
+         Destroy (TE.Queue_Mutex);
+         Destroy (TE.Queue_Flushed);
+      end if;
+      PolyORB.Transport.Datagram.Destroy (Datagram_Transport_Endpoint (TE));
+   end Destroy;
+
    ---------------------
    -- Create_Endpoint --
    ---------------------
@@ -276,9 +816,30 @@ package body PolyORB.Transport.Datagram.Sockets is
    begin
       pragma Debug (C, O ("Create Endpoint for UDP socket"));
       Socket_Endpoint (TE.all).Socket := TAP.Socket;
+      Initialize_Coalescing (Socket_Endpoint (TE.all));
       return TE;
    end Create_Endpoint;
 
+   -----------------------
+   -- Has_Buffered_Data --
+   -----------------------
+
+   overriding function Has_Buffered_Data
+     (TE : Socket_Endpoint) return Boolean
+   is
+   begin
+      return TE.Burst /= null and then TE.Burst.Next <= TE.Burst.Count;
+   end Has_Buffered_Data;
+
+   ----------------
+   -- Peer_Image --
+   ----------------
+
+   overriding function Peer_Image (TE : Socket_Endpoint) return String is
+   begin
+      return Image (TE.Remote_Address);
+   end Peer_Image;
+
    --------------------------------
    -- Set_Socket_AP_Publish_Name --
    --------------------------------
@@ -37,6 +37,7 @@ with PolyORB.Log;
 with PolyORB.Filters;
 with PolyORB.Filters.Iface;
 with PolyORB.ORB.Iface;
+with PolyORB.Types;
 
 package body PolyORB.Transport.Datagram is
 
@@ -128,6 +129,43 @@ package body PolyORB.Transport.Datagram is
             TE.Max    := DE.Max;
          end;
 
+         if Has_Buffered_Data (Datagram_Transport_Endpoint'Class (TE.all))
+         then
+            --  The upper layers expect more data from within the delivery
+            --  of the previous datagram: let the loop below deliver the
+            --  next one once they return, rather than nesting calls for
+            --  each buffered datagram.
+
+            if TE.Delivering then
+               TE.Expected := True;
+               return Nothing;
+            end if;
+
+            TE.Delivering := True;
+            begin
+               loop
+                  TE.Expected := False;
+                  pragma Debug (C, O ("Deliver buffered datagram"));
+
+                  declare
+                     Reply : constant Components.Message'Class :=
+                       Handle_Message
+                         (TE, Data_Indication'(Data_Amount => 0));
+                  begin
+                     if not TE.Expected or else Reply not in Null_Message
+                     then
+                        TE.Delivering := False;
+                        return Reply;
+                     end if;
+                  end;
+               end loop;
+            exception
+               when others =>
+                  TE.Delivering := False;
+                  raise;
+            end;
+         end if;
+
          return Emit
            (TE.Server, ORB.Iface.Monitor_Endpoint'
               (TE => Transport_Endpoint_Access (TE)));
@@ -188,6 +226,12 @@ package body PolyORB.Transport.Datagram is
       elsif Msg in Disconnect_Request then
          Close (Transport_Endpoint'Class (TE.all)'Access);
 
+      elsif Msg in Get_Peer_Name then
+         return Peer_Name'
+           (Name => Types.To_PolyORB_String
+                      (Peer_Image (Datagram_Transport_Endpoint'Class
+                                     (TE.all))));
+
       else
          return Transport.Handle_Message
                  (Transport_Endpoint (TE.all)'Access, Msg);
@@ -196,4 +240,26 @@ package body PolyORB.Transport.Datagram is
       return Nothing;
    end Handle_Message;
 
+   -----------------------
+   -- Has_Buffered_Data --
+   -----------------------
+
+   function Has_Buffered_Data
+     (TE : Datagram_Transport_Endpoint) return Boolean
+   is
+      pragma Unreferenced (TE);
+   begin
+      return False;
+   end Has_Buffered_Data;
+
+   ----------------
+   -- Peer_Image --
+   ----------------
+
+   function Peer_Image (TE : Datagram_Transport_Endpoint) return String is
+      pragma Unreferenced (TE);
+   begin
+      return "";
+   end Peer_Image;
+
 end PolyORB.Transport.Datagram;
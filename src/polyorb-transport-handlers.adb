@@ -112,8 +112,8 @@ package body PolyORB.Transport.Handlers is
    is
    begin
       pragma Assert (H.Dependent_Binding_Object.Is_Nil);
-      Smart_Pointers.Reuse_Entity
-        (H.Dependent_Binding_Object, H.TE.Binding_Object);
+      PolyORB.ORB.Reuse_Binding_Object
+        (H.ORB, H.Dependent_Binding_Object, H.TE.Binding_Object);
 
       return not H.Dependent_Binding_Object.Is_Nil;
    end Stabilize;
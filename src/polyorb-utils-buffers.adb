@@ -30,6 +30,7 @@
 --                                                                          --
 ------------------------------------------------------------------------------
 
+with Interfaces.C;
 with System;
 
 with GNAT.Byte_Swapping;
@@ -38,6 +39,15 @@ with PolyORB.Opaque; use PolyORB.Opaque;
 
 package body PolyORB.Utils.Buffers is
 
+   procedure C_Bswap_Array
+     (Target : System.Address;
+      Source : System.Address;
+      Length : Interfaces.C.size_t;
+      Size   : Interfaces.C.int);
+   pragma Import (C, C_Bswap_Array, "__PolyORB_bswap_array");
+   --  Copy Length bytes from Source to Target, reversing the byte order of
+   --  each element of Size bytes. Target may be equal to Source.
+
    -------------------------------
    -- Align_Transfer_Elementary --
    -------------------------------
@@ -179,6 +189,30 @@ package body PolyORB.Utils.Buffers is
       end;
    end Align_Marshall_Copy;
 
+   ---------------------------------
+   -- Align_Marshall_Swapped_Copy --
+   ---------------------------------
+
+   procedure Align_Marshall_Swapped_Copy
+     (Buffer       : access Buffer_Type;
+      Octets       : Stream_Element_Array;
+      Element_Size : Stream_Element_Count)
+   is
+      Data_Address : Opaque_Pointer;
+   begin
+      Pad_Align (Buffer, Alignment_Of (Short_Short_Integer (Element_Size)));
+      Allocate_And_Insert_Cooked_Data
+        (Buffer,
+         Octets'Length,
+         Data_Address);
+
+      C_Bswap_Array
+        (Target => Data_Address,
+         Source => Octets'Address,
+         Length => Interfaces.C.size_t (Octets'Length),
+         Size   => Interfaces.C.int (Element_Size));
+   end Align_Marshall_Swapped_Copy;
+
    ---------------------------
    -- Align_Unmarshall_Copy --
    ---------------------------
@@ -213,4 +247,21 @@ package body PolyORB.Utils.Buffers is
       end loop;
    end Align_Unmarshall_Copy;
 
+   -------------------
+   -- Swap_Elements --
+   -------------------
+
+   procedure Swap_Elements
+     (Data         : in out Stream_Element_Array;
+      Element_Size : Stream_Element_Count)
+   is
+   begin
+      pragma Assert (Data'Length mod Element_Size = 0);
+      C_Bswap_Array
+        (Target => Data'Address,
+         Source => Data'Address,
+         Length => Interfaces.C.size_t (Data'Length),
+         Size   => Interfaces.C.int (Element_Size));
+   end Swap_Elements;
+
 end PolyORB.Utils.Buffers;
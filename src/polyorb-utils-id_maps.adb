@@ -0,0 +1,265 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                P O L Y O R B . U T I L S . I D _ M A P S                 --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+pragma Ada_2012;
+
+with Ada.Unchecked_Deallocation;
+with Interfaces;
+
+package body PolyORB.Utils.Id_Maps is
+
+   use Interfaces;
+
+   Initial_Bits : constant := 4;
+   --  Log2 of the number of slots allocated on first insertion
+
+   Golden_Ratio : constant Unsigned_64 := 16#9E37_79B9_7F4A_7C15#;
+   --  Multiplier for Fibonacci hashing
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Slot_Array, Slot_Array_Access);
+
+   function Home (M : Map; Id : Id_Type) return Natural;
+   pragma Inline (Home);
+   --  Return the first slot probed for Id in M
+
+   function Find (M : Map; Id : Id_Type) return Integer;
+   --  Return the index of the slot holding Id in M, or -1 if none
+
+   procedure Resize (M : in out Map; Bits : Natural);
+   --  Reallocate M with 2 ** Bits slots, and insert back all associations
+
+   -----------
+   -- Clear --
+   -----------
+
+   procedure Clear (M : in out Map) is
+   begin
+      if M.Slots /= null then
+         for J in M.Slots'Range loop
+            M.Slots (J).Used := False;
+            M.Slots (J).E := No_Element;
+         end loop;
+      end if;
+      M.Length := 0;
+   end Clear;
+
+   ----------------
+   -- Deallocate --
+   ----------------
+
+   procedure Deallocate (M : in out Map) is
+   begin
+      Free (M.Slots);
+      M.Bits := 0;
+      M.Length := 0;
+   end Deallocate;
+
+   ----------
+   -- Find --
+   ----------
+
+   function Find (M : Map; Id : Id_Type) return Integer is
+      J : Natural;
+   begin
+      if M.Slots = null then
+         return -1;
+      end if;
+
+      J := Home (M, Id);
+      while M.Slots (J).Used loop
+         if M.Slots (J).Id = Id then
+            return J;
+         end if;
+         J := (J + 1) mod M.Slots'Length;
+      end loop;
+      return -1;
+   end Find;
+
+   ----------
+   -- Home --
+   ----------
+
+   function Home (M : Map; Id : Id_Type) return Natural is
+   begin
+      return Natural
+        (Shift_Right (Unsigned_64 (Id) * Golden_Ratio, 64 - M.Bits));
+   end Home;
+
+   ------------
+   -- Insert --
+   ------------
+
+   procedure Insert
+     (M       : in out Map;
+      Id      : Id_Type;
+      E       : Element;
+      Success : out Boolean)
+   is
+      J : Natural;
+   begin
+      if M.Slots = null then
+         Resize (M, Initial_Bits);
+      elsif 2 * (M.Length + 1) > M.Slots'Length then
+         Resize (M, M.Bits + 1);
+      end if;
+
+      J := Home (M, Id);
+      while M.Slots (J).Used loop
+         if M.Slots (J).Id = Id then
+            Success := False;
+            return;
+         end if;
+         J := (J + 1) mod M.Slots'Length;
+      end loop;
+
+      M.Slots (J) := (Used => True, Id => Id, E => E);
+      M.Length := M.Length + 1;
+      Success := True;
+   end Insert;
+
+   -------------
+   -- Iterate --
+   -------------
+
+   procedure Iterate (M : Map) is
+   begin
+      if M.Slots /= null then
+         for J in M.Slots'Range loop
+            if M.Slots (J).Used then
+               Process (M.Slots (J).Id, M.Slots (J).E);
+            end if;
+         end loop;
+      end if;
+   end Iterate;
+
+   ------------
+   -- Length --
+   ------------
+
+   function Length (M : Map) return Natural is
+   begin
+      return M.Length;
+   end Length;
+
+   ------------
+   -- Lookup --
+   ------------
+
+   function Lookup (M : Map; Id : Id_Type) return Element is
+      J : constant Integer := Find (M, Id);
+   begin
+      if J < 0 then
+         return No_Element;
+      end if;
+      return M.Slots (J).E;
+   end Lookup;
+
+   ------------
+   -- Remove --
+   ------------
+
+   procedure Remove (M : in out Map; Id : Id_Type; E : out Element) is
+      Hole : Integer := Find (M, Id);
+      J, H : Natural;
+      Size : Natural;
+   begin
+      if Hole < 0 then
+         E := No_Element;
+         return;
+      end if;
+
+      E := M.Slots (Hole).E;
+      M.Length := M.Length - 1;
+      Size := M.Slots'Length;
+
+      --  Backward shift deletion: move back the following entries of the
+      --  probe sequence, so that no lookup ever needs to go past an unused
+      --  slot (and no tombstones are needed). The entry at J may fill the
+      --  hole unless its home slot H lies cyclically in (Hole, J].
+
+      J := Hole;
+      loop
+         J := (J + 1) mod Size;
+         exit when not M.Slots (J).Used;
+
+         H := Home (M, M.Slots (J).Id);
+         if (J + Size - H) mod Size >= (J + Size - Hole) mod Size then
+            M.Slots (Hole) := M.Slots (J);
+            Hole := J;
+         end if;
+      end loop;
+
+      M.Slots (Hole).Used := False;
+      M.Slots (Hole).E := No_Element;
+   end Remove;
+
+   -------------
+   -- Replace --
+   -------------
+
+   procedure Replace (M : in out Map; Id : Id_Type; E : Element) is
+      J       : constant Integer := Find (M, Id);
+      Success : Boolean;
+   begin
+      if J >= 0 then
+         M.Slots (J).E := E;
+      else
+         Insert (M, Id, E, Success);
+         pragma Assert (Success);
+      end if;
+   end Replace;
+
+   ------------
+   -- Resize --
+   ------------
+
+   procedure Resize (M : in out Map; Bits : Natural) is
+      Old     : Slot_Array_Access := M.Slots;
+      Success : Boolean;
+   begin
+      M.Slots  := new Slot_Array (0 .. 2 ** Bits - 1);
+      M.Bits   := Bits;
+      M.Length := 0;
+
+      if Old /= null then
+         for J in Old'Range loop
+            if Old (J).Used then
+               Insert (M, Old (J).Id, Old (J).E, Success);
+               pragma Assert (Success);
+            end if;
+         end loop;
+         Free (Old);
+      end if;
+   end Resize;
+
+end PolyORB.Utils.Id_Maps;
@@ -50,5 +50,13 @@ with PolyORB.References.File;
 pragma Warnings (Off, PolyORB.References.File);
 pragma Elaborate_All (PolyORB.References.File);
 
+with PolyORB.Asynch_Ev.Sockets.Epoll;
+pragma Warnings (Off, PolyORB.Asynch_Ev.Sockets.Epoll);
+pragma Elaborate_All (PolyORB.Asynch_Ev.Sockets.Epoll);
+
+with PolyORB.Buffers.Slab_Allocator;
+pragma Warnings (Off, PolyORB.Buffers.Slab_Allocator);
+pragma Elaborate_All (PolyORB.Buffers.Slab_Allocator);
+
 package body PolyORB.Setup.Common_Base is
 end PolyORB.Setup.Common_Base;
@@ -31,6 +31,8 @@
 ------------------------------------------------------------------------------
 
 with Ada.Exceptions;
+with Ada.Real_Time;
+with Ada.Unchecked_Deallocation;
 with Interfaces.C.Strings;
 
 with PolyORB.Initialization;
@@ -38,11 +40,15 @@ with PolyORB.Platform.SSL_Linker_Options;
 pragma Warnings (Off, PolyORB.Platform.SSL_Linker_Options);
 --  No entity referenced
 
+with PolyORB.Tasking.Mutexes;
+with PolyORB.Utils.HFunctions.Hyper;
+with PolyORB.Utils.HTables.Perfect;
 with PolyORB.Utils.Strings;
 
 package body PolyORB.SSL is
 
    use type Interfaces.C.int;
+   use type Interfaces.Unsigned_64;
 
    package Thin is
 
@@ -72,6 +78,16 @@ package body PolyORB.SSL is
       type Stack_Of_SSL_Cipher is private;
       No_Stack_Of_SSL_Cipher : constant Stack_Of_SSL_Cipher;
 
+      type SSL_Session is private;
+      No_SSL_Session : constant SSL_Session;
+
+      type SSL_New_Session_Callback is
+        access function
+        (SSL     : SSL_Socket_Type;
+         Session : SSL_Session)
+         return Interfaces.C.int;
+      pragma Convention (C, SSL_New_Session_Callback);
+
       --  General initialization subprograms
 
       procedure SSL_library_init;
@@ -180,6 +196,40 @@ package body PolyORB.SSL is
         (SSL    : SSL_Socket_Type)
          return Stack_Of_SSL_Cipher;
 
+      --  Session subprograms
+
+      procedure SSL_CTX_set_session_cache
+        (Ctx     : SSL_Context_Type;
+         Server  : Interfaces.C.int;
+         Size    : Interfaces.C.long;
+         Timeout : Interfaces.C.long;
+         Tickets : Interfaces.C.int;
+         New_CB  : SSL_New_Session_Callback);
+
+      function SSL_set_session
+        (SSL     : SSL_Socket_Type;
+         Session : SSL_Session)
+         return Interfaces.C.int;
+
+      function SSL_session_reused
+        (SSL : SSL_Socket_Type)
+         return Interfaces.C.int;
+
+      procedure SSL_SESSION_free (Session : SSL_Session);
+
+      function SSL_get_ex_new_index return Interfaces.C.int;
+
+      function SSL_set_ex_data
+        (SSL   : SSL_Socket_Type;
+         Index : Interfaces.C.int;
+         Data  : Interfaces.C.Strings.chars_ptr)
+         return Interfaces.C.int;
+
+      function SSL_get_ex_data
+        (SSL   : SSL_Socket_Type;
+         Index : Interfaces.C.int)
+         return Interfaces.C.Strings.chars_ptr;
+
       --  Error handling subprograms
 
       function ERR_get_error return SSL_Error_Code;
@@ -231,6 +281,12 @@ package body PolyORB.SSL is
       type Stack_Of_SSL_Cipher is access all Stack_Of_SSL_Cipher_Record;
       No_Stack_Of_SSL_Cipher : constant Stack_Of_SSL_Cipher := null;
 
+      type SSL_Session_Record is null record;
+      pragma Convention (C, SSL_Session_Record);
+
+      type SSL_Session is access all SSL_Session_Record;
+      No_SSL_Session : constant SSL_Session := null;
+
       pragma Import (C, ERR_get_error, "ERR_get_error");
       pragma Import (C, SSL_CTX_check_private_key,
                        "SSL_CTX_check_private_key");
@@ -239,6 +295,8 @@ package body PolyORB.SSL is
       pragma Import (C, SSL_CTX_load_verify_locations,
                        "SSL_CTX_load_verify_locations");
       pragma Import (C, SSL_CTX_new, "SSL_CTX_new");
+      pragma Import (C, SSL_CTX_set_session_cache,
+                       "__PolyORB_SSL_CTX_set_session_cache");
       pragma Import (C, SSL_CTX_set_client_CA_list,
                        "SSL_CTX_set_client_CA_list");
       pragma Import (C, SSL_CTX_set_default_verify_paths,
@@ -252,15 +310,22 @@ package body PolyORB.SSL is
       pragma Import (C, SSL_accept, "SSL_accept");
       pragma Import (C, SSL_connect, "SSL_connect");
       pragma Import (C, SSL_free, "SSL_free");
-      pragma Import (C, SSL_get_fd, "SSL_get_fd");
       pragma Import (C, SSL_get_ciphers, "SSL_get_ciphers");
+      pragma Import (C, SSL_get_ex_data, "SSL_get_ex_data");
+      pragma Import (C, SSL_get_ex_new_index,
+                       "__PolyORB_SSL_get_ex_new_index");
+      pragma Import (C, SSL_get_fd, "SSL_get_fd");
       pragma Import (C, SSL_library_init, "SSL_library_init");
       pragma Import (C, SSL_load_error_strings, "SSL_load_error_strings");
       pragma Import (C, SSL_load_client_CA_file, "SSL_load_client_CA_file");
       pragma Import (C, SSL_new, "SSL_new");
       pragma Import (C, SSL_pending, "SSL_pending");
       pragma Import (C, SSL_read, "SSL_read");
+      pragma Import (C, SSL_SESSION_free, "SSL_SESSION_free");
+      pragma Import (C, SSL_session_reused, "__PolyORB_SSL_session_reused");
+      pragma Import (C, SSL_set_ex_data, "SSL_set_ex_data");
       pragma Import (C, SSL_set_fd, "SSL_set_fd");
+      pragma Import (C, SSL_set_session, "SSL_set_session");
       pragma Import (C, SSL_shutdown, "SSL_shutdown");
       pragma Import (C, SSL_write, "SSL_write");
 
@@ -287,6 +352,72 @@ package body PolyORB.SSL is
    procedure Initialize;
    --  Initialize must be called before using any other SSL socket routines
 
+   --------------------------
+   -- Client session cache --
+   --------------------------
+
+   --  The sessions established by Connect_Socket are recorded, through the
+   --  new session callback of the client context, under the image of the
+   --  remote address, which is attached to each client SSL socket as
+   --  application data. The least recently established sessions are
+   --  evicted when the cache is full.
+
+   type Session_Entry;
+   type Session_Entry_Access is access Session_Entry;
+
+   type Session_Entry is record
+      Key     : Utils.Strings.String_Ptr;
+      Session : Thin.SSL_Session;
+      Expiry  : Ada.Real_Time.Time;
+
+      Older, Newer : Session_Entry_Access;
+      --  Neighbours in the list of cached sessions, by establishment time
+   end record;
+
+   procedure Free is
+     new Ada.Unchecked_Deallocation (Session_Entry, Session_Entry_Access);
+
+   package Session_HTables is new PolyORB.Utils.HTables.Perfect
+     (Session_Entry_Access,
+      PolyORB.Utils.HFunctions.Hyper.Hash_Hyper_Parameters,
+      PolyORB.Utils.HFunctions.Hyper.Default_Hash_Parameters,
+      PolyORB.Utils.HFunctions.Hyper.Hash,
+      PolyORB.Utils.HFunctions.Hyper.Next_Hash_Parameters);
+
+   Session_Lock : PolyORB.Tasking.Mutexes.Mutex_Access;
+   --  Protects all the variables below
+
+   Sessions        : Session_HTables.Table_Instance;
+   Oldest, Newest  : Session_Entry_Access;
+   Session_Count   : Natural := 0;
+   Client_Size     : Natural := 0;
+   Client_Lifetime : Ada.Real_Time.Time_Span := Ada.Real_Time.Time_Span_Zero;
+   Stats           : Session_Statistics;
+
+   Key_Index : Interfaces.C.int := -1;
+   --  Index of the application data of SSL sockets holding the cache key
+
+   function New_Session
+     (SSL     : SSL_Socket_Type;
+      Session : Thin.SSL_Session) return Interfaces.C.int;
+   pragma Convention (C, New_Session);
+   --  New session callback of client contexts: record Session in the cache
+   --  under the key attached to SSL.
+
+   procedure Offer_Session (Socket : SSL_Socket_Type; Key : String);
+   --  Attach Key to Socket and have the cached session for Key, if any, be
+   --  resumed by the handshake of Socket.
+
+   procedure Release_Session_Key (Socket : SSL_Socket_Type);
+   --  Detach and deallocate the key attached to Socket, if any
+
+   procedure Record_Handshake (Socket : SSL_Socket_Type; Server : Boolean);
+   --  Update the statistics after the handshake of Socket has completed
+
+   procedure Remove_Session (E : in out Session_Entry_Access);
+   --  Remove E from the cache and deallocate it. Must be called with
+   --  Session_Lock held.
+
    function To_SSL_Verify_Mode
      (Value : SSL_Verification_Mode) return Thin.SSL_Verify_Mode;
    --  Convert user friendly SSL_Verification_Mode structure into SSL internal
@@ -328,6 +459,8 @@ package body PolyORB.SSL is
          Ada.Exceptions.Raise_Exception
            (SSL_Error'Identity, Get_Errors_String);
       end if;
+
+      Record_Handshake (Socket, Server => True);
    end Accept_Socket;
 
    ----------------
@@ -392,6 +525,7 @@ package body PolyORB.SSL is
       end loop;
 
       Sockets.Close_Socket (Socket_Of (Socket));
+      Release_Session_Key (Socket);
       Thin.SSL_free (Socket);
    end Close_Socket;
 
@@ -420,11 +554,18 @@ package body PolyORB.SSL is
            (SSL_Error'Identity, Get_Errors_String);
       end if;
 
+      if Client_Size > 0 then
+         Offer_Session (Socket, Utils.Sockets.Image (Address));
+      end if;
+
       if Thin.SSL_connect (Socket) /= 1 then
+         Release_Session_Key (Socket);
          Thin.SSL_free (Socket);
          Ada.Exceptions.Raise_Exception
            (SSL_Error'Identity, Get_Errors_String);
       end if;
+
+      Record_Handshake (Socket, Server => False);
    end Connect_Socket;
 
    --------------------
@@ -613,6 +754,10 @@ package body PolyORB.SSL is
       Thin.SSL_load_error_strings;
       Thin.SSL_library_init;
       --  XXX actions_to_seed_PRNG
+
+      PolyORB.Tasking.Mutexes.Create (Session_Lock);
+      Session_HTables.Initialize (Sessions);
+      Key_Index := Thin.SSL_get_ex_new_index;
    end Initialize;
 
    --------------------
@@ -637,6 +782,137 @@ package body PolyORB.SSL is
       Thin.SSL_CTX_set_client_CA_list (Context, List);
    end Load_Client_CA;
 
+   -----------------
+   -- New_Session --
+   -----------------
+
+   function New_Session
+     (SSL     : SSL_Socket_Type;
+      Session : Thin.SSL_Session) return Interfaces.C.int
+   is
+      use Ada.Real_Time;
+      use Interfaces.C.Strings;
+      use PolyORB.Tasking.Mutexes;
+
+      function Expiry_Time return Time;
+      --  Return the expiry time of a session cached now, Time_Last if the
+      --  lifetime of client sessions is too large to be added to Clock.
+
+      -----------------
+      -- Expiry_Time --
+      -----------------
+
+      function Expiry_Time return Time is
+      begin
+         return Clock + Client_Lifetime;
+      exception
+         when Constraint_Error =>
+            return Time_Last;
+      end Expiry_Time;
+
+      Key_Ptr  : constant chars_ptr := Thin.SSL_get_ex_data (SSL, Key_Index);
+      E        : Session_Entry_Access;
+      Locked   : Boolean := False;
+      Inserted : Boolean := False;
+
+   --  Start of processing for New_Session
+
+   begin
+      if Key_Ptr = Null_Ptr then
+         return 0;
+      end if;
+
+      declare
+         Key : constant String := Value (Key_Ptr);
+      begin
+         Enter (Session_Lock);
+         Locked := True;
+
+         --  Replace the session previously cached for Key, if any
+
+         E := Session_HTables.Lookup (Sessions, Key, null);
+         if E /= null then
+            Remove_Session (E);
+         end if;
+
+         E := new Session_Entry'
+           (Key     => new String'(Key),
+            Session => Session,
+            Expiry  => Expiry_Time,
+            Older   => Newest,
+            Newer   => null);
+         Session_HTables.Insert (Sessions, Key, E);
+         if Newest = null then
+            Oldest := E;
+         else
+            Newest.Newer := E;
+         end if;
+         Newest := E;
+         Session_Count := Session_Count + 1;
+
+         --  From now on, the cache owns the reference to Session, even if
+         --  it is evicted right away.
+
+         Inserted := True;
+
+         while Session_Count > Client_Size loop
+            E := Oldest;
+            Remove_Session (E);
+         end loop;
+
+         Leave (Session_Lock);
+         Locked := False;
+      end;
+
+      return 1;
+
+   exception
+      when others =>
+         if Locked then
+            Leave (Session_Lock);
+         end if;
+
+         if Inserted then
+            return 1;
+         else
+            return 0;
+         end if;
+   end New_Session;
+
+   -------------------
+   -- Offer_Session --
+   -------------------
+
+   procedure Offer_Session (Socket : SSL_Socket_Type; Key : String) is
+      use Ada.Real_Time;
+      use Interfaces.C.Strings;
+      use PolyORB.Tasking.Mutexes;
+
+      Key_Ptr : chars_ptr := New_String (Key);
+      E       : Session_Entry_Access;
+
+   begin
+      if Thin.SSL_set_ex_data (Socket, Key_Index, Key_Ptr) /= 1 then
+         Free (Key_Ptr);
+         return;
+      end if;
+
+      Enter (Session_Lock);
+      E := Session_HTables.Lookup (Sessions, Key, null);
+      if E /= null then
+         if E.Expiry < Clock then
+            Remove_Session (E);
+
+         --  Socket holds its own reference to the session, so that E may
+         --  be removed from the cache during the handshake.
+
+         elsif Thin.SSL_set_session (Socket, E.Session) /= 1 then
+            Remove_Session (E);
+         end if;
+      end if;
+      Leave (Session_Lock);
+   end Offer_Session;
+
    --------------------
    -- Pending_Length --
    --------------------
@@ -681,6 +957,72 @@ package body PolyORB.SSL is
       end loop;
    end Receive_Vector;
 
+   ----------------------
+   -- Record_Handshake --
+   ----------------------
+
+   procedure Record_Handshake (Socket : SSL_Socket_Type; Server : Boolean) is
+      use PolyORB.Tasking.Mutexes;
+
+      Resumed : constant Boolean := Thin.SSL_session_reused (Socket) = 1;
+
+   begin
+      Enter (Session_Lock);
+      if Server and then Resumed then
+         Stats.Server_Resumed := Stats.Server_Resumed + 1;
+      elsif Server then
+         Stats.Server_Full := Stats.Server_Full + 1;
+      elsif Resumed then
+         Stats.Client_Resumed := Stats.Client_Resumed + 1;
+      else
+         Stats.Client_Full := Stats.Client_Full + 1;
+      end if;
+      Leave (Session_Lock);
+   end Record_Handshake;
+
+   -------------------------
+   -- Release_Session_Key --
+   -------------------------
+
+   procedure Release_Session_Key (Socket : SSL_Socket_Type) is
+      use Interfaces.C.Strings;
+
+      Key_Ptr : chars_ptr := Thin.SSL_get_ex_data (Socket, Key_Index);
+
+   begin
+      if Key_Ptr /= Null_Ptr then
+         if Thin.SSL_set_ex_data (Socket, Key_Index, Null_Ptr) = 1 then
+            Free (Key_Ptr);
+         end if;
+      end if;
+   end Release_Session_Key;
+
+   --------------------
+   -- Remove_Session --
+   --------------------
+
+   procedure Remove_Session (E : in out Session_Entry_Access) is
+   begin
+      if E.Older = null then
+         Oldest := E.Newer;
+      else
+         E.Older.Newer := E.Newer;
+      end if;
+
+      if E.Newer = null then
+         Newest := E.Older;
+      else
+         E.Newer.Older := E.Older;
+      end if;
+
+      Session_HTables.Delete (Sessions, E.Key.all);
+      Session_Count := Session_Count - 1;
+
+      Thin.SSL_SESSION_free (E.Session);
+      Utils.Strings.Free (E.Key);
+      Free (E);
+   end Remove_Session;
+
    -----------------
    -- Send_Vector --
    -----------------
@@ -718,6 +1060,50 @@ package body PolyORB.SSL is
       end loop;
    end Send_Vector;
 
+   ------------------------------
+   -- Session_Cache_Statistics --
+   ------------------------------
+
+   function Session_Cache_Statistics return Session_Statistics is
+      use PolyORB.Tasking.Mutexes;
+
+      Result : Session_Statistics;
+
+   begin
+      Enter (Session_Lock);
+      Result := Stats;
+      Leave (Session_Lock);
+      return Result;
+   end Session_Cache_Statistics;
+
+   -----------------------
+   -- Set_Session_Cache --
+   -----------------------
+
+   procedure Set_Session_Cache
+     (Context    : SSL_Context_Type;
+      Parameters : Session_Cache_Parameters;
+      Server     : Boolean)
+   is
+      use PolyORB.Tasking.Mutexes;
+
+   begin
+      Thin.SSL_CTX_set_session_cache
+        (Context,
+         Server  => Boolean'Pos (Server),
+         Size    => Interfaces.C.long (Parameters.Size),
+         Timeout => Interfaces.C.long (Parameters.Lifetime),
+         Tickets => Boolean'Pos (Parameters.Tickets),
+         New_CB  => New_Session'Access);
+
+      if not Server then
+         Enter (Session_Lock);
+         Client_Size     := Parameters.Size;
+         Client_Lifetime := Ada.Real_Time.To_Time_Span (Parameters.Lifetime);
+         Leave (Session_Lock);
+      end if;
+   end Set_Session_Cache;
+
    ---------------
    -- Socket_Of --
    ---------------
@@ -866,7 +1252,7 @@ begin
         (Module_Info'
          (Name      => +"ssl",
           Conflicts => Empty,
-          Depends   => +"sockets",
+          Depends   => +"sockets" & "tasking.mutexes",
           Provides  => Empty,
           Implicit  => False,
           Init      => Initialize'Access,
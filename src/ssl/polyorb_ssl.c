@@ -84,3 +84,57 @@ const SSL_METHOD __attribute__((weak)) *TLSv1_2_client_method(void) {
 const SSL_METHOD __attribute__((weak)) *TLSv1_2_server_method(void) {
   return NULL;
 }
+
+/* Session resumption */
+
+/*
+ * Configure session resumption on CTX. On a server context, enable the
+ * internal session cache with room for SIZE sessions (0 disables it), and
+ * accept session tickets if TICKETS is nonzero. On a client context, have
+ * NEW_CB called for each session established (including those received
+ * in tickets after the handshake) if SIZE is nonzero, the sessions being
+ * cached by the caller, and request tickets if TICKETS is nonzero. In
+ * both cases sessions expire after TIMEOUT seconds.
+ */
+
+void
+__PolyORB_SSL_CTX_set_session_cache (SSL_CTX *ctx, int server, long size,
+                                     long timeout, int tickets,
+                                     int (*new_cb) (SSL *, SSL_SESSION *)) {
+  static const unsigned char id_context[] = "PolyORB";
+
+  if (server) {
+    /* A session id context is required to resume sessions when client
+       certificates are verified. */
+
+    SSL_CTX_set_session_id_context
+      (ctx, id_context, sizeof (id_context) - 1);
+    SSL_CTX_sess_set_cache_size (ctx, size);
+    SSL_CTX_set_session_cache_mode
+      (ctx, size > 0 ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_OFF);
+
+  } else if (size > 0) {
+    SSL_CTX_set_session_cache_mode
+      (ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb (ctx, new_cb);
+
+  } else {
+    SSL_CTX_set_session_cache_mode (ctx, SSL_SESS_CACHE_OFF);
+  }
+
+  if (timeout > 0)
+    SSL_CTX_set_timeout (ctx, timeout);
+
+  if (tickets)
+    SSL_CTX_clear_options (ctx, SSL_OP_NO_TICKET);
+  else
+    SSL_CTX_set_options (ctx, SSL_OP_NO_TICKET);
+}
+
+int __PolyORB_SSL_session_reused (SSL *ssl) {
+  return SSL_session_reused (ssl);
+}
+
+int __PolyORB_SSL_get_ex_new_index (void) {
+  return SSL_get_ex_new_index (0, NULL, NULL, NULL, NULL);
+}
@@ -0,0 +1,168 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                               C L I E N T                                --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+--  Oneway throughput benchmark: several tasks push oneway requests to the
+--  server as fast as they can, and the number of packets per second sent
+--  by the client and processed by the server is reported. Run with a
+--  configuration that selects DIOP to compare datagram batching settings.
+
+with Ada.Calendar;
+with Ada.Command_Line;
+with Ada.Text_IO;
+
+with CORBA.ORB;
+
+with Test.Sink;
+
+with PolyORB.Setup.Client;
+pragma Warnings (Off, PolyORB.Setup.Client);
+
+with PolyORB.Setup.Tasking.Full_Tasking;
+pragma Warnings (Off, PolyORB.Setup.Tasking.Full_Tasking);
+
+with PolyORB.Utils.Report;
+
+procedure Client is
+
+   use Ada.Calendar;
+   use Ada.Command_Line;
+   use Ada.Text_IO;
+   use PolyORB.Utils.Report;
+
+   use type CORBA.Long;
+
+   Senders            : Positive := 4;
+   Packets_Per_Sender : Positive := 10_000;
+
+   Drain_Delay : constant Duration := 2.0;
+   --  Time left to the server to process the requests still in transit
+   --  when all senders are done.
+
+   Sink : Test.Sink.Ref;
+
+   task type Sender is
+      entry Start (Id : Positive);
+   end Sender;
+
+   procedure Usage;
+
+   ------------
+   -- Sender --
+   ------------
+
+   task body Sender is
+      Base : CORBA.Long;
+   begin
+      accept Start (Id : Positive) do
+         Base := CORBA.Long (Id) * 1_000_000;
+      end Start;
+
+      for J in 1 .. Packets_Per_Sender loop
+         Test.Sink.Push (Sink, Base + CORBA.Long (J));
+      end loop;
+   end Sender;
+
+   -----------
+   -- Usage --
+   -----------
+
+   procedure Usage is
+   begin
+      Put_Line ("Usage:");
+      Put_Line ("  client <IOR> [senders] [packets per sender]");
+   end Usage;
+
+begin
+   if Argument_Count /= 1 and then Argument_Count /= 3 then
+      Usage;
+      return;
+   end if;
+
+   if Argument_Count = 3 then
+      Senders := Positive'Value (Argument (2));
+      Packets_Per_Sender := Positive'Value (Argument (3));
+   end if;
+
+   New_Test ("Oneway throughput benchmark");
+
+   declare
+      Argv : CORBA.ORB.Arg_List := CORBA.ORB.Command_Line_Arguments;
+   begin
+      CORBA.ORB.Init (CORBA.ORB.To_CORBA_String ("ORB"), Argv);
+   end;
+
+   CORBA.ORB.String_To_Object (CORBA.To_CORBA_String (Argument (1)), Sink);
+   Test.Sink.Reset (Sink);
+
+   declare
+      Total : constant Natural := Senders * Packets_Per_Sender;
+
+      Start, Finish : Time;
+      Received      : CORBA.Long;
+
+   begin
+      Start := Clock;
+      declare
+         Tasks : array (1 .. Senders) of Sender;
+      begin
+         for J in Tasks'Range loop
+            Tasks (J).Start (J);
+         end loop;
+
+         --  Wait for all senders to terminate
+      end;
+      Finish := Clock;
+
+      Put_Line ("Sent" & Natural'Image (Total) & " oneway requests from"
+                & Positive'Image (Senders) & " task(s) in"
+                & Duration'Image (Finish - Start) & " s");
+      Put_Line ("Packets/s sent:"
+                & Integer'Image (Integer (Duration (Total)
+                                          / (Finish - Start))));
+      Output ("Oneway requests sent", True);
+
+      delay Drain_Delay;
+      Received := Test.Sink.Received (Sink);
+
+      --  Datagrams may be lost, so only require that some were processed
+
+      Put_Line ("Received" & CORBA.Long'Image (Received) & " of"
+                & Natural'Image (Total) & " oneway requests");
+      Put_Line ("Packets/s received:"
+                & Integer'Image (Integer (Duration (Received)
+                                          / (Finish - Start))));
+      Output ("Oneway requests received", Received > 0);
+   end;
+
+   End_Report;
+   CORBA.ORB.Shutdown (False);
+end Client;
@@ -0,0 +1,77 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                               S E R V E R                                --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+with Ada.Text_IO;
+
+with CORBA.Object;
+with CORBA.ORB;
+with PortableServer.POA.Helper;
+with PortableServer.POAManager;
+
+with PolyORB.Setup.Thread_Pool_Server;
+pragma Warnings (Off, PolyORB.Setup.Thread_Pool_Server);
+
+with Test.Sink.Impl;
+
+procedure Server is
+begin
+
+   declare
+      Argv : CORBA.ORB.Arg_List := CORBA.ORB.Command_Line_Arguments;
+   begin
+      CORBA.ORB.Init (CORBA.ORB.To_CORBA_String ("ORB"), Argv);
+   end;
+
+   declare
+      Root_POA : constant PortableServer.POA.Local_Ref
+        := PortableServer.POA.Helper.To_Local_Ref
+            (CORBA.ORB.Resolve_Initial_References
+              (CORBA.ORB.To_CORBA_String ("RootPOA")));
+
+      Srv : constant Test.Sink.Impl.Object_Ptr := new Test.Sink.Impl.Object;
+      Ref : CORBA.Object.Ref;
+
+   begin
+      PortableServer.POAManager.Activate
+       (PortableServer.POA.Get_The_POAManager (Root_POA));
+
+      Ref := PortableServer.POA.Servant_To_Reference
+               (Root_POA, PortableServer.Servant (Srv));
+
+      Ada.Text_IO.Put_Line
+        ("'"
+         & CORBA.To_Standard_String (CORBA.ORB.Object_To_String (Ref))
+         & "'");
+   end;
+
+   CORBA.ORB.Run;
+end Server;
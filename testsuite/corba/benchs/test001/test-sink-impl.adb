@@ -0,0 +1,104 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                       T E S T . S I N K . I M P L                        --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+with Test.Sink.Skel;
+pragma Warnings (Off, Test.Sink.Skel);
+
+package body Test.Sink.Impl is
+
+   protected Counter is
+      procedure Increment;
+      procedure Clear;
+      function Value return CORBA.Long;
+   private
+      Count : CORBA.Long := 0;
+   end Counter;
+   --  Push requests are processed concurrently by the tasks of the pool
+
+   -------------
+   -- Counter --
+   -------------
+
+   protected body Counter is
+
+      procedure Clear is
+      begin
+         Count := 0;
+      end Clear;
+
+      procedure Increment is
+         use type CORBA.Long;
+      begin
+         Count := Count + 1;
+      end Increment;
+
+      function Value return CORBA.Long is
+      begin
+         return Count;
+      end Value;
+
+   end Counter;
+
+   ----------
+   -- Push --
+   ----------
+
+   procedure Push
+     (Self : access Object;
+      Seq  : CORBA.Long)
+   is
+      pragma Unreferenced (Self, Seq);
+   begin
+      Counter.Increment;
+   end Push;
+
+   --------------
+   -- Received --
+   --------------
+
+   function Received (Self : access Object) return CORBA.Long is
+      pragma Unreferenced (Self);
+   begin
+      return Counter.Value;
+   end Received;
+
+   -----------
+   -- Reset --
+   -----------
+
+   procedure Reset (Self : access Object) is
+      pragma Unreferenced (Self);
+   begin
+      Counter.Clear;
+   end Reset;
+
+end Test.Sink.Impl;
@@ -0,0 +1,338 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                            T E S T _ E T C L                             --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+--  Unit test of the compiled constraints of notification filters, in the
+--  EXTENDED_TCL grammar.
+
+with CORBA.ORB;
+
+with CosNotification.Helper;
+with CosNotifyFilter.Constraints;
+
+with PolyORB.Setup.No_Tasking_Server;
+pragma Warnings (Off, PolyORB.Setup.No_Tasking_Server);
+
+with PolyORB.Utils.Report;
+
+procedure Test_ETCL is
+
+   use CORBA;
+   use CosNotification;
+   use CosNotifyFilter;
+   use CosNotifyFilter.Constraints;
+   use IDL_SEQUENCE_CosNotification_EventType;
+   use IDL_SEQUENCE_CosNotification_Property;
+
+   use PolyORB.Utils.Report;
+
+   Event : StructuredEvent;
+   --  Event of domain "D", type "T" and name "E", with filterable data
+   --  p = 5, s = 'hello' and b = TRUE.
+
+   No_Types : EventTypeSeq;
+
+   function Exp
+     (Text  : Standard.String;
+      Types : EventTypeSeq := No_Types) return ConstraintExp;
+   --  Return the constraint expression Text, for events of Types
+
+   function Is_Valid (Text : Standard.String) return Boolean;
+   --  True if Text is accepted as a constraint
+
+   function Matches
+     (Text  : Standard.String;
+      Types : EventTypeSeq := No_Types) return Boolean;
+   --  True if Event satisfies constraint Text, for events of Types
+
+   function Prop
+     (Name  : Standard.String;
+      Value : CORBA.Any) return Property;
+   --  Return property Name with Value
+
+   procedure Check_Match (Text : Standard.String; Expected : Boolean);
+   --  Report whether Event satisfies constraint Text as Expected
+
+   -----------------
+   -- Check_Match --
+   -----------------
+
+   procedure Check_Match (Text : Standard.String; Expected : Boolean) is
+   begin
+      Output ("Match " & Text, Matches (Text) = Expected);
+   end Check_Match;
+
+   ---------
+   -- Exp --
+   ---------
+
+   function Exp
+     (Text  : Standard.String;
+      Types : EventTypeSeq := No_Types) return ConstraintExp
+   is
+   begin
+      return (event_types     => Types,
+              constraint_expr => To_CORBA_String (Text));
+   end Exp;
+
+   --------------
+   -- Is_Valid --
+   --------------
+
+   function Is_Valid (Text : Standard.String) return Boolean is
+   begin
+      Check (Exp (Text));
+      return True;
+   exception
+      when Invalid_Constraint =>
+         return False;
+   end Is_Valid;
+
+   -------------
+   -- Matches --
+   -------------
+
+   function Matches
+     (Text  : Standard.String;
+      Types : EventTypeSeq := No_Types) return Boolean
+   is
+      Set    : Constraint_Set;
+      Result : Boolean;
+   begin
+      Initialize (Set);
+      Add (Set, 1, Exp (Text, Types));
+      Result := Match_Structured (Set, Event);
+      Destroy (Set);
+      return Result;
+   end Matches;
+
+   ----------
+   -- Prop --
+   ----------
+
+   function Prop
+     (Name  : Standard.String;
+      Value : CORBA.Any) return Property
+   is
+   begin
+      return (name  => To_CORBA_String (Name),
+              value => Value);
+   end Prop;
+
+   Data : PropertySeq;
+
+begin
+   CORBA.ORB.Initialize ("ORB");
+
+   Event.header.fixed_header.event_type.domain_name := To_CORBA_String ("D");
+   Event.header.fixed_header.event_type.type_name := To_CORBA_String ("T");
+   Event.header.fixed_header.event_name := To_CORBA_String ("E");
+   Append (Data, Prop ("p", To_Any (CORBA.Long (5))));
+   Append (Data,
+           Prop ("s", To_Any (CORBA.String'(To_CORBA_String ("hello")))));
+   Append (Data, Prop ("b", To_Any (CORBA.Boolean'(True))));
+   Event.filterable_data := FilterableEventBody (Data);
+
+   --  Parsing
+
+   New_Test ("Parsing");
+
+   Output ("Empty constraint is valid", Is_Valid (""));
+   Output ("Complete component names are valid",
+           Is_Valid ("$.header.fixed_header.event_type.type_name == 'T'"
+                     & " and $.header.fixed_header.event_name == 'E'"));
+   Output ("Arithmetic is valid", Is_Valid ("-$p + 1 > 2 * $q / 3 - 4"));
+   Output ("Nested expressions are valid",
+           Is_Valid ("not (exist $p or ($s ~ 'a\'b')) and TRUE"));
+   Output ("Exponents are valid", Is_Valid ("$p < 1.5e+3"));
+
+   --  Invalid input
+
+   New_Test ("Invalid input");
+
+   Output ("Missing operand is rejected", not Is_Valid ("$type_name =="));
+   Output ("Missing parenthesis is rejected", not Is_Valid ("(1 == 1"));
+   Output ("Unterminated string is rejected", not Is_Valid ("$s == 'abc"));
+   Output ("Unknown word is rejected", not Is_Valid ("$p in 1"));
+   Output ("Unsupported component is rejected",
+           not Is_Valid ("$a.b == 1"));
+   Output ("Trailing tokens are rejected", not Is_Valid ("1 2"));
+   Output ("exist without component is rejected",
+           not Is_Valid ("exist 1"));
+   Output ("Single = is rejected", not Is_Valid ("$p = 5"));
+
+   --  Matching
+
+   New_Test ("Matching");
+
+   Check_Match ("", True);
+   Check_Match ("$type_name == 'T'", True);
+   Check_Match ("$domain_name != 'D'", False);
+   Check_Match ("$.header.fixed_header.event_name == 'E'", True);
+   Check_Match ("$p == 5 and $b", True);
+   Check_Match ("$p * 2 - 1 == 9", True);
+   Check_Match ("-$p == -5", True);
+   Check_Match ("$s < 'world'", True);
+
+   --  Predicates with the literal first are evaluated with the operands
+   --  in the written order.
+
+   New_Test ("Reversed predicates");
+
+   Check_Match ("$p > 4", True);
+   Check_Match ("4 < $p", True);
+   Check_Match ("6 < $p", False);
+   Check_Match ("5 >= $p and $p >= 5", True);
+   Check_Match ("'world' > $s", True);
+
+   --  Substring
+
+   New_Test ("Substring operator");
+
+   Check_Match ("'ell' ~ $s", True);
+   Check_Match ("'xyz' ~ $s", False);
+   Check_Match ("$s ~ 'hello world'", True);
+   Check_Match ("$s ~ 'help'", False);
+   Check_Match ("'' ~ $s", True);
+   Check_Match ("$p ~ 'hello'", False);
+
+   --  exist
+
+   New_Test ("exist");
+
+   Check_Match ("exist $p", True);
+   Check_Match ("exist $missing", False);
+   Check_Match ("not exist $missing", True);
+   Check_Match ("exist $type_name", True);
+
+   --  The right operand of and/or is not evaluated when the left one
+   --  determines the result, and a failed evaluation does not satisfy
+   --  the constraint.
+
+   New_Test ("Short-circuit evaluation");
+
+   Check_Match ("$missing == 1", False);
+   Check_Match ("not ($missing == 1)", False);
+   Check_Match ("TRUE or $missing == 1", True);
+   Check_Match ("not (FALSE and $missing == 1)", True);
+   Check_Match ("not ($missing == 1 and FALSE)", False);
+   Check_Match ("$p / 0 == 1 or TRUE", False);
+
+   --  Event types
+
+   New_Test ("Event types");
+
+   declare
+      Types : EventTypeSeq;
+   begin
+      Append (Types, (domain_name => To_CORBA_String ("D"),
+                      type_name   => To_CORBA_String ("X*")));
+      Output ("Constraint for other types is ignored",
+              not Matches ("TRUE", Types));
+
+      Append (Types, (domain_name => To_CORBA_String ("*"),
+                      type_name   => To_CORBA_String ("T")));
+      Output ("Constraint for type of event applies",
+              Matches ("TRUE", Types));
+   end;
+
+   --  Sets of constraints: entries shared by several constraints remain
+   --  usable when some of them are removed.
+
+   New_Test ("Constraint sets");
+
+   declare
+      Set : Constraint_Set;
+   begin
+      Initialize (Set);
+      Add (Set, 1, Exp ("$p == 4"));
+      Add (Set, 2, Exp ("$s == 'hello' and $p == 5"));
+      Add (Set, 3, Exp ("4 < $p and exist $b"));
+      Output ("Any satisfied constraint matches",
+              Match_Structured (Set, Event));
+
+      Remove (Set, 2);
+      Output ("Remaining constraints still match",
+              Match_Structured (Set, Event));
+
+      Remove (Set, 3);
+      Output ("Removed constraints no longer match",
+              not Match_Structured (Set, Event));
+
+      begin
+         Add (Set, 4, Exp ("$p == 5 and $s =="));
+         Output ("Invalid constraint is not added", False);
+      exception
+         when Invalid_Constraint =>
+            Output ("Invalid constraint is not added",
+                    not Match_Structured (Set, Event));
+      end;
+
+      Add (Set, 5, Exp ("$b == TRUE and $s ~ 'hello'"));
+      Output ("Constraint added after removals matches",
+              Match_Structured (Set, Event));
+
+      Remove (Set, 5);
+      Remove (Set, 1);
+      Add (Set, 6, Exp ("$p == 4 or 5 == $p"));
+      Output ("Constraint added to emptied set matches",
+              Match_Structured (Set, Event));
+
+      Clear (Set);
+      Output ("Cleared set does not match", not Match_Structured (Set, Event));
+      Destroy (Set);
+   end;
+
+   --  Other kinds of events
+
+   New_Test ("Unstructured events");
+
+   declare
+      Set : Constraint_Set;
+   begin
+      Initialize (Set);
+      Add (Set, 1, Exp ("$ == 5"));
+      Output ("Whole event is compared",
+              Match (Set, To_Any (CORBA.Long (5)))
+              and then not Match (Set, To_Any (CORBA.Long (6))));
+      Output ("Structured event in any is matched",
+              not Match (Set, CosNotification.Helper.To_Any (Event)));
+
+      Clear (Set);
+      Add (Set, 1, Exp ("$s == 'hello'"));
+      Output ("Property sequence is matched", Match_Typed (Set, Data));
+      Output ("Property sequence in any is matched",
+              Match (Set, CosNotification.Helper.To_Any (Data)));
+      Destroy (Set);
+   end;
+
+   End_Report;
+end Test_ETCL;
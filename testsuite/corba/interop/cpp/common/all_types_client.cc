@@ -1,4 +1,5 @@
 #include "report.cc"
+#include "bench.cc"
 
 #ifdef __USE_OMNIORB__
 #include <all_types.hh>
@@ -433,19 +434,102 @@ static void test(all_types_ptr p)
  end_report();
 }
 
+// Benchmark mode: each echo operation is called repeatedly by several
+// threads, and throughput and latency are reported (see bench.cc).
+
+static all_types::U_sequence bench_useq;
+static all_types::bigmatrix bench_bigmatrix;
+static all_types::simple_struct bench_struct;
+static all_types::myUnion bench_union;
+
+static bool bench_echoLong (void *t)
+{
+  return ((all_types_ptr) t)->echoLong (456) == 456;
+}
+
+static bool bench_echoString (void *t)
+{
+  CORBA::String_var s = ((all_types_ptr) t)->echoString ("hello");
+  return !strcmp (s, "hello");
+}
+
+static bool bench_echoUsequence (void *t)
+{
+  all_types::U_sequence_var s = ((all_types_ptr) t)->echoUsequence (bench_useq);
+  return s->length () == bench_useq.length ()
+    && s [s->length () - 1] == bench_useq [bench_useq.length () - 1];
+}
+
+static bool bench_echoBigMatrix (void *t)
+{
+  all_types::bigmatrix_var m = ((all_types_ptr) t)->echoBigMatrix (bench_bigmatrix);
+  return ((CORBA::Long(*)[15])m)[29][14] == bench_bigmatrix[29][14];
+}
+
+static bool bench_echoStruct (void *t)
+{
+  all_types::simple_struct_var s = ((all_types_ptr) t)->echoStruct (bench_struct);
+  return s->a == bench_struct.a && !strcmp (s->s, bench_struct.s);
+}
+
+static bool bench_echoUnion (void *t)
+{
+  all_types::myUnion u = ((all_types_ptr) t)->echoUnion (bench_union);
+  return u._d () == bench_union._d () && u.Counter () == bench_union.Counter ();
+}
+
+static void bench_all (all_types_ptr p, long iterations, int threads)
+{
+  bench_useq.length (1000);
+  for (CORBA::ULong i = 0; i < bench_useq.length (); i++)
+    bench_useq [i] = (CORBA::Short) i;
+
+  for (int i = 0; i < 30; i++)
+    for (int j = 0; j < 15; j++)
+      bench_bigmatrix[i][j] = ((i + 1) * (j + 2));
+
+  bench_struct.a = 123;
+  bench_struct.s = (const char *) "foobar";
+
+  bench_union.Counter (123);
+
+  bench_header ();
+  bench ("echoLong", bench_echoLong, p, iterations, threads);
+  bench ("echoString", bench_echoString, p, iterations, threads);
+  bench ("echoUsequence", bench_echoUsequence, p, iterations, threads);
+  bench ("echoBigMatrix", bench_echoBigMatrix, p, iterations, threads);
+  bench ("echoStruct", bench_echoStruct, p, iterations, threads);
+  bench ("echoUnion", bench_echoUnion, p, iterations, threads);
+
+  end_report ();
+}
+
+static void usage ()
+{
+  cerr << "usage: all_types_client [-bench <iterations> <threads>] <IOR>"
+       << endl;
+  exit (EXIT_FAILURE);
+}
+
 int main(int argc, char** argv)
 {
   try
     {
       CORBA::ORB_var orb = CORBA::ORB_init(argc, argv);
-      
-      if (argc != 2)
+      long iterations = 0;
+      int threads = 1;
+
+      if (argc == 5 && !strcmp (argv[1], "-bench"))
 	{
-	  cerr << "wrong number of param." << endl;
-	  exit(EXIT_FAILURE);
+	  iterations = atol (argv[2]);
+	  threads = atoi (argv[3]);
+	  if (iterations <= 0 || threads <= 0)
+	    usage ();
 	}
-      
-      CORBA::Object_var obj = orb->string_to_object(argv[1]);
+      else if (argc != 2)
+	usage ();
+
+      CORBA::Object_var obj = orb->string_to_object(argv[argc - 1]);
 
       all_types_var alltref = all_types::_narrow(obj);
 
@@ -455,7 +539,10 @@ int main(int argc, char** argv)
 	  exit(EXIT_FAILURE);
 	}
       
-      test(alltref);
+      if (iterations > 0)
+	bench_all(alltref, iterations, threads);
+      else
+	test(alltref);
 
       orb->destroy();
 
@@ -0,0 +1,129 @@
+// Benchmark support for the C++ interoperability clients: run a call
+// for a number of iterations in each of several concurrent threads, and
+// report throughput and latency percentiles as one comma-separated line
+// per operation, so that results from different ORBs can be compared.
+
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#if defined (__USE_OMNIORB__)
+static const char *bench_orb = "omniORB";
+#elif defined (__USE_TAO__)
+static const char *bench_orb = "TAO";
+#elif defined (__USE_MICO__)
+static const char *bench_orb = "MICO";
+#else
+static const char *bench_orb = "unknown";
+#endif
+
+// A benchmarked call returns true if the echoed value is correct
+
+typedef bool (*bench_call) (void *target);
+
+struct bench_thread_args
+{
+  bench_call call;
+  void *target;
+  long iterations;
+  std::vector<double> samples;
+  bool pass;
+};
+
+// Current time in microseconds
+
+static double bench_now ()
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void *bench_thread (void *p)
+{
+  bench_thread_args *args = (bench_thread_args *) p;
+
+  args->samples.reserve (args->iterations);
+  for (long i = 0; i < args->iterations; i++)
+    {
+      double start = bench_now ();
+      bool ok;
+
+      try
+        {
+          ok = args->call (args->target);
+        }
+      catch (...)
+        {
+          ok = false;
+        }
+      args->samples.push_back (bench_now () - start);
+      args->pass = args->pass && ok;
+    }
+  return NULL;
+}
+
+static double bench_percentile (const std::vector<double> &sorted, double q)
+{
+  if (sorted.empty ())
+    return 0.0;
+
+  size_t i = (size_t) (q * (sorted.size () - 1) + 0.5);
+  return sorted [i];
+}
+
+void bench_header ()
+{
+  cout << "orb,operation,threads,iterations,ops_per_sec,"
+       << "p50_us,p99_us,p999_us" << endl;
+}
+
+// Run Call on Target Iterations times in each of Threads threads, and
+// report results under Name. The calls of all threads share Target.
+
+void bench (const char *name, bench_call call, void *target,
+            long iterations, int threads)
+{
+  std::vector<bench_thread_args> args (threads);
+  std::vector<pthread_t> tids (threads);
+  std::vector<double> all;
+  bool pass = true;
+
+  // Warm up connection and caches before measuring
+
+  for (int i = 0; i < 10; i++)
+    call (target);
+
+  double start = bench_now ();
+  for (int t = 0; t < threads; t++)
+    {
+      args [t].call = call;
+      args [t].target = target;
+      args [t].iterations = iterations;
+      args [t].pass = true;
+      pthread_create (&tids [t], NULL, bench_thread, &args [t]);
+    }
+  for (int t = 0; t < threads; t++)
+    {
+      pthread_join (tids [t], NULL);
+      all.insert (all.end (), args [t].samples.begin (),
+                  args [t].samples.end ());
+      pass = pass && args [t].pass;
+    }
+  double elapsed = bench_now () - start;
+
+  std::sort (all.begin (), all.end ());
+
+  cout << bench_orb << "," << name << "," << threads << ","
+       << iterations << "," << fixed << setprecision (1)
+       << (elapsed > 0 ? all.size () * 1e6 / elapsed : 0.0) << ","
+       << bench_percentile (all, 0.50) << ","
+       << bench_percentile (all, 0.99) << ","
+       << bench_percentile (all, 0.999) << endl;
+
+  if (!pass)
+    cerr << name << ": incorrect result" << endl;
+  passed = passed && pass;
+}
@@ -30,7 +30,12 @@
 --                                                                          --
 ------------------------------------------------------------------------------
 
+with Interfaces;
+with System.Storage_Elements;
+
 with PolyORB.Any;
+with PolyORB.Any.Interning;
+with PolyORB.Arenas;
 with PolyORB.Initialization;
 with PolyORB.Types;
 with PolyORB.Utils.Report;
@@ -45,6 +50,163 @@ procedure Test000 is
    use PolyORB.Types;
 
    procedure Simple_Test;
+   procedure Arena_Test;
+   procedure Interning_Test;
+
+   Heap_Allocations  : Natural := 0;
+   Arena_Allocations : Natural := 0;
+
+   procedure Count_Allocation
+     (Kind : PolyORB.Arenas.Allocation_Kind;
+      Size : System.Storage_Elements.Storage_Count);
+   --  Allocation hook used by Arena_Test
+
+   ----------------
+   -- Arena_Test --
+   ----------------
+
+   procedure Arena_Test is
+      use PolyORB.Arenas;
+
+      N : constant := 1_000;
+
+      procedure Build_Values;
+      --  Build N Anys, then finalize them
+
+      ------------------
+      -- Build_Values --
+      ------------------
+
+      procedure Build_Values is
+         Values : array (1 .. N) of Any;
+      begin
+         for J in Values'Range loop
+            Values (J) := To_Any (PolyORB.Types.Long (J));
+         end loop;
+      end Build_Values;
+
+      Without_Arena : Natural;
+      Kept          : Any;
+      Kept_Value    : PolyORB.Types.Long;
+
+   begin
+      On_Allocation := Count_Allocation'Unrestricted_Access;
+
+      Build_Values;
+      Without_Arena := Heap_Allocations;
+      Output ("Arena: contents allocated from the heap out of arenas",
+              Without_Arena >= N and then Arena_Allocations = 0);
+
+      Heap_Allocations := 0;
+      declare
+         A     : Arena_Ref;
+         Scope : Arena_Scope;
+      begin
+         Create (A);
+         Enter (Scope, A);
+         Build_Values;
+         Kept := To_Any (PolyORB.Types.Long (42));
+      end;
+
+      Output ("Arena: contents allocated from the current arena",
+              Arena_Allocations > N);
+      Output ("Arena:" & Heap_Allocations'Img & " heap allocations instead of"
+              & Without_Arena'Img, Heap_Allocations * 10 < Without_Arena);
+
+      --  The content of Kept was allocated from the arena, which has no
+      --  references left.
+
+      Kept_Value := From_Any (Kept);
+      Output ("Arena: values outlive references to their arena",
+              Kept_Value = 42);
+
+      --  Arenas entered on demand are only created by an allocation
+
+      declare
+         A : aliased Arena_Ref;
+      begin
+         declare
+            Scope : Arena_Scope;
+         begin
+            Enter_On_Demand (Scope, A'Access);
+         end;
+         Output ("Arena: no arena created on demand without allocation",
+                 Is_Nil (A));
+
+         Arena_Allocations := 0;
+         declare
+            Scope : Arena_Scope;
+         begin
+            Enter_On_Demand (Scope, A'Access);
+            Build_Values;
+         end;
+         Output ("Arena: arena created on demand by first allocation",
+                 not Is_Nil (A) and then Arena_Allocations > N);
+      end;
+
+      On_Allocation := null;
+   end Arena_Test;
+
+   ----------------------
+   -- Count_Allocation --
+   ----------------------
+
+   procedure Count_Allocation
+     (Kind : PolyORB.Arenas.Allocation_Kind;
+      Size : System.Storage_Elements.Storage_Count)
+   is
+      pragma Unreferenced (Size);
+      use PolyORB.Arenas;
+   begin
+      case Kind is
+         when Heap_Object | Arena_Chunk =>
+            Heap_Allocations := Heap_Allocations + 1;
+         when Arena_Object =>
+            Arena_Allocations := Arena_Allocations + 1;
+      end case;
+   end Count_Allocation;
+
+   --------------------
+   -- Interning_Test --
+   --------------------
+
+   procedure Interning_Test is
+      use PolyORB.Any.Interning;
+      use PolyORB.Any.TypeCode;
+      use type Interfaces.Unsigned_64;
+
+      function Point_TC (Id : Standard.String) return Local_Ref;
+      --  Build a new struct typecode with two long members
+
+      --------------
+      -- Point_TC --
+      --------------
+
+      function Point_TC (Id : Standard.String) return Local_Ref is
+      begin
+         return Build_Complex_TC
+           (Tk_Struct,
+            (To_Any (To_PolyORB_String ("Point")),
+             To_Any (To_PolyORB_String (Id)),
+             To_Any (TC_Long), To_Any (To_PolyORB_String ("x")),
+             To_Any (TC_Long), To_Any (To_PolyORB_String ("y"))));
+      end Point_TC;
+
+      Hits : constant Interfaces.Unsigned_64 := Statistics.Hits;
+      TC1  : constant Local_Ref := Intern (Point_TC ("IDL:Point:1.0"));
+      TC2  : constant Local_Ref := Intern (Point_TC ("IDL:Point:1.0"));
+      TC3  : constant Local_Ref := Intern (Point_TC ("IDL:Point:2.0"));
+
+   begin
+      Output ("Interning: equal typecodes share one object",
+              Object_Of (TC1) = Object_Of (TC2)
+              and then Statistics.Hits = Hits + 1);
+      Output ("Interning: equality of interned typecodes",
+              Equal (TC1, TC2) and then not Equal (TC1, TC3));
+      Output ("Interning: interned and non-interned typecodes",
+              Equal (TC3, Point_TC ("IDL:Point:2.0"))
+              and then not Equal (TC1, Point_TC ("IDL:Point:2.0")));
+   end Interning_Test;
 
    -----------------
    -- Simple_Test --
@@ -67,5 +229,7 @@ procedure Test000 is
 begin
    PolyORB.Initialization.Initialize_World;
    Simple_Test;
+   Arena_Test;
+   Interning_Test;
    End_Report;
 end Test000;
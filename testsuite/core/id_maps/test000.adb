@@ -0,0 +1,197 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                              T E S T 0 0 0                               --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+with Ada.Real_Time;
+with Ada.Text_IO;
+with Interfaces;
+
+with PolyORB.Utils.Id_Maps;
+with PolyORB.Utils.Report;
+
+procedure Test000 is
+
+   use Ada.Real_Time;
+   use Ada.Text_IO;
+   use Interfaces;
+   use PolyORB.Utils.Report;
+
+   type Pending is record
+      Id : Unsigned_32;
+   end record;
+   type Pending_Access is access all Pending;
+
+   package Pending_Maps is new PolyORB.Utils.Id_Maps
+     (Id_Type    => Unsigned_32,
+      Element    => Pending_Access,
+      No_Element => null);
+   use Pending_Maps;
+
+   procedure Test_Basic;
+   --  Check insertion, lookup, rejection of duplicates, replacement,
+   --  iteration and removal
+
+   procedure Bench_Dispatch (In_Flight : Positive);
+   --  Keep In_Flight requests pending, and measure the average time taken
+   --  to retrieve and remove one by its id and to add a new one, as done
+   --  for each reply received on a GIOP session.
+
+   ----------------
+   -- Test_Basic --
+   ----------------
+
+   procedure Test_Basic is
+      Last_Id : constant := 5_000;
+
+      M        : Map;
+      P        : Pending_Access;
+      Ok       : Boolean := True;
+      Inserted : Boolean;
+      Count    : Natural := 0;
+
+      procedure Count_One (Id : Unsigned_32; E : Pending_Access);
+
+      procedure Count_One (Id : Unsigned_32; E : Pending_Access) is
+      begin
+         Ok := Ok and then E.Id = Id;
+         Count := Count + 1;
+      end Count_One;
+
+      procedure Count_All is new Iterate (Count_One);
+
+   begin
+      for J in Unsigned_32 range 1 .. Last_Id loop
+         Insert (M, J, new Pending'(Id => J), Inserted);
+         Ok := Ok and then Inserted;
+      end loop;
+
+      for J in Unsigned_32 range 1 .. Last_Id loop
+         P := Lookup (M, J);
+         Ok := Ok and then P /= null and then P.Id = J;
+      end loop;
+      Ok := Ok
+        and then Lookup (M, 0) = null
+        and then Lookup (M, Last_Id + 1) = null;
+      Output ("insert and lookup", Ok and then Length (M) = Last_Id);
+
+      for J in Unsigned_32 range 1 .. Last_Id loop
+         if J mod 2 = 1 then
+            Remove (M, J, P);
+            Ok := Ok and then P /= null and then P.Id = J;
+         end if;
+      end loop;
+      for J in Unsigned_32 range 1 .. Last_Id loop
+         P := Lookup (M, J);
+         if J mod 2 = 1 then
+            Ok := Ok and then P = null;
+         else
+            Ok := Ok and then P /= null and then P.Id = J;
+         end if;
+      end loop;
+      Remove (M, 1, P);
+      Ok := Ok and then P = null;
+      Output ("remove", Ok and then Length (M) = Last_Id / 2);
+
+      P := Lookup (M, 2);
+      Insert (M, 2, new Pending'(Id => 2), Inserted);
+      Ok := not Inserted
+        and then Lookup (M, 2) = P
+        and then Length (M) = Last_Id / 2;
+      Output ("duplicate", Ok);
+
+      Replace (M, 2, new Pending'(Id => 2));
+      Ok := Lookup (M, 2) /= P and then Length (M) = Last_Id / 2;
+      Output ("replace", Ok);
+
+      Count_All (M);
+      Output ("iterate", Ok and then Count = Last_Id / 2);
+
+      Clear (M);
+      Output ("clear", Length (M) = 0 and then Lookup (M, 2) = null);
+      Deallocate (M);
+   end Test_Basic;
+
+   --------------------
+   -- Bench_Dispatch --
+   --------------------
+
+   procedure Bench_Dispatch (In_Flight : Positive) is
+      Iterations : constant := 200_000;
+
+      M       : Map;
+      P       : Pending_Access;
+      Next_Id : Unsigned_32 := 1;
+      Oldest  : Unsigned_32 := 1;
+      Ok      : Boolean := True;
+      Success : Boolean;
+      Start   : Time;
+      Elapsed : Duration;
+   begin
+      for J in 1 .. In_Flight loop
+         Insert (M, Next_Id, new Pending'(Id => Next_Id), Success);
+         Ok := Ok and then Success;
+         Next_Id := Next_Id + 1;
+      end loop;
+
+      Start := Clock;
+      for J in 1 .. Iterations loop
+
+         --  A reply arrives for the oldest request, and a new request is
+         --  issued in its place.
+
+         Remove (M, Oldest, P);
+         Ok := Ok and then P /= null and then P.Id = Oldest;
+         Oldest := Oldest + 1;
+
+         P.Id := Next_Id;
+         Insert (M, Next_Id, P, Success);
+         Ok := Ok and then Success;
+         Next_Id := Next_Id + 1;
+      end loop;
+      Elapsed := To_Duration (Clock - Start);
+
+      Put_Line ("in flight:" & In_Flight'Img & ", ns per reply:"
+        & Integer'Image
+            (Integer (Float (Elapsed) * 1.0E9 / Float (Iterations))));
+      Output ("dispatch with" & In_Flight'Img & " requests in flight",
+              Ok and then Length (M) = In_Flight);
+      Deallocate (M);
+   end Bench_Dispatch;
+
+begin
+   Test_Basic;
+   Bench_Dispatch (10);
+   Bench_Dispatch (100);
+   Bench_Dispatch (1_000);
+   Bench_Dispatch (10_000);
+   Bench_Dispatch (100_000);
+   End_Report;
+end Test000;
@@ -0,0 +1,273 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                                B E N C H                                 --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+--  Scaling benchmark of the active object maps: activation, look up and
+--  deactivation of objects in user id and system id maps holding 1k, 100k
+--  and 1M entries. This program is not part of the testsuite runs (see
+--  test000 for the functional tests).
+
+with Ada.Real_Time;
+with Ada.Text_IO;
+with Ada.Unchecked_Deallocation;
+
+with PolyORB.Object_Maps.System;
+with PolyORB.Object_Maps.User;
+with PolyORB.POA_Types;
+with PolyORB.Servants;
+with PolyORB.Utils.Report;
+
+with Test_Servant;
+
+procedure Bench is
+
+   use Ada.Real_Time;
+   use Ada.Text_IO;
+
+   use PolyORB.Object_Maps;
+   use PolyORB.Object_Maps.System;
+   use PolyORB.Object_Maps.User;
+   use PolyORB.POA_Types;
+   use PolyORB.Servants;
+   use PolyORB.Utils.Report;
+
+   type Servant_Array is array (Positive range <>) of Servant_Access;
+   type Servant_Array_Access is access Servant_Array;
+
+   procedure Free is new Ada.Unchecked_Deallocation
+     (Servant_Array, Servant_Array_Access);
+
+   function New_Entry
+     (Name    : String;
+      Servant : Servant_Access) return Object_Map_Entry_Access;
+   --  Return a new entry for a user-assigned object id
+
+   function Image (N : Natural) return String;
+   --  Image of N without the leading space
+
+   procedure Report_Time
+     (Label   : String;
+      Start   : Time;
+      N_Ops   : Positive);
+   --  Display the average time per operation since Start
+
+   procedure Bench_User_Map (N : Positive);
+   --  Activate N objects with distinct servants in a user id map, as done
+   --  by a POA with the USER_ID, UNIQUE_ID and RETAIN policies, then look
+   --  them up by id and by servant, and deactivate them.
+
+   procedure Bench_System_Map (N : Positive);
+   --  Same for a system id map, then repeatedly deactivate and reactivate
+   --  objects so that indices are reused.
+
+   -----------
+   -- Image --
+   -----------
+
+   function Image (N : Natural) return String is
+      S : constant String := Natural'Image (N);
+   begin
+      return S (S'First + 1 .. S'Last);
+   end Image;
+
+   ---------------
+   -- New_Entry --
+   ---------------
+
+   function New_Entry
+     (Name    : String;
+      Servant : Servant_Access) return Object_Map_Entry_Access
+   is
+      Result : constant Object_Map_Entry_Access := new Object_Map_Entry;
+   begin
+      Result.Oid := Create_Id
+        (Name             => Name,
+         System_Generated => False,
+         Persistency_Flag => Null_Time_Stamp,
+         Creator          => "bench");
+      Result.Servant := Servant;
+      return Result;
+   end New_Entry;
+
+   -----------------
+   -- Report_Time --
+   -----------------
+
+   procedure Report_Time
+     (Label   : String;
+      Start   : Time;
+      N_Ops   : Positive)
+   is
+      Elapsed : constant Duration := To_Duration (Clock - Start);
+   begin
+      Put_Line ("   " & Label & ", ns per operation:"
+        & Integer'Image (Integer (Float (Elapsed) * 1.0E9 / Float (N_Ops))));
+   end Report_Time;
+
+   --------------------
+   -- Bench_User_Map --
+   --------------------
+
+   procedure Bench_User_Map (N : Positive) is
+      M        : aliased User_Object_Map;
+      Servants : Servant_Array_Access := new Servant_Array (1 .. N);
+      E        : Object_Map_Entry_Access;
+      Ok       : Boolean := True;
+      Start    : Time;
+   begin
+      Put_Line ("User id map," & N'Img & " entries");
+      Initialize (M);
+      for J in 1 .. N loop
+         Servants (J) := new Test_Servant.My_Servant;
+      end loop;
+
+      Start := Clock;
+      for J in 1 .. N loop
+         if not Is_Servant_In (M, Servants (J)) then
+            Add (M'Access, New_Entry ("device" & Image (J), Servants (J)));
+         end if;
+      end loop;
+      Report_Time ("activate", Start, N);
+
+      Start := Clock;
+      for J in 1 .. N loop
+         E := Get_By_Id
+           (M, Create_Id (Name             => "device" & Image (J),
+                          System_Generated => False,
+                          Persistency_Flag => Null_Time_Stamp,
+                          Creator          => "bench"));
+         Ok := Ok and then E /= null and then E.Servant = Servants (J);
+      end loop;
+      Report_Time ("look up by id", Start, N);
+
+      Start := Clock;
+      for J in 1 .. N loop
+         E := Get_By_Servant (M, Servants (J));
+         Ok := Ok and then E /= null and then E.Servant = Servants (J);
+      end loop;
+      Report_Time ("look up by servant", Start, N);
+
+      Start := Clock;
+      for J in 1 .. N loop
+         E := Get_By_Servant (M, Servants (J));
+         E := Remove_By_Id (M'Access, E.Oid.all);
+         Free (E.Oid);
+         Free (E);
+      end loop;
+      Report_Time ("deactivate", Start, N);
+
+      Output ("user id map with" & N'Img & " entries",
+              Ok and then not Is_Servant_In (M, Servants (1)));
+      Finalize (M);
+      Free (Servants);
+   end Bench_User_Map;
+
+   ----------------------
+   -- Bench_System_Map --
+   ----------------------
+
+   procedure Bench_System_Map (N : Positive) is
+      Iterations : constant := 100_000;
+
+      M        : aliased System_Object_Map;
+      Servants : Servant_Array_Access := new Servant_Array (1 .. N);
+      E        : Object_Map_Entry_Access;
+      Index    : Integer;
+      Ok       : Boolean := True;
+      Start    : Time;
+   begin
+      Put_Line ("System id map," & N'Img & " entries");
+      Initialize (M);
+      for J in 1 .. N loop
+         Servants (J) := new Test_Servant.My_Servant;
+      end loop;
+
+      Start := Clock;
+      for J in 1 .. N loop
+         if not Is_Servant_In (M, Servants (J)) then
+            E := new Object_Map_Entry;
+            Index := Add (M'Access, E);
+            E.Oid := Create_Id
+              (Name             => Image (Index),
+               System_Generated => True,
+               Persistency_Flag => Null_Time_Stamp,
+               Creator          => "bench");
+            Set_Servant (M'Access, E, Servants (J));
+         end if;
+      end loop;
+      Report_Time ("activate", Start, N);
+
+      Start := Clock;
+      for J in 1 .. N loop
+         E := Get_By_Servant (M, Servants (J));
+         Ok := Ok and then E /= null and then E.Servant = Servants (J);
+      end loop;
+      Report_Time ("look up by servant", Start, N);
+
+      --  Deactivate and reactivate objects, scattered across the map
+
+      Start := Clock;
+      for J in 1 .. Iterations loop
+         declare
+            S : constant Servant_Access := Servants (1 + (J * 7919) mod N);
+         begin
+            E := Get_By_Servant (M, S);
+            E := Remove_By_Id (M'Access, E.Oid.all);
+            Free (E.Oid);
+            E.Servant := null;
+            Index := Add (M'Access, E);
+            E.Oid := Create_Id
+              (Name             => Image (Index),
+               System_Generated => True,
+               Persistency_Flag => Null_Time_Stamp,
+               Creator          => "bench");
+            Set_Servant (M'Access, E, S);
+            Ok := Ok and then Index <= N;
+         end;
+      end loop;
+      Report_Time ("deactivate and reactivate", Start, Iterations);
+
+      Output ("system id map with" & N'Img & " entries", Ok);
+      Finalize (M);
+      Free (Servants);
+   end Bench_System_Map;
+
+begin
+   Bench_User_Map (1_000);
+   Bench_User_Map (100_000);
+   Bench_User_Map (1_000_000);
+
+   Bench_System_Map (1_000);
+   Bench_System_Map (100_000);
+   Bench_System_Map (1_000_000);
+
+   End_Report;
+end Bench;
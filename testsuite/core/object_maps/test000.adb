@@ -0,0 +1,308 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                              T E S T 0 0 0                               --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+with Ada.Unchecked_Deallocation;
+
+with PolyORB.Object_Maps.System;
+with PolyORB.Object_Maps.User;
+with PolyORB.POA_Types;
+with PolyORB.Servants;
+with PolyORB.Utils.Report;
+
+with Test_Servant;
+
+procedure Test000 is
+
+   use PolyORB.Object_Maps;
+   use PolyORB.Object_Maps.System;
+   use PolyORB.Object_Maps.User;
+   use PolyORB.POA_Types;
+   use PolyORB.Servants;
+   use PolyORB.Utils.Report;
+
+   type Servant_Array is array (Positive range <>) of Servant_Access;
+   type Servant_Array_Access is access Servant_Array;
+
+   procedure Free is new Ada.Unchecked_Deallocation
+     (Servant_Array, Servant_Array_Access);
+
+   function New_Entry
+     (Name    : String;
+      Servant : Servant_Access) return Object_Map_Entry_Access;
+   --  Return a new entry for a user-assigned object id
+
+   function Image (N : Natural) return String;
+   --  Image of N without the leading space
+
+   procedure Test_User_Map;
+   --  Check the reverse servant index of a user id map, including with
+   --  several entries for one servant (MULTIPLE_ID id uniqueness policy).
+
+   procedure Test_System_Map;
+   --  Check that indices of removed entries are reused
+
+   procedure Test_Many_User (N : Positive);
+   --  Activate N objects with distinct servants in a user id map, as done
+   --  by a POA with the USER_ID, UNIQUE_ID and RETAIN policies, then look
+   --  them up by id and by servant, and deactivate them.
+
+   procedure Test_Many_System (N : Positive);
+   --  Same for a system id map, then repeatedly deactivate and reactivate
+   --  objects so that indices are reused.
+
+   -----------
+   -- Image --
+   -----------
+
+   function Image (N : Natural) return String is
+      S : constant String := Natural'Image (N);
+   begin
+      return S (S'First + 1 .. S'Last);
+   end Image;
+
+   ---------------
+   -- New_Entry --
+   ---------------
+
+   function New_Entry
+     (Name    : String;
+      Servant : Servant_Access) return Object_Map_Entry_Access
+   is
+      Result : constant Object_Map_Entry_Access := new Object_Map_Entry;
+   begin
+      Result.Oid := Create_Id
+        (Name             => Name,
+         System_Generated => False,
+         Persistency_Flag => Null_Time_Stamp,
+         Creator          => "test");
+      Result.Servant := Servant;
+      return Result;
+   end New_Entry;
+
+   -------------------
+   -- Test_User_Map --
+   -------------------
+
+   procedure Test_User_Map is
+      M  : aliased User_Object_Map;
+      S1 : constant Servant_Access := new Test_Servant.My_Servant;
+      S2 : constant Servant_Access := new Test_Servant.My_Servant;
+      E1 : constant Object_Map_Entry_Access := New_Entry ("one", S1);
+      E2 : constant Object_Map_Entry_Access := New_Entry ("two", S1);
+      E3 : constant Object_Map_Entry_Access := New_Entry ("three", null);
+      E  : Object_Map_Entry_Access;
+   begin
+      Initialize (M);
+      Add (M'Access, E1);
+      Add (M'Access, E2);
+      Add (M'Access, E3);
+
+      E := Get_By_Servant (M, S1);
+      Output ("servant look up", E = E1 or else E = E2);
+      Output ("unknown servant", Get_By_Servant (M, S2) = null);
+
+      Set_Servant (M'Access, E3, S2);
+      Output ("set servant", Get_By_Servant (M, S2) = E3
+                               and then E3.Servant = S2);
+
+      --  Remove the entry held in the reverse index for S1: the other one
+      --  must be found.
+
+      E := Remove_By_Id (M'Access, E.Oid.all);
+      Output ("servant with several entries",
+              Get_By_Servant (M, S1) /= null
+                and then Get_By_Servant (M, S1) /= E);
+
+      E := Remove_By_Id (M'Access, Get_By_Servant (M, S1).Oid.all);
+      Output ("servant removal", E /= null
+                                   and then not Is_Servant_In (M, S1)
+                                   and then Is_Servant_In (M, S2));
+      Finalize (M);
+   end Test_User_Map;
+
+   ---------------------
+   -- Test_System_Map --
+   ---------------------
+
+   procedure Test_System_Map is
+      M       : aliased System_Object_Map;
+      Entries : array (1 .. 3) of Object_Map_Entry_Access;
+      Indices : array (1 .. 3) of Integer;
+      E       : Object_Map_Entry_Access;
+      Ok      : Boolean;
+   begin
+      Initialize (M);
+      for J in Entries'Range loop
+         Entries (J) := new Object_Map_Entry;
+         Indices (J) := Add (M'Access, Entries (J));
+         Entries (J).Oid := Create_Id
+           (Name             => Image (Indices (J)),
+            System_Generated => True,
+            Persistency_Flag => Null_Time_Stamp,
+            Creator          => "test");
+      end loop;
+      Ok := Indices (1) = 1 and then Indices (2) = 2 and then Indices (3) = 3;
+
+      for J in Entries'Range loop
+         Set_Servant (M'Access, Entries (J), new Test_Servant.My_Servant);
+         Ok := Ok and then Get_By_Servant (M, Entries (J).Servant)
+                             = Entries (J);
+      end loop;
+      Output ("system id look up", Ok);
+
+      E := Remove_By_Id (M'Access, Entries (2).Oid.all);
+      Ok := E = Entries (2)
+        and then Get_By_Servant (M, E.Servant) = null;
+      E.Oid := null;
+      Output ("system id reuse", Ok and then Add (M'Access, E) = 2);
+      Finalize (M);
+   end Test_System_Map;
+
+   --------------------
+   -- Test_Many_User --
+   --------------------
+
+   procedure Test_Many_User (N : Positive) is
+      M        : aliased User_Object_Map;
+      Servants : Servant_Array_Access := new Servant_Array (1 .. N);
+      E        : Object_Map_Entry_Access;
+      Ok       : Boolean := True;
+   begin
+      Initialize (M);
+      for J in 1 .. N loop
+         Servants (J) := new Test_Servant.My_Servant;
+      end loop;
+
+      for J in 1 .. N loop
+         if not Is_Servant_In (M, Servants (J)) then
+            Add (M'Access, New_Entry ("device" & Image (J), Servants (J)));
+         end if;
+      end loop;
+
+      for J in 1 .. N loop
+         E := Get_By_Id
+           (M, Create_Id (Name             => "device" & Image (J),
+                          System_Generated => False,
+                          Persistency_Flag => Null_Time_Stamp,
+                          Creator          => "test"));
+         Ok := Ok and then E /= null and then E.Servant = Servants (J);
+      end loop;
+
+      for J in 1 .. N loop
+         E := Get_By_Servant (M, Servants (J));
+         Ok := Ok and then E /= null and then E.Servant = Servants (J);
+      end loop;
+
+      for J in 1 .. N loop
+         E := Get_By_Servant (M, Servants (J));
+         E := Remove_By_Id (M'Access, E.Oid.all);
+         Free (E.Oid);
+         Free (E);
+      end loop;
+
+      Output ("user id map with" & N'Img & " entries",
+              Ok and then not Is_Servant_In (M, Servants (1)));
+      Finalize (M);
+      Free (Servants);
+   end Test_Many_User;
+
+   ----------------------
+   -- Test_Many_System --
+   ----------------------
+
+   procedure Test_Many_System (N : Positive) is
+      Iterations : constant Positive := 2 * N;
+
+      M        : aliased System_Object_Map;
+      Servants : Servant_Array_Access := new Servant_Array (1 .. N);
+      E        : Object_Map_Entry_Access;
+      Index    : Integer;
+      Ok       : Boolean := True;
+   begin
+      Initialize (M);
+      for J in 1 .. N loop
+         Servants (J) := new Test_Servant.My_Servant;
+      end loop;
+
+      for J in 1 .. N loop
+         if not Is_Servant_In (M, Servants (J)) then
+            E := new Object_Map_Entry;
+            Index := Add (M'Access, E);
+            E.Oid := Create_Id
+              (Name             => Image (Index),
+               System_Generated => True,
+               Persistency_Flag => Null_Time_Stamp,
+               Creator          => "test");
+            Set_Servant (M'Access, E, Servants (J));
+         end if;
+      end loop;
+
+      for J in 1 .. N loop
+         E := Get_By_Servant (M, Servants (J));
+         Ok := Ok and then E /= null and then E.Servant = Servants (J);
+      end loop;
+
+      --  Deactivate and reactivate objects, scattered across the map
+
+      for J in 1 .. Iterations loop
+         declare
+            S : constant Servant_Access := Servants (1 + (J * 7919) mod N);
+         begin
+            E := Get_By_Servant (M, S);
+            E := Remove_By_Id (M'Access, E.Oid.all);
+            Free (E.Oid);
+            E.Servant := null;
+            Index := Add (M'Access, E);
+            E.Oid := Create_Id
+              (Name             => Image (Index),
+               System_Generated => True,
+               Persistency_Flag => Null_Time_Stamp,
+               Creator          => "test");
+            Set_Servant (M'Access, E, S);
+            Ok := Ok and then Index <= N;
+         end;
+      end loop;
+
+      Output ("system id map with" & N'Img & " entries", Ok);
+      Finalize (M);
+      Free (Servants);
+   end Test_Many_System;
+
+begin
+   Test_User_Map;
+   Test_System_Map;
+
+   Test_Many_User (1_000);
+   Test_Many_System (1_000);
+
+   End_Report;
+end Test000;
@@ -539,6 +539,95 @@ procedure Test000 is
       end;
    end Test_Id_To_Servant;
 
+   -------------------------
+   -- Test_Destroy_Resolve --
+   -------------------------
+
+   procedure Test_Destroy_Resolve;
+   --  Test that the POA designated by an object id is no longer found
+   --  once it has been destroyed, even if it had been resolved before.
+
+   procedure Test_Destroy_Resolve
+   is
+      use PolyORB.POA;
+      use PolyORB.POA_Manager;
+      use PolyORB.POA_Policies;
+      use PolyORB.POA_Policies.Policy_Lists;
+
+      use Test_Servant;
+
+      Root_POA : constant PolyORB.POA.Obj_Adapter_Access
+        := new PolyORB.POA.Basic_POA.Basic_Obj_Adapter;
+
+      S1       : constant My_Servant_Access := new My_Servant;
+      OA1, OA2 : Obj_Adapter_Access;
+      Found_OA : Obj_Adapter_Access;
+      Policies : PolicyList;
+      PM1      : POAManager_Access;
+      Id1      : PolyORB.POA_Types.Unmarshalled_Oid;
+
+      Error : Error_Container;
+   begin
+      S1.Nb    := 1;
+      S1.Name  := To_PolyORB_String ("Servant1");
+
+      PolyORB.POA.Create (Root_POA);
+      Append (Policies, Policy_Access (Root_POA.Thread_Policy));
+      Append (Policies, Policy_Access (Root_POA.Lifespan_Policy));
+      PM1 := POAManager_Access (Entity_Of (Root_POA.POA_Manager));
+
+      PolyORB.POA.Create_POA (Root_POA, "POA1", PM1, Policies, OA1, Error);
+      if Found (Error) then
+         raise Program_Error;
+      end if;
+
+      Activate_Object (OA1,
+                       PolyORB.Servants.Servant_Access (S1),
+                       null,
+                       Id1,
+                       Error);
+      if Found (Error) then
+         raise Program_Error;
+      end if;
+
+      declare
+         Creator : constant String :=
+           PolyORB.POA_Types.Get_Creator
+             (PolyORB.POA_Types.U_Oid_To_Oid (Id1));
+      begin
+         --  Resolve the object key twice, so that the second look up is
+         --  served from the resolution cache.
+
+         Find_POA (Root_POA, Creator, False, Found_OA, Error);
+         Find_POA (Root_POA, Creator, False, Found_OA, Error);
+         Output ("Resolve object key", not Found (Error)
+                                         and then Found_OA = OA1);
+
+         PolyORB.POA.Destroy (OA1);
+
+         Find_POA (Root_POA, Creator, False, Found_OA, Error);
+         if Found (Error) then
+            Catch (Error);
+            Output ("Resolve object key of destroyed POA",
+                    Found_OA = null);
+         else
+            Output ("Resolve object key of destroyed POA", False);
+         end if;
+
+         PolyORB.POA.Create_POA
+           (Root_POA, "POA1", PM1, Policies, OA2, Error);
+         if Found (Error) then
+            raise Program_Error;
+         end if;
+
+         Find_POA (Root_POA, Creator, False, Found_OA, Error);
+         Output ("Resolve object key of recreated POA",
+                 not Found (Error) and then Found_OA = OA2);
+      end;
+
+      PolyORB.POA.Destroy (Root_POA);
+   end Test_Destroy_Resolve;
+
 begin
    PolyORB.Initialization.Initialize_World;
 
@@ -548,6 +637,7 @@ begin
    --  Test_Activate_Object_With_Id;
    Test_Servant_To_Id;
    Test_Id_To_Servant;
+   Test_Destroy_Resolve;
 
    End_Report;
 
@@ -0,0 +1,250 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                                B E N C H                                 --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+--  Benchmark of the reception of large GIOP message bodies on a connected
+--  socket endpoint. A task sends bodies of Body_Size octets over a loopback
+--  connection. They are received as the ORB does: each round waits until
+--  the socket is readable, then reads whatever remains of the body, until
+--  the whole body has been received.
+
+--  Bodies are first received with a single receive operation per round,
+--  as Socket_Endpoint.Read did before it kept receiving large reads while
+--  data is available, then with Socket_Endpoint.Read. For each, the
+--  average number of rounds per body and the throughput are displayed.
+
+--  This program is not part of the testsuite runs.
+
+with Ada.Real_Time;
+with Ada.Streams;
+with Ada.Text_IO;
+with System.Storage_Elements;
+
+with PolyORB.Buffers;
+with PolyORB.Errors;
+with PolyORB.Initialization;
+with PolyORB.Sockets;
+with PolyORB.Transport.Connected.Sockets;
+with PolyORB.Utils.Report;
+
+with PolyORB.Setup.Default_Parameters;
+pragma Warnings (Off, PolyORB.Setup.Default_Parameters);
+with PolyORB.Setup.Tasking.Full_Tasking;
+pragma Elaborate_All (PolyORB.Setup.Tasking.Full_Tasking);
+pragma Warnings (Off, PolyORB.Setup.Tasking.Full_Tasking);
+
+procedure Bench is
+
+   use Ada.Real_Time;
+   use Ada.Streams;
+   use Ada.Text_IO;
+
+   use PolyORB.Buffers;
+   use PolyORB.Errors;
+   use PolyORB.Sockets;
+   use PolyORB.Transport.Connected.Sockets;
+   use PolyORB.Utils.Report;
+
+   Body_Size : constant := 16 * 1024 * 1024;
+   Bodies    : constant := 32;
+   --  Number of bodies received in each mode
+
+   Listening_Socket : Socket_Type;
+   Server_Address   : Sock_Addr_Type;
+
+   task Sender is
+      entry Start;
+   end Sender;
+   --  Connect to Server_Address and send 2 * Bodies bodies
+
+   procedure Receive_Single
+     (Socket : Socket_Type;
+      Buffer : Buffer_Access;
+      Size   : in out Stream_Element_Count);
+   --  Receive at most Size octets into Buffer with one receive operation,
+   --  as Socket_Endpoint.Read did for all reads, and set Size to the amount
+   --  of data received.
+
+   procedure Wait_Readable (Socket : Socket_Type);
+   --  Wait until Socket has data to read, as the ORB does before each read
+
+   --------------------
+   -- Receive_Single --
+   --------------------
+
+   procedure Receive_Single
+     (Socket : Socket_Type;
+      Buffer : Buffer_Access;
+      Size   : in out Stream_Element_Count)
+   is
+      Data_Received : Stream_Element_Count;
+
+      procedure Receive_Socket (V : access Iovec);
+      --  Lowlevel socket receive
+
+      --------------------
+      -- Receive_Socket --
+      --------------------
+
+      procedure Receive_Socket (V : access Iovec) is
+         Count : Stream_Element_Count;
+         Vecs  : Vector_Type (1 .. 1);
+         pragma Import (Ada, Vecs);
+         for Vecs'Address use V.all'Address;
+      begin
+         Receive_Vector (Socket, Vecs, Count);
+         V.Iov_Len := System.Storage_Elements.Storage_Offset (Count);
+      end Receive_Socket;
+
+      procedure Receive_Buffer is
+        new PolyORB.Buffers.Receive_Buffer (Receive_Socket);
+
+   begin
+      Receive_Buffer (Buffer, Size, Data_Received);
+      Size := Data_Received;
+   end Receive_Single;
+
+   ------------
+   -- Sender --
+   ------------
+
+   task body Sender is
+      Socket : Socket_Type;
+      Data   : constant Stream_Element_Array (1 .. 64 * 1024) :=
+        (others => 16#5A#);
+      Sent   : Stream_Element_Count;
+      Last   : Stream_Element_Offset;
+   begin
+      accept Start;
+      Create_Socket (Socket);
+      Connect_Socket (Socket, Server_Address);
+
+      for J in 1 .. 2 * Bodies loop
+         Sent := 0;
+         while Sent < Body_Size loop
+            Send_Socket
+              (Socket,
+               Data (1 .. Stream_Element_Offset'Min
+                            (Data'Length, Body_Size - Sent)),
+               Last);
+            Sent := Sent + Last;
+         end loop;
+      end loop;
+      Close_Socket (Socket);
+   end Sender;
+
+   -------------------
+   -- Wait_Readable --
+   -------------------
+
+   procedure Wait_Readable (Socket : Socket_Type) is
+      Selector : Selector_Type;
+      R_Set    : Socket_Set_Type;
+      W_Set    : Socket_Set_Type;
+      Status   : Selector_Status;
+   begin
+      Create_Selector (Selector);
+      Set (R_Set, Socket);
+      Empty (W_Set);
+      Check_Selector (Selector, R_Set, W_Set, Status);
+      Close_Selector (Selector);
+   end Wait_Readable;
+
+   Receiving_Socket : Socket_Type;
+   Peer_Address     : Sock_Addr_Type;
+   TE               : aliased Socket_Endpoint;
+   Ok               : Boolean := True;
+
+begin
+   PolyORB.Initialization.Initialize_World;
+
+   Create_Socket (Listening_Socket);
+   Server_Address.Addr := Loopback_Inet_Addr;
+   Server_Address.Port := Any_Port;
+   Bind_Socket (Listening_Socket, Server_Address);
+   Listen_Socket (Listening_Socket);
+   Server_Address := Get_Socket_Name (Listening_Socket);
+
+   Sender.Start;
+   Accept_Socket (Listening_Socket, Receiving_Socket, Peer_Address);
+   Create (TE, Receiving_Socket);
+
+   for Use_Endpoint in Boolean loop
+      declare
+         Start  : constant Time := Clock;
+         Rounds : Natural := 0;
+         Rate   : Float;
+      begin
+         for J in 1 .. Bodies loop
+            declare
+               Buffer    : Buffer_Access := new Buffer_Type;
+               Remaining : Stream_Element_Count := Body_Size;
+               Size      : Stream_Element_Count;
+               Error     : Error_Container;
+            begin
+               while Remaining > 0 and then Ok loop
+                  Wait_Readable (Receiving_Socket);
+                  Size := Remaining;
+                  if Use_Endpoint then
+                     Read (TE, Buffer, Size, Error);
+                  else
+                     Receive_Single (Receiving_Socket, Buffer, Size);
+                  end if;
+
+                  if Found (Error) or else Size = 0 then
+                     Catch (Error);
+                     Ok := False;
+                  end if;
+                  Remaining := Remaining - Size;
+                  Rounds := Rounds + 1;
+               end loop;
+               Ok := Ok and then Length (Buffer.all) = Body_Size;
+               Release (Buffer);
+            end;
+         end loop;
+
+         Rate := Float (Bodies) * Float (Body_Size)
+                   / Float (To_Duration (Clock - Start)) / 1.0E6;
+         if Use_Endpoint then
+            Put ("Socket_Endpoint.Read:");
+         else
+            Put ("single receive:      ");
+         end if;
+         Put_Line (Integer'Image (Rounds / Bodies) & " rounds per body,"
+                   & Integer'Image (Integer (Rate)) & " MB/s");
+      end;
+   end loop;
+
+   Output ("received" & Integer'Image (2 * Bodies) & " bodies", Ok);
+   Close (TE'Access);
+   Close_Socket (Listening_Socket);
+   End_Report;
+end Bench;
@@ -0,0 +1,315 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                           POLYORB COMPONENTS                             --
+--                                                                          --
+--                              T E S T 0 0 0                               --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+--           Copyright (C) 2026, Free Software Foundation, Inc.             --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.                                               --
+--                                                                          --
+-- As a special exception under Section 7 of GPL version 3, you are granted --
+-- additional permissions described in the GCC Runtime Library Exception,   --
+-- version 3.1, as published by the Free Software Foundation.               --
+--                                                                          --
+-- You should have received a copy of the GNU General Public License and    --
+-- a copy of the GCC Runtime Library Exception along with this program;     --
+-- see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see    --
+-- <http://www.gnu.org/licenses/>.                                          --
+--                                                                          --
+--                  PolyORB is maintained by AdaCore                        --
+--                     (email: sales@adacore.com)                           --
+--                                                                          --
+------------------------------------------------------------------------------
+
+--  Functional test of the MOMA message log: append and read back, replay
+--  on open, truncation of a torn record, compaction and group commit.
+
+with Ada.Directories;
+with Ada.Streams.Stream_IO;
+
+with PolyORB.Initialization;
+with PolyORB.MOMA_P.Provider.Message_Log;
+with PolyORB.Utils.Report;
+
+with PolyORB.Setup.Default_Parameters;
+pragma Warnings (Off, PolyORB.Setup.Default_Parameters);
+with PolyORB.Setup.Tasking.Full_Tasking;
+pragma Elaborate_All (PolyORB.Setup.Tasking.Full_Tasking);
+pragma Warnings (Off, PolyORB.Setup.Tasking.Full_Tasking);
+
+procedure Test000 is
+
+   use Ada.Streams;
+
+   use PolyORB.MOMA_P.Provider.Message_Log;
+   use PolyORB.Utils.Report;
+
+   Log_Name : constant String := "test000";
+   --  Segments are created in the current directory, as set by
+   --  log_directory in the configuration used for this test.
+
+   function Key (N : Positive) return String;
+   --  Key of the N-th message
+
+   function Data (K : String) return Stream_Element_Array;
+   --  Contents of the message with key K
+
+   function Holds (Log : Log_Access; K : String) return Boolean;
+   --  True if Log has a live message with key K and the expected data
+
+   function Is_Gone (Log : Log_Access; Offset : Log_Offset) return Boolean;
+   --  True if Offset no longer designates a readable message of Log
+
+   procedure Delete_Segments;
+   --  Remove the segments left by a previous run
+
+   function Last_Segment return String;
+   --  Name of the segment of the log with the greatest base offset
+
+   ----------
+   -- Data --
+   ----------
+
+   function Data (K : String) return Stream_Element_Array is
+      Result : Stream_Element_Array (1 .. 32);
+   begin
+      for J in Result'Range loop
+         Result (J) := Stream_Element
+           ((Character'Pos (K (K'First + Natural (J) mod K'Length))
+             + Natural (J)) mod 256);
+      end loop;
+      return Result;
+   end Data;
+
+   ---------------------
+   -- Delete_Segments --
+   ---------------------
+
+   procedure Delete_Segments is
+      use Ada.Directories;
+
+      Search : Search_Type;
+      Item   : Directory_Entry_Type;
+   begin
+      Start_Search (Search, ".", Log_Name & "-*.log");
+      while More_Entries (Search) loop
+         Get_Next_Entry (Search, Item);
+         Delete_File (Full_Name (Item));
+      end loop;
+      End_Search (Search);
+   end Delete_Segments;
+
+   -----------
+   -- Holds --
+   -----------
+
+   function Holds (Log : Log_Access; K : String) return Boolean is
+   begin
+      return Find (Log, K) /= No_Offset
+        and then Read (Log, K) = Data (K)
+        and then Read_At (Log, Find (Log, K)) = Data (K);
+   exception
+      when Not_Found =>
+         return False;
+   end Holds;
+
+   -------------
+   -- Is_Gone --
+   -------------
+
+   function Is_Gone (Log : Log_Access; Offset : Log_Offset) return Boolean is
+   begin
+      declare
+         Contents : constant Stream_Element_Array := Read_At (Log, Offset);
+         pragma Unreferenced (Contents);
+      begin
+         return False;
+      end;
+   exception
+      when Not_Found =>
+         return True;
+   end Is_Gone;
+
+   ---------
+   -- Key --
+   ---------
+
+   function Key (N : Positive) return String is
+      Image : constant String := Positive'Image (N);
+   begin
+      return "M" & Image (Image'First + 1 .. Image'Last);
+   end Key;
+
+   ------------------
+   -- Last_Segment --
+   ------------------
+
+   function Last_Segment return String is
+      use Ada.Directories;
+
+      Search : Search_Type;
+      Item   : Directory_Entry_Type;
+      Last   : String (1 .. Log_Name'Length + 25) := (others => ' ');
+   begin
+      --  The base offsets in segment names are padded, so that names sort
+      --  in the order of offsets.
+
+      Start_Search (Search, ".", Log_Name & "-*.log");
+      while More_Entries (Search) loop
+         Get_Next_Entry (Search, Item);
+         if Simple_Name (Item) > Last then
+            Last := Simple_Name (Item);
+         end if;
+      end loop;
+      End_Search (Search);
+      return Last;
+   end Last_Segment;
+
+   Log    : Log_Access;
+   Offset : Log_Offset;
+   Ok     : Boolean;
+
+begin
+   PolyORB.Initialization.Initialize_World;
+   Delete_Segments;
+
+   --  Append messages spanning several segments, and read them back
+
+   Log := Open (Log_Name);
+   for J in 1 .. 60 loop
+      Append (Log, Key (J), Data (Key (J)), Offset);
+   end loop;
+
+   Ok := True;
+   for J in 1 .. 60 loop
+      Ok := Ok and then Holds (Log, Key (J));
+   end loop;
+   Output ("Append and read back", Ok);
+
+   Append (Log, Key (60), Data (Key (59)), Offset);
+   Output ("Append replaces message with same key",
+           Find (Log, Key (60)) = Offset
+           and then Read (Log, Key (60)) = Data (Key (59)));
+   Append (Log, Key (60), Data (Key (60)), Offset);
+
+   --  Compaction: the first segment becomes sparse as its messages are
+   --  acknowledged, so its live messages are copied to the end of the log
+   --  and it is deleted.
+
+   declare
+      First_Offset : constant Log_Offset := Find (Log, Key (1));
+   begin
+      for J in 2 .. 20 loop
+         Acknowledge (Log, Key (J));
+      end loop;
+
+      Ok := True;
+      for J in 2 .. 20 loop
+         Ok := Ok and then Find (Log, Key (J)) = No_Offset;
+      end loop;
+      Output ("Acknowledged messages are removed", Ok);
+
+      Output ("Live message of sparse segment is relocated",
+              Find (Log, Key (1)) > First_Offset
+              and then Holds (Log, Key (1))
+              and then Is_Gone (Log, First_Offset));
+   end;
+
+   begin
+      Acknowledge (Log, Key (2));
+      Output ("Acknowledging unknown message raises Not_Found", False);
+   exception
+      when Not_Found =>
+         Output ("Acknowledging unknown message raises Not_Found", True);
+   end;
+
+   --  Replay
+
+   Close (Log);
+   Log := Open (Log_Name);
+
+   Ok := Holds (Log, Key (1));
+   for J in 2 .. 20 loop
+      Ok := Ok and then Find (Log, Key (J)) = No_Offset;
+   end loop;
+   for J in 21 .. 60 loop
+      Ok := Ok and then Holds (Log, Key (J));
+   end loop;
+   Output ("Replay restores live messages", Ok);
+
+   --  Torn record: a partial record at the end of the last segment, as
+   --  left by a crash during an append, is truncated on open.
+
+   Close (Log);
+
+   declare
+      use Ada.Streams.Stream_IO;
+
+      File : File_Type;
+   begin
+      Open (File, Append_File, Last_Segment);
+      Write (File, Stream_Element_Array'(Character'Pos ('M'), 0, 0, 3, 0));
+      Close (File);
+   end;
+
+   Log := Open (Log_Name);
+   Append (Log, Key (61), Data (Key (61)), Offset);
+   Close (Log);
+   Log := Open (Log_Name);
+
+   Output ("Torn record is truncated on replay",
+           Holds (Log, Key (60)) and then Holds (Log, Key (61)));
+
+   --  Group commit: concurrent appenders share synchronizations
+
+   declare
+      task type Appender is
+         entry Start (First : Positive);
+      end Appender;
+
+      task body Appender is
+         Base   : Positive;
+         Offset : Log_Offset;
+      begin
+         accept Start (First : Positive) do
+            Base := First;
+         end Start;
+
+         for J in Base .. Base + 49 loop
+            Append (Log, Key (J), Data (Key (J)), Offset);
+         end loop;
+      end Appender;
+
+      Appenders : array (1 .. 4) of Appender;
+   begin
+      for J in Appenders'Range loop
+         Appenders (J).Start (1000 * J);
+      end loop;
+   end;
+
+   Sync (Log);
+   Close (Log);
+   Log := Open (Log_Name);
+
+   Ok := True;
+   for T in 1 .. 4 loop
+      for J in 1000 * T .. 1000 * T + 49 loop
+         Ok := Ok and then Holds (Log, Key (J));
+      end loop;
+   end loop;
+   Output ("Concurrent appends are all durable", Ok);
+
+   Close (Log);
+   Delete_Segments;
+
+   End_Report;
+end Test000;
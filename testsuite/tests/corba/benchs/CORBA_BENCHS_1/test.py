@@ -0,0 +1,14 @@
+
+from test_utils import *
+import sys
+
+# Oneway throughput over DIOP, first with one system call per datagram,
+# then with batched datagram I/O
+
+if not client_server(r'corba/benchs/test001/client', r'diop_unbatched.conf',
+                     r'corba/benchs/test001/server', r'diop_unbatched.conf'):
+    fail()
+
+if not client_server(r'corba/benchs/test001/client', r'diop_batched.conf',
+                     r'corba/benchs/test001/server', r'diop_batched.conf'):
+    fail()
@@ -0,0 +1,5 @@
+from test_utils import *
+import sys
+
+if not local(r'core/any/test000', r''):
+    fail()
@@ -0,0 +1,7 @@
+
+from test_utils import *
+import sys
+
+if not local(r'core/id_maps/test000', r''):
+    fail()
+
@@ -0,0 +1,5 @@
+from test_utils import *
+import sys
+
+if not local(r'corba/cos/notification/test_etcl', r''):
+    fail()
@@ -0,0 +1,5 @@
+from test_utils import *
+import sys
+
+if not local(r'moma/message_log/test000', r'message_log.conf'):
+    fail()